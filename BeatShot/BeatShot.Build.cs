@@ -18,7 +18,7 @@ public class BeatShot : ModuleRules
 			"BeatShotGlobal", "OnlineSubsystem", "OnlineSubsystemUtils",
 			"Steamworks", "GameplayAbilities", "GameplayTags", "GameplayTasks", "NetCore", "PhysicsCore",
 			"ModularGameplay", "Text3D", "DLSSBlueprint", "NISBlueprint",
-			"StreamlineBlueprint", "Slate", "SlateCore", "MoviePlayer", "NumCpp"
+			"StreamlineBlueprint", "Slate", "SlateCore", "MoviePlayer"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new[]
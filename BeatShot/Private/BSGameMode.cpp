@@ -303,6 +303,10 @@ void ABSGameMode::EndGameMode(const bool bSaveScores, const ETransitionState Tra
 	// Handle saving scores before resetting Target Manager
 	HandleScoreSaving(bSaveScores);
 
+	#if !UE_BUILD_SHIPPING
+	TargetManager->HandleBeatLatencyOnGameModeEnd();
+	#endif
+
 	TargetManager->Clear();
 
 	if (TransitionState == ETransitionState::QuitToMainMenu && !Controllers.IsEmpty())
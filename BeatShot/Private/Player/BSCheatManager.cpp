@@ -331,13 +331,15 @@ void UBSCheatManager::ShowDebug_ReinforcementLearningWidget(IConsoleVariable* Va
 	{
 		if (bAvg)
 		{
-			Controller->ShowRLAgentWidget(TargetManager->RLComponent->OnQTableUpdate, 5, 5,
-				TargetManager->RLComponent->GetTArray_FromNdArray_QTableAvg());
+			Controller->ShowRLAgentWidget(TargetManager->RLComponent->OnQTableUpdate,
+				TargetManager->RLComponent->GetNumQTableGridRows(),
+				TargetManager->RLComponent->GetNumQTableGridColumns(), TargetManager->RLComponent->GetTArray_QTableAvg());
 		}
 		else
 		{
-			Controller->ShowRLAgentWidget(TargetManager->RLComponent->OnQTableUpdate, 5, 5,
-				TargetManager->RLComponent->GetTArray_FromNdArray_QTableMax());
+			Controller->ShowRLAgentWidget(TargetManager->RLComponent->OnQTableUpdate,
+				TargetManager->RLComponent->GetNumQTableGridRows(),
+				TargetManager->RLComponent->GetNumQTableGridColumns(), TargetManager->RLComponent->GetTArray_QTableMax());
 		}
 	}
 	else
@@ -618,7 +618,7 @@ void ABSPlayerController::ShowRLAgentWidget(FOnQTableUpdate& OnQTableUpdate, con
 	if (!RLAgentWidget && IsLocalController())
 	{
 		RLAgentWidget = CreateWidget<URLAgentWidget>(this, RLAgentWidgetClass);
-		OnQTableUpdate.AddUObject(RLAgentWidget, &URLAgentWidget::UpdatePanel);
+		OnQTableUpdate.AddUObject(RLAgentWidget, &URLAgentWidget::UpdateCells);
 		RLAgentWidget->InitQTable(Rows, Columns, QTable);
 		RLAgentWidget->AddToViewport();
 	}
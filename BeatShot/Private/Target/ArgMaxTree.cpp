@@ -0,0 +1,69 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "Target/ArgMaxTree.h"
+
+void FArgMaxTree::Init(TConstArrayView<float> InValues)
+{
+	NumValues = InValues.Num();
+	NumLeaves = FMath::RoundUpToPowerOfTwo(FMath::Max(NumValues, 1));
+	Values = TArray<float>(InValues.GetData(), InValues.Num());
+
+	Nodes.Init(INDEX_NONE, NumLeaves * 2);
+	for (int32 Index = 0; Index < NumValues; Index++)
+	{
+		Nodes[NumLeaves + Index] = Index;
+	}
+	for (int32 Node = NumLeaves - 1; Node > 0; Node--)
+	{
+		Nodes[Node] = GetBetter(Nodes[Node * 2], Nodes[Node * 2 + 1]);
+	}
+}
+
+void FArgMaxTree::Reset()
+{
+	NumValues = 0;
+	NumLeaves = 0;
+	Values.Empty();
+	Nodes.Empty();
+}
+
+void FArgMaxTree::Update(const int32 Index, const float Value)
+{
+	check(Values.IsValidIndex(Index));
+	Values[Index] = Value;
+
+	for (int32 Node = (NumLeaves + Index) / 2; Node > 0; Node /= 2)
+	{
+		Nodes[Node] = GetBetter(Nodes[Node * 2], Nodes[Node * 2 + 1]);
+	}
+}
+
+void FArgMaxTree::GetMaxIndices(TArray<int32>& Out) const
+{
+	if (NumValues == 0) return;
+
+	const float MaxValue = Values[Nodes[1]];
+
+	// Only descend into subtrees whose largest value ties the maximum, right child pushed first so that indices
+	// come out in ascending order
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(1);
+
+	while (Stack.Num() > 0)
+	{
+		const int32 Node = Stack.Pop(false);
+		const int32 Index = Nodes[Node];
+		if (Index == INDEX_NONE || Values[Index] != MaxValue) continue;
+
+		if (Node >= NumLeaves)
+		{
+			Out.Add(Index);
+		}
+		else
+		{
+			Stack.Add(Node * 2 + 1);
+			Stack.Add(Node * 2);
+		}
+	}
+}
@@ -0,0 +1,127 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "Target/BeatLatencyRecorder.h"
+
+FBeatLatencyRecorder::FBeatLatencyRecorder(const int32 InCapacity)
+{
+	Records.SetNum(FMath::Max(1, InCapacity));
+}
+
+void FBeatLatencyRecorder::BeginBeat(const double WorldTime)
+{
+	CurrentRecord = FBeatLatencyRecord();
+	CurrentRecord.BeatIndex = TotalRecorded;
+	CurrentRecord.WorldTime = WorldTime;
+	BeatStartCycles = FPlatformTime::Cycles64();
+}
+
+void FBeatLatencyRecorder::EndBeat()
+{
+	CurrentRecord.TotalMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - BeatStartCycles);
+	Records[Head] = CurrentRecord;
+	Head = (Head + 1) % Records.Num();
+	Count = FMath::Min(Count + 1, Records.Num());
+	TotalRecorded++;
+}
+
+void FBeatLatencyRecorder::Reset()
+{
+	CurrentRecord = FBeatLatencyRecord();
+	Head = 0;
+	Count = 0;
+	TotalRecorded = 0;
+}
+
+TArray<FBeatLatencyRecord> FBeatLatencyRecorder::GetRecords(const int32 NumRecords) const
+{
+	const int32 NumToGet = NumRecords > 0 ? FMath::Min(NumRecords, Count) : Count;
+	TArray<FBeatLatencyRecord> Out;
+	Out.Reserve(NumToGet);
+
+	// Head points one past the newest record
+	const int32 Start = Head - NumToGet + Records.Num();
+	for (int i = 0; i < NumToGet; i++)
+	{
+		Out.Add(Records[(Start + i) % Records.Num()]);
+	}
+	return Out;
+}
+
+FString FBeatLatencyRecorder::GetSummary(const int32 NumRecords) const
+{
+	const TArray<FBeatLatencyRecord> Recent = GetRecords(NumRecords);
+	if (Recent.IsEmpty())
+	{
+		return TEXT("No beats recorded.");
+	}
+
+	FBeatLatencyRecord Sum;
+	FBeatLatencyRecord Max;
+	for (const FBeatLatencyRecord& Record : Recent)
+	{
+		Sum.TotalMs += Record.TotalMs;
+		Sum.RuntimeSpawningMs += Record.RuntimeSpawningMs;
+		Sum.GetTargetSpawnParamsMs += Record.GetTargetSpawnParamsMs;
+		Sum.SpawnTargetsMs += Record.SpawnTargetsMs;
+		Sum.TargetActivationMs += Record.TargetActivationMs;
+		Sum.DrawDebugMs += Record.DrawDebugMs;
+		Sum.NumSpawnCandidates += Record.NumSpawnCandidates;
+		Sum.NumSpawned += Record.NumSpawned;
+		Sum.NumActivationCandidates += Record.NumActivationCandidates;
+		Sum.NumActivated += Record.NumActivated;
+
+		if (Record.TotalMs > Max.TotalMs)
+		{
+			Max.TotalMs = Record.TotalMs;
+			Max.BeatIndex = Record.BeatIndex;
+		}
+		Max.RuntimeSpawningMs = FMath::Max(Max.RuntimeSpawningMs, Record.RuntimeSpawningMs);
+		Max.GetTargetSpawnParamsMs = FMath::Max(Max.GetTargetSpawnParamsMs, Record.GetTargetSpawnParamsMs);
+		Max.SpawnTargetsMs = FMath::Max(Max.SpawnTargetsMs, Record.SpawnTargetsMs);
+		Max.TargetActivationMs = FMath::Max(Max.TargetActivationMs, Record.TargetActivationMs);
+		Max.DrawDebugMs = FMath::Max(Max.DrawDebugMs, Record.DrawDebugMs);
+		Max.NumSpawnCandidates = FMath::Max(Max.NumSpawnCandidates, Record.NumSpawnCandidates);
+		Max.NumSpawned = FMath::Max(Max.NumSpawned, Record.NumSpawned);
+		Max.NumActivationCandidates = FMath::Max(Max.NumActivationCandidates, Record.NumActivationCandidates);
+		Max.NumActivated = FMath::Max(Max.NumActivated, Record.NumActivated);
+	}
+
+	const double Num = Recent.Num();
+	FString Out = FString::Printf(TEXT("Last %d beats (avg / max), slowest beat %d:"), Recent.Num(), Max.BeatIndex);
+	const auto AddTime = [&Out, Num](const TCHAR* Label, const double SumMs, const double MaxMs)
+	{
+		Out += FString::Printf(TEXT("\n  %-24s %8.3f / %8.3f ms"), Label, SumMs / Num, MaxMs);
+	};
+	const auto AddCount = [&Out, Num](const TCHAR* Label, const int32 SumCount, const int32 MaxCount)
+	{
+		Out += FString::Printf(TEXT("\n  %-24s %8.2f / %5d"), Label, SumCount / Num, MaxCount);
+	};
+	AddTime(TEXT("Total"), Sum.TotalMs, Max.TotalMs);
+	AddTime(TEXT("HandleRuntimeSpawning"), Sum.RuntimeSpawningMs, Max.RuntimeSpawningMs);
+	AddTime(TEXT("GetTargetSpawnParams"), Sum.GetTargetSpawnParamsMs, Max.GetTargetSpawnParamsMs);
+	AddTime(TEXT("SpawnTargets"), Sum.SpawnTargetsMs, Max.SpawnTargetsMs);
+	AddTime(TEXT("HandleTargetActivation"), Sum.TargetActivationMs, Max.TargetActivationMs);
+	AddTime(TEXT("DrawDebug"), Sum.DrawDebugMs, Max.DrawDebugMs);
+	AddCount(TEXT("Spawn candidates"), Sum.NumSpawnCandidates, Max.NumSpawnCandidates);
+	AddCount(TEXT("Spawned"), Sum.NumSpawned, Max.NumSpawned);
+	AddCount(TEXT("Activation candidates"), Sum.NumActivationCandidates, Max.NumActivationCandidates);
+	AddCount(TEXT("Activated"), Sum.NumActivated, Max.NumActivated);
+	return Out;
+}
+
+FString FBeatLatencyRecorder::ToCsv() const
+{
+	FString Csv = TEXT("Beat,WorldTime,TotalMs,RuntimeSpawningMs,GetTargetSpawnParamsMs,SpawnTargetsMs,"
+		"TargetActivationMs,DrawDebugMs,NumToSpawn,NumSpawnCandidates,NumSpawned,NumToActivate,"
+		"NumActivationCandidates,NumActivated,NumManagedTargets\n");
+	for (const FBeatLatencyRecord& Record : GetRecords())
+	{
+		Csv += FString::Printf(TEXT("%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%d,%d,%d,%d,%d,%d,%d\n"),
+			Record.BeatIndex, Record.WorldTime, Record.TotalMs, Record.RuntimeSpawningMs,
+			Record.GetTargetSpawnParamsMs, Record.SpawnTargetsMs, Record.TargetActivationMs, Record.DrawDebugMs,
+			Record.NumToSpawn, Record.NumSpawnCandidates, Record.NumSpawned, Record.NumToActivate,
+			Record.NumActivationCandidates, Record.NumActivated, Record.NumManagedTargets);
+	}
+	return Csv;
+}
@@ -0,0 +1,215 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "Target/LargestRectangleFinder.h"
+
+void FLargestRectangleFinder::Init(const int32 InNumRows, const int32 InNumCols)
+{
+	NumRows = InNumRows;
+	NumCols = InNumCols;
+	bHasAdjacentIndices = false;
+
+	// Each row can close at most one rectangle per column
+	const int32 MaxRectangles = NumRows * NumCols;
+
+	Heights.Reset();
+	Heights.AddZeroed(NumCols);
+	Stack.SetNumUninitialized(NumCols + 1);
+	Factors.Reset(MaxFactors);
+	Rectangles.Reset(MaxRectangles);
+	FitMasks.Reset(MaxRectangles);
+	CandidateOffsets.Reset(MaxFactors + 1);
+	CandidateIndices.Reset(MaxRectangles);
+	AdjacentSums.Reset();
+	AdjacentSums.AddZeroed((NumRows + 1) * (NumCols + 1));
+	StartIndexCandidates.Reset(MaxRectangles);
+}
+
+void FLargestRectangleFinder::FindRectangles(const FSpawnAreaBitSet& Validity, TConstArrayView<FFactor> InFactors)
+{
+	check(Validity.GetMaxIndex() == NumRows * NumCols);
+	check(InFactors.Num() <= MaxFactors);
+
+	Factors.Reset();
+	Factors.Append(InFactors.GetData(), InFactors.Num());
+	Rectangles.Reset();
+	FitMasks.Reset();
+	bHasAdjacentIndices = false;
+	FMemory::Memzero(Heights.GetData(), Heights.Num() * sizeof(int32));
+
+	for (int32 Row = 0; Row < NumRows; Row++)
+	{
+		const int32 RowStartIndex = Row * NumCols;
+		int32 StackNum = 0;
+
+		// The extra column has zero height, which closes every rectangle still on the stack
+		for (int32 Col = 0; Col <= NumCols; Col++)
+		{
+			int32 Height = 0;
+			if (Col < NumCols)
+			{
+				Heights[Col] = Validity.Contains(RowStartIndex + Col) ? Heights[Col] + 1 : 0;
+				Height = Heights[Col];
+			}
+
+			// A shorter column ends every taller rectangle on the stack, and the new one can start where they did
+			int32 StartCol = Col;
+			while (StackNum > 0 && Stack[StackNum - 1].Y > Height)
+			{
+				const FIntPoint& Top = Stack[--StackNum];
+				AddRectangle(Row, Top.X, Col - Top.X, Top.Y);
+				StartCol = Top.X;
+			}
+
+			// An equal height extends the rectangle already on the stack instead of starting a narrower one
+			if (Height > 0 && (StackNum == 0 || Stack[StackNum - 1].Y < Height))
+			{
+				Stack[StackNum++] = FIntPoint(StartCol, Height);
+			}
+		}
+	}
+
+	// Group the rectangle indices by factor: count, prefix sum, then fill
+	CandidateOffsets.Reset();
+	CandidateOffsets.AddZeroed(Factors.Num() + 1);
+	for (uint64 Mask : FitMasks)
+	{
+		while (Mask)
+		{
+			CandidateOffsets[FMath::CountTrailingZeros64(Mask) + 1]++;
+			Mask &= Mask - 1;
+		}
+	}
+	for (int32 FactorIndex = 1; FactorIndex < CandidateOffsets.Num(); FactorIndex++)
+	{
+		CandidateOffsets[FactorIndex] += CandidateOffsets[FactorIndex - 1];
+	}
+
+	int32 Cursors[MaxFactors];
+	FMemory::Memcpy(Cursors, CandidateOffsets.GetData(), Factors.Num() * sizeof(int32));
+	CandidateIndices.SetNumUninitialized(CandidateOffsets.Last());
+	for (int32 RectIndex = 0; RectIndex < FitMasks.Num(); RectIndex++)
+	{
+		uint64 Mask = FitMasks[RectIndex];
+		while (Mask)
+		{
+			CandidateIndices[Cursors[FMath::CountTrailingZeros64(Mask)]++] = RectIndex;
+			Mask &= Mask - 1;
+		}
+	}
+}
+
+void FLargestRectangleFinder::SetAdjacentIndices(const FSpawnAreaBitSet& Adjacent)
+{
+	check(Adjacent.GetMaxIndex() == NumRows * NumCols);
+
+	// The first row and column of the table are always zero
+	const int32 Stride = NumCols + 1;
+	for (int32 Row = 0; Row < NumRows; Row++)
+	{
+		int32 RowSum = 0;
+		for (int32 Col = 0; Col < NumCols; Col++)
+		{
+			RowSum += Adjacent.Contains(Row * NumCols + Col) ? 1 : 0;
+			AdjacentSums[(Row + 1) * Stride + Col + 1] = AdjacentSums[Row * Stride + Col + 1] + RowSum;
+		}
+	}
+	bHasAdjacentIndices = true;
+}
+
+FRectCandidate FLargestRectangleFinder::ChooseRectangleCandidate(const bool bBordering, const int32 BlockSize,
+	const FRandomStream& Stream)
+{
+	StartIndexCandidates.Reset();
+
+	if (bBordering && bHasAdjacentIndices)
+	{
+		for (int32 FactorIndex = 0; FactorIndex < Factors.Num(); FactorIndex++)
+		{
+			// Shuffle the factor's rectangles in place so that the first one bordering is random
+			TArrayView<int32> Candidates(CandidateIndices.GetData() + CandidateOffsets[FactorIndex],
+				CandidateOffsets[FactorIndex + 1] - CandidateOffsets[FactorIndex]);
+			for (int32 i = Candidates.Num() - 1; i > 0; i--)
+			{
+				Swap(Candidates[i], Candidates[Stream.RandRange(0, i)]);
+			}
+
+			for (const int32 RectIndex : Candidates)
+			{
+				if (UpdateStartIndexCandidates(Rectangles[RectIndex], Factors[FactorIndex]) > 0)
+				{
+					FRectCandidate Chosen(Factors[FactorIndex]);
+					Chosen.SetChosenSubRectangle(Rectangles[RectIndex], BlockSize);
+					return Chosen;
+				}
+			}
+		}
+		StartIndexCandidates.Reset();
+	}
+
+	// Choose a random rectangle from the first factor that fits anywhere
+	for (int32 FactorIndex = 0; FactorIndex < Factors.Num(); FactorIndex++)
+	{
+		const TConstArrayView<int32> Candidates = GetCandidates(FactorIndex);
+		if (!Candidates.IsEmpty())
+		{
+			FRectCandidate Chosen(Factors[FactorIndex]);
+			Chosen.SetChosenSubRectangle(Rectangles[Candidates[Stream.RandRange(0, Candidates.Num() - 1)]], BlockSize);
+			return Chosen;
+		}
+	}
+
+	return FRectCandidate();
+}
+
+void FLargestRectangleFinder::AddRectangle(const int32 TopRow, const int32 StartCol, const int32 Width,
+	const int32 Height)
+{
+	const FSubRectangle Rectangle(TopRow, StartCol, Width, Height, NumCols);
+
+	uint64 Mask = 0;
+	for (int32 FactorIndex = 0; FactorIndex < Factors.Num(); FactorIndex++)
+	{
+		if (Rectangle.Fits(Factors[FactorIndex]))
+		{
+			Mask |= 1ull << FactorIndex;
+		}
+	}
+
+	// Rectangles too small for every factor can never be chosen
+	if (Mask == 0) return;
+
+	Rectangles.Add(Rectangle);
+	FitMasks.Add(Mask);
+}
+
+bool FLargestRectangleFinder::BlockContainsAdjacent(const int32 Row, const int32 Col, const int32 BlockRows,
+	const int32 BlockCols) const
+{
+	const int32 Stride = NumCols + 1;
+	const int32 Bottom = Row * Stride;
+	const int32 Top = (Row + BlockRows) * Stride;
+	const int32 Right = Col + BlockCols;
+	return AdjacentSums[Top + Right] - AdjacentSums[Bottom + Right] - AdjacentSums[Top + Col] + AdjacentSums[
+		Bottom + Col] > 0;
+}
+
+int32 FLargestRectangleFinder::UpdateStartIndexCandidates(const FSubRectangle& Rectangle, const FFactor& Factor)
+{
+	StartIndexCandidates.Reset();
+
+	// Blocks are placed with Factor1 rows and Factor2 columns
+	const int32 MaxStartRow = Rectangle.Row.EndIndex - Factor.Factor1 + 1;
+	const int32 MaxStartCol = Rectangle.Col.EndIndex - Factor.Factor2 + 1;
+	for (int32 Row = Rectangle.Row.StartIndex; Row <= MaxStartRow; Row++)
+	{
+		for (int32 Col = Rectangle.Col.StartIndex; Col <= MaxStartCol; Col++)
+		{
+			if (BlockContainsAdjacent(Row, Col, Factor.Factor1, Factor.Factor2))
+			{
+				StartIndexCandidates.Add(FIndexPair(Row, Col));
+			}
+		}
+	}
+	return StartIndexCandidates.Num();
+}
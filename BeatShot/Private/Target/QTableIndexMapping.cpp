@@ -0,0 +1,60 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "Target/QTableIndexMapping.h"
+#include "Target/MatrixFunctions.h"
+#include "GlobalConstants.h"
+#include "Misc/ScopeLock.h"
+
+FQTableIndexMappingRef FQTableIndexMapping::Get(const int32 NumSpawnAreaRows, const int32 NumSpawnAreaCols,
+	const int32 Resolution)
+{
+	static FCriticalSection CacheLock;
+	static TMap<FIntVector4, FQTableIndexMappingRef> Cache;
+
+	const FIntPoint GridSize = GetGridSize(NumSpawnAreaRows, NumSpawnAreaCols, Resolution);
+	const FIntVector4 Key(NumSpawnAreaRows, NumSpawnAreaCols, GridSize.X, GridSize.Y);
+
+	FScopeLock Lock(&CacheLock);
+	if (const FQTableIndexMappingRef* Found = Cache.Find(Key))
+	{
+		return *Found;
+	}
+
+	const TSharedRef<FQTableIndexMapping, ESPMode::ThreadSafe> Mapping = MakeShared<FQTableIndexMapping,
+		ESPMode::ThreadSafe>();
+	Mapping->NumRows = GridSize.X;
+	Mapping->NumCols = GridSize.Y;
+
+	const int32 NumSpawnAreas = NumSpawnAreaRows * NumSpawnAreaCols;
+	Mapping->SpawnAreaToQTableIndex.Init(INDEX_NONE, NumSpawnAreas);
+	Mapping->QTableToSpawnAreaMasks.Init(FSpawnAreaBitSet(NumSpawnAreas), Mapping->Num());
+
+	if (Mapping->Num() > 0)
+	{
+		const TMap<int32, FGenericIndexMapping> IndexMappings = MapMatrixToSmallerMatrix(NumSpawnAreaRows,
+			NumSpawnAreaCols, GridSize.X, GridSize.Y);
+		for (const TPair<int32, FGenericIndexMapping>& IndexMapping : IndexMappings)
+		{
+			for (const int32 SpawnAreaIndex : IndexMapping.Value.MappedIndices)
+			{
+				Mapping->SpawnAreaToQTableIndex[SpawnAreaIndex] = IndexMapping.Key;
+				Mapping->QTableToSpawnAreaMasks[IndexMapping.Key].Add(SpawnAreaIndex);
+			}
+		}
+	}
+
+	Cache.Add(Key, Mapping);
+	return Mapping;
+}
+
+FIntPoint FQTableIndexMapping::GetGridSize(const int32 NumSpawnAreaRows, const int32 NumSpawnAreaCols,
+	const int32 Resolution)
+{
+	const int32 Rows = FMath::Max(0, NumSpawnAreaRows);
+	const int32 Cols = FMath::Max(0, NumSpawnAreaCols);
+	const int32 MaxResolution = Resolution > 0
+		? FMath::Min(Resolution, Constants::MaxQTableResolution)
+		: Constants::MaxQTableResolution;
+	return FIntPoint(FMath::Min(MaxResolution, Rows), FMath::Min(MaxResolution, Cols));
+}
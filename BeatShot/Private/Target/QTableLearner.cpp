@@ -0,0 +1,287 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "Target/QTableLearner.h"
+#include "GlobalConstants.h"
+#include "HAL/Event.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#if !UE_BUILD_SHIPPING
+#include "Target/TargetManager.h"
+#endif
+
+void FQTableState::InitOrdering()
+{
+	const int32 NumRows = QTable.GetNumRows();
+
+	RowArgMaxTrees.SetNum(NumRows);
+	RowSums.SetNumUninitialized(NumRows);
+
+	TArray<float, TInlineAllocator<Constants::DefaultNumberOfQTableRows>> RowSumValues;
+	RowSumValues.SetNumUninitialized(NumRows);
+
+	for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex++)
+	{
+		RowArgMaxTrees[RowIndex].Init(GetRow(RowIndex));
+
+		const float Sum = QTable.RowSum(RowIndex);
+		RowSums[RowIndex] = Sum;
+		RowSumValues[RowIndex] = Sum;
+	}
+
+	RowSumArgMaxTree.Init(RowSumValues);
+}
+
+void FQTableState::SetValue(const int32 RowIndex, const int32 ColIndex, const float Value)
+{
+	float& Cell = QTable(RowIndex, ColIndex);
+	RowSums[RowIndex] += static_cast<double>(Value) - Cell;
+	Cell = Value;
+
+	RowArgMaxTrees[RowIndex].Update(ColIndex, Value);
+	RowSumArgMaxTree.Update(RowIndex, static_cast<float>(RowSums[RowIndex]));
+}
+
+TConstArrayView<float> FQTableState::GetRow(const int32 RowIndex) const
+{
+	return QTable.GetRow(RowIndex);
+}
+
+FQTableLearner::FQTableLearner(FQTableState&& InState, const float InAlpha, const float InGamma,
+	const float InLambda, const int32 InRandomSeed) :
+	State(MakeShared<FQTableState, ESPMode::ThreadSafe>(MoveTemp(InState))), Alpha(InAlpha), Gamma(InGamma),
+	Lambda(FMath::Clamp(InLambda, 0.f, 1.f)), LastActionIndex(INDEX_NONE), RandomStream(InRandomSeed),
+	NumEnqueued(0), NumApplied(0), NumUnpublished(0), LastPublishTime(0.0), bFlushRequested(false),
+	bHasWorker(false), bStopping(false), WorkEvent(FPlatformProcess::GetSynchEventFromPool(false)), Thread(nullptr)
+{
+	#if !UE_BUILD_SHIPPING
+	bPrintDebug_QTableUpdate = false;
+	#endif
+}
+
+FQTableLearner::~FQTableLearner()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	WorkEvent = nullptr;
+}
+
+void FQTableLearner::Start()
+{
+	if (Thread || !FPlatformProcess::SupportsMultithreading()) return;
+
+	// From here on the game thread only reads copies, starting with a copy of the initial state
+	bHasWorker = true;
+	PublishSnapshot();
+	Thread = FRunnableThread::Create(this, TEXT("QTableLearner"), 0, TPri_BelowNormal);
+}
+
+void FQTableLearner::Enqueue(const FQTableUpdateParams& Params)
+{
+	PendingUpdates.Enqueue(Params);
+	NumEnqueued.fetch_add(1, std::memory_order_release);
+
+	if (Thread)
+	{
+		WorkEvent->Trigger();
+	}
+	else
+	{
+		ProcessPendingUpdates();
+	}
+}
+
+void FQTableLearner::Flush()
+{
+	if (!Thread)
+	{
+		ProcessPendingUpdates();
+		return;
+	}
+
+	const uint64 Target = NumEnqueued.load(std::memory_order_acquire);
+	bFlushRequested.store(true, std::memory_order_release);
+	while (NumApplied.load(std::memory_order_acquire) < Target)
+	{
+		WorkEvent->Trigger();
+		FPlatformProcess::Sleep(0.f);
+	}
+	bFlushRequested.store(false, std::memory_order_release);
+}
+
+FQTableSnapshot FQTableLearner::GetSnapshot() const
+{
+	// Without a worker, State is only changed by the caller
+	if (!bHasWorker) return State;
+
+	FScopeLock Lock(&SnapshotLock);
+	return Snapshot;
+}
+
+uint32 FQTableLearner::Run()
+{
+	while (!bStopping.load(std::memory_order_acquire))
+	{
+		// Sleep until more updates arrive, or until the unpublished updates are due
+		uint32 WaitMs = MAX_uint32;
+		if (NumUnpublished > 0)
+		{
+			const double SecondsUntilDue = LastPublishTime + MinPublishInterval - FPlatformTime::Seconds();
+			WaitMs = FMath::Max(0, FMath::CeilToInt(SecondsUntilDue * 1000.0));
+		}
+		WorkEvent->Wait(WaitMs);
+		ProcessPendingUpdates();
+	}
+
+	// Apply and publish anything enqueued before stopping
+	ProcessPendingUpdates();
+	if (NumUnpublished > 0)
+	{
+		PublishSnapshot();
+	}
+	return 0;
+}
+
+void FQTableLearner::Stop()
+{
+	bStopping.store(true, std::memory_order_release);
+	WorkEvent->Trigger();
+}
+
+int32 FQTableLearner::ProcessPendingUpdates()
+{
+	int32 NumProcessed = 0;
+	FQTableUpdateParams Params;
+
+	while (true)
+	{
+		int32 NumInBatch = 0;
+		while (NumInBatch < MaxBatchSize && PendingUpdates.Dequeue(Params))
+		{
+			ApplyUpdate(Params);
+			NumInBatch++;
+		}
+		NumUnpublished += NumInBatch;
+		NumProcessed += NumInBatch;
+
+		if (IsPublishDue())
+		{
+			PublishSnapshot();
+		}
+		if (NumInBatch == 0) break;
+	}
+	return NumProcessed;
+}
+
+bool FQTableLearner::IsPublishDue() const
+{
+	if (NumUnpublished == 0) return false;
+
+	// Publishing without a worker does not copy anything, so there is no reason to wait
+	return !bHasWorker || bFlushRequested.load(std::memory_order_acquire) ||
+		FPlatformTime::Seconds() - LastPublishTime >= MinPublishInterval;
+}
+
+void FQTableLearner::ApplyUpdate(FQTableUpdateParams& Params)
+{
+	if (!State->RowArgMaxTrees.IsValidIndex(Params.StateIndex) ||
+		!State->RowArgMaxTrees.IsValidIndex(Params.ActionIndex))
+	{
+		return;
+	}
+
+	Params.StateIndex_2 = Params.ActionIndex;
+
+	// Choose a random max value
+	MaxIndexCandidates.Reset();
+	State->RowArgMaxTrees[Params.StateIndex_2].GetMaxIndices(MaxIndexCandidates);
+	if (MaxIndexCandidates.IsEmpty()) return;
+	Params.ActionIndex_2 = MaxIndexCandidates[RandomStream.RandRange(0, MaxIndexCandidates.Num() - 1)];
+
+	// Q value for starting at State 1 and taking Action 1 (State 1, Action 1)
+	const float Predict = State->QTable(Params.StateIndex, Params.ActionIndex);
+
+	// Q value for starting at State 2 and taking the Max Action (State 2, Action 2)
+	const float Target = Params.Reward + Gamma * State->QTable(Params.StateIndex_2, Params.ActionIndex_2);
+
+	if (Lambda > 0.f)
+	{
+		ApplyTracedUpdate(Params, Target - Predict);
+	}
+	else
+	{
+		// Q Table update function, assigned to Q Table entry at (State 1, Action 1)
+		State->SetValue(Params.StateIndex, Params.ActionIndex, Predict + Alpha * (Target - Predict));
+	}
+
+	// Increment training samples and TotalTrainingSamples
+	State->TrainingSamples(Params.StateIndex, Params.ActionIndex) += 1;
+	State->TotalTrainingSamples += 1;
+
+	#if !UE_BUILD_SHIPPING
+	if (bPrintDebug_QTableUpdate)
+	{
+		UE_LOG(LogTargetManager, Display,
+			TEXT("QTable Value for TargetPair [%d, %d] & QTableIndex [%d, %d]: Old: %f New: %f"),
+			Params.SpawnAreaIndex_First, Params.SpawnAreaIndex_Second, Params.StateIndex, Params.ActionIndex, Predict,
+			State->QTable(Params.StateIndex, Params.ActionIndex));
+	}
+	#endif
+}
+
+void FQTableLearner::ApplyTracedUpdate(const FQTableUpdateParams& Params, const float TDError)
+{
+	// Credit only flows back along a chain of consecutive targets, so start over if this update doesn't continue it
+	if (Params.StateIndex != LastActionIndex)
+	{
+		Traces.Reset();
+	}
+	LastActionIndex = Params.ActionIndex;
+
+	// Replacing traces: the updated entry always has full eligibility, and is moved to the back as the newest
+	Traces.RemoveAll([&Params](const FEligibilityTrace& Trace)
+	{
+		return Trace.StateIndex == Params.StateIndex && Trace.ActionIndex == Params.ActionIndex;
+	});
+	Traces.Add({Params.StateIndex, Params.ActionIndex, 1.f});
+	if (Traces.Num() > MaxTraceLength)
+	{
+		Traces.RemoveAt(0);
+	}
+
+	for (const FEligibilityTrace& Trace : Traces)
+	{
+		const float Value = State->QTable(Trace.StateIndex, Trace.ActionIndex);
+		State->SetValue(Trace.StateIndex, Trace.ActionIndex, Value + Alpha * TDError * Trace.Eligibility);
+	}
+
+	// Decay, dropping traces too small to matter so that each update only touches a few entries
+	const float Decay = Gamma * Lambda;
+	for (FEligibilityTrace& Trace : Traces)
+	{
+		Trace.Eligibility *= Decay;
+	}
+	Traces.RemoveAll([](const FEligibilityTrace& Trace)
+	{
+		return Trace.Eligibility < MinTraceEligibility;
+	});
+}
+
+void FQTableLearner::PublishSnapshot()
+{
+	State->Version++;
+	if (bHasWorker)
+	{
+		const FQTableSnapshot NewSnapshot = MakeShared<FQTableState, ESPMode::ThreadSafe>(*State);
+		FScopeLock Lock(&SnapshotLock);
+		Snapshot = NewSnapshot;
+	}
+	LastPublishTime = FPlatformTime::Seconds();
+	NumApplied.fetch_add(NumUnpublished, std::memory_order_release);
+	NumUnpublished = 0;
+}
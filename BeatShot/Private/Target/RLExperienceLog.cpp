@@ -0,0 +1,238 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "Target/RLExperienceLog.h"
+#include <atomic>
+#include "BSGameModeDataAsset.h"
+#include "Async/Async.h"
+#include "Containers/Queue.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace RLExperienceLog
+{
+	constexpr uint32 Magic = 0x4C525342; // "BSRL"
+	constexpr uint8 Version = 1;
+
+	FORCEINLINE uint32 ZigZagEncode(const int32 Value)
+	{
+		return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+	}
+
+	FORCEINLINE int32 ZigZagDecode(const uint32 Value)
+	{
+		return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+	}
+
+	void WriteVarInt(TArray<uint8>& Out, uint64 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add(static_cast<uint8>(Value | 0x80));
+			Value >>= 7;
+		}
+		Out.Add(static_cast<uint8>(Value));
+	}
+
+	bool ReadVarInt(const TArray<uint8>& In, int32& Offset, uint64& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 64; Shift += 7)
+		{
+			if (Offset >= In.Num()) return false;
+			const uint8 Byte = In[Offset++];
+			OutValue |= static_cast<uint64>(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0) return true;
+		}
+		return false;
+	}
+}
+
+/** Appends blocks to the file in the order they were flushed, one background task at a time */
+struct FRLExperienceLog::FWriter : TSharedFromThis<FWriter, ESPMode::ThreadSafe>
+{
+	explicit FWriter(const FString& InFilePath) : FilePath(InFilePath), NumPending(0), bWriteScheduled(false)
+	{
+	}
+
+	void Enqueue(TArray<uint8>&& Block)
+	{
+		NumPending.fetch_add(1, std::memory_order_release);
+		PendingBlocks.Enqueue(MoveTemp(Block));
+		if (!bWriteScheduled.exchange(true, std::memory_order_acq_rel))
+		{
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [This = AsShared()]()
+			{
+				This->WritePending();
+			});
+		}
+	}
+
+	void WritePending()
+	{
+		do
+		{
+			TArray<uint8> Block;
+			while (PendingBlocks.Dequeue(Block))
+			{
+				FFileHelper::SaveArrayToFile(Block, *FilePath, &IFileManager::Get(), FILEWRITE_Append);
+				NumPending.fetch_sub(1, std::memory_order_release);
+			}
+			bWriteScheduled.store(false, std::memory_order_release);
+
+			// A block may have been enqueued after the queue was drained but before the flag was cleared
+		}
+		while (!PendingBlocks.IsEmpty() && !bWriteScheduled.exchange(true, std::memory_order_acq_rel));
+	}
+
+	const FString FilePath;
+	TQueue<TArray<uint8>, EQueueMode::Mpsc> PendingBlocks;
+	std::atomic<int32> NumPending;
+	std::atomic<bool> bWriteScheduled;
+};
+
+FRLExperienceLog::FRLExperienceLog(const FString& InFilePath, const FIntVector3& InSpawnAreaSize) :
+	Writer(MakeShared<FWriter, ESPMode::ThreadSafe>(InFilePath)), NumInPayload(0), LastSpawnAreaIndex(0),
+	SpawnAreaSize(InSpawnAreaSize)
+{
+	Payload.Reserve(FlushThreshold + 16);
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(InFilePath), true);
+}
+
+FRLExperienceLog::~FRLExperienceLog()
+{
+	Flush();
+	WaitForWrites();
+}
+
+FString FRLExperienceLog::GetFilePath(const FBS_DefiningConfig& DefiningConfig)
+{
+	FString FileName;
+	if (DefiningConfig.GameModeType == EGameModeType::Custom)
+	{
+		FileName = TEXT("Custom_") + FPaths::MakeValidFileName(DefiningConfig.CustomGameModeName, TEXT('_'));
+	}
+	else
+	{
+		FileName = UEnum::GetDisplayValueAsText(DefiningConfig.BaseGameMode).ToString() + TEXT("_") +
+			UEnum::GetDisplayValueAsText(DefiningConfig.Difficulty).ToString();
+	}
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RLExperience"), FileName + TEXT(".bsrl"));
+}
+
+void FRLExperienceLog::Add(const int32 PreviousSpawnAreaIndex, const int32 SpawnAreaIndex, const bool bHit)
+{
+	using namespace RLExperienceLog;
+
+	const uint64 First = static_cast<uint64>(ZigZagEncode(PreviousSpawnAreaIndex - LastSpawnAreaIndex)) << 1;
+	WriteVarInt(Payload, First | (bHit ? 1 : 0));
+	WriteVarInt(Payload, ZigZagEncode(SpawnAreaIndex - PreviousSpawnAreaIndex));
+
+	LastSpawnAreaIndex = SpawnAreaIndex;
+	NumInPayload++;
+
+	if (Payload.Num() >= FlushThreshold)
+	{
+		Flush();
+	}
+}
+
+void FRLExperienceLog::Flush()
+{
+	using namespace RLExperienceLog;
+
+	if (NumInPayload == 0) return;
+
+	TArray<uint8> Block;
+	Block.Reserve(Payload.Num() + 24);
+	for (int32 Byte = 0; Byte < 4; Byte++)
+	{
+		Block.Add(static_cast<uint8>(Magic >> (Byte * 8)));
+	}
+	Block.Add(Version);
+	WriteVarInt(Block, SpawnAreaSize.Y);
+	WriteVarInt(Block, SpawnAreaSize.Z);
+	WriteVarInt(Block, NumInPayload);
+	WriteVarInt(Block, Payload.Num());
+	Block.Append(Payload);
+
+	Writer->Enqueue(MoveTemp(Block));
+
+	Payload.Reset();
+	NumInPayload = 0;
+	LastSpawnAreaIndex = 0;
+}
+
+void FRLExperienceLog::WaitForWrites() const
+{
+	while (Writer->NumPending.load(std::memory_order_acquire) > 0)
+	{
+		FPlatformProcess::Sleep(0.f);
+	}
+}
+
+bool FRLExperienceLog::Read(const FString& FilePath, TArray<FRLExperience>& OutExperiences,
+	FIntVector3& OutSpawnAreaSize)
+{
+	using namespace RLExperienceLog;
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	// Decode every complete block, remembering the grid each one was recorded with
+	TArray<TPair<FIntVector3, TArray<FRLExperience>>> Blocks;
+	int32 Offset = 0;
+	while (Offset + 5 <= Data.Num())
+	{
+		uint32 BlockMagic = 0;
+		for (int32 Byte = 0; Byte < 4; Byte++)
+		{
+			BlockMagic |= static_cast<uint32>(Data[Offset++]) << (Byte * 8);
+		}
+		if (BlockMagic != Magic || Data[Offset++] != Version) break;
+
+		uint64 NumCols, NumRows, NumExperiences, NumBytes;
+		if (!ReadVarInt(Data, Offset, NumCols) || !ReadVarInt(Data, Offset, NumRows) ||
+			!ReadVarInt(Data, Offset, NumExperiences) || !ReadVarInt(Data, Offset, NumBytes) ||
+			NumBytes > static_cast<uint64>(Data.Num() - Offset))
+		{
+			break;
+		}
+
+		TPair<FIntVector3, TArray<FRLExperience>>& Block = Blocks.AddDefaulted_GetRef();
+		Block.Key = FIntVector3(0, static_cast<int32>(NumCols), static_cast<int32>(NumRows));
+		Block.Value.Reserve(static_cast<int32>(FMath::Min(NumExperiences, NumBytes)));
+
+		const int32 End = Offset + static_cast<int32>(NumBytes);
+		int32 LastIndex = 0;
+		for (uint64 Index = 0; Index < NumExperiences; Index++)
+		{
+			uint64 First, Second;
+			if (Offset >= End || !ReadVarInt(Data, Offset, First) || !ReadVarInt(Data, Offset, Second)) break;
+
+			const int32 Previous = LastIndex + ZigZagDecode(static_cast<uint32>(First >> 1));
+			const int32 Current = Previous + ZigZagDecode(static_cast<uint32>(Second));
+			Block.Value.Emplace(Previous, Current, (First & 1) != 0);
+			LastIndex = Current;
+		}
+		Offset = End;
+	}
+
+	if (Blocks.IsEmpty()) return false;
+
+	// Experiences recorded with a different grid don't map onto the current SpawnAreas
+	OutSpawnAreaSize = Blocks.Last().Key;
+	const int32 NumBefore = OutExperiences.Num();
+	for (const TPair<FIntVector3, TArray<FRLExperience>>& Block : Blocks)
+	{
+		if (Block.Key == OutSpawnAreaSize)
+		{
+			OutExperiences.Append(Block.Value);
+		}
+	}
+	return OutExperiences.Num() > NumBefore;
+}
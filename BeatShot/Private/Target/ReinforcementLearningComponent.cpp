@@ -2,6 +2,8 @@
 
 
 #include "Target/ReinforcementLearningComponent.h"
+#include "Target/MatrixFunctions.h"
+#include "Algo/StableSort.h"
 #if !UE_BUILD_SHIPPING
 #include "Target/TargetManager.h"
 #endif
@@ -13,15 +15,13 @@ UReinforcementLearningComponent::UReinforcementLearningComponent()
 	CompositeCurveTable_HyperParameters = nullptr;
 	ReinforcementLearningMode = EReinforcementLearningMode::None;
 	HyperParameterMode = EReinforcementLearningHyperParameterMode::None;
-	QTable = nc::NdArray<float>();
-	TrainingSamples = nc::NdArray<int32>();
-	SpawnAreaToQTableIndexMap = TArray<FSpawnAreaQTableIndexPair>();
-	QTableToSpawnAreaIndexMap = TMap<int32, FGenericIndexMapping>();
+	Learner = nullptr;
+	CachedSnapshot = nullptr;
+	IndexMapping = nullptr;
 	ActiveTargetPairs = TArray<FTargetPair>();
 	Alpha = 0;
 	Gamma = 0;
 	Epsilon = 0;
-	TotalTrainingSamples = 0;
 	M = Constants::DefaultNumberOfQTableRows;
 	N = Constants::DefaultNumberOfQTableColumns;;
 
@@ -31,6 +31,7 @@ UReinforcementLearningComponent::UReinforcementLearningComponent()
 	bPrintDebug_QTableUpdate = false;
 	bPrintDebug_GetMaxIndex = false;
 	bBroadcastAverageOnQTableUpdate = false;
+	LastWidgetSnapshotVersion = 0;
 	bPrintDebug_ChooseActionIndex = false;
 
 	IntegerFormatting.MaximumFractionalDigits = 0;
@@ -51,6 +52,12 @@ void UReinforcementLearningComponent::BeginPlay()
 
 void UReinforcementLearningComponent::DestroyComponent(bool bPromoteChildren)
 {
+	// Stops the worker thread
+	Learner.Reset();
+	ExperienceLog.Reset();
+	#if !UE_BUILD_SHIPPING
+	RemoveQTableWidgetTicker();
+	#endif
 	Super::DestroyComponent(bPromoteChildren);
 }
 
@@ -61,60 +68,90 @@ void UReinforcementLearningComponent::Init(const FRLAgentParams& AgentParams)
 	Epsilon = AgentParams.AIConfig.Epsilon;
 	ReinforcementLearningMode = AgentParams.AIConfig.ReinforcementLearningMode;
 	HyperParameterMode = AgentParams.AIConfig.HyperParameterMode;
-	TotalTrainingSamples = AgentParams.ScoreInfo.TotalTrainingSamples;
 
-	QTableToSpawnAreaIndexMap = MapMatrixTo5X5(AgentParams.SpawnAreaSize.Z, AgentParams.SpawnAreaSize.Y);
-	
-	// Each row in QTable has size equal to ScaledSize, and so does each column
-	QTable = nc::zeros<float>(nc::Shape(M, N));
-	TrainingSamples = nc::zeros<int32>(nc::Shape(M, N));
+	if (AgentParams.RandomSeed.IsSet())
+	{
+		RandomStream.Initialize(AgentParams.RandomSeed.GetValue());
+	}
+	else
+	{
+		RandomStream.GenerateNewSeed();
+	}
+
+	FQTableState State;
+	State.TotalTrainingSamples = AgentParams.ScoreInfo.TotalTrainingSamples;
 
-	// Init QTableIndices array
-	for (const TPair<int32, FGenericIndexMapping>& Mapping : QTableToSpawnAreaIndexMap)
+	// Group the SpawnAreas into the configured resolution, reusing the mapping if this grid has been seen before
+	IndexMapping = FQTableIndexMapping::Get(AgentParams.SpawnAreaSize.Z, AgentParams.SpawnAreaSize.Y,
+		AgentParams.AIConfig.QTableResolution);
+
+	// Each row in QTable has size equal to the number of grid cells, and so does each column
+	M = IndexMapping->Num();
+	N = IndexMapping->Num();
+	State.QTable.Init(M, N);
+	State.TrainingSamples.Init(M, N);
+
+	#if !UE_BUILD_SHIPPING
+	if (bPrintDebug_QTableInit)
 	{
-		for (const int32 SpawnAreaIndex : Mapping.Value.MappedIndices)
+		for (int32 QTableIndex = 0; QTableIndex < IndexMapping->Num(); QTableIndex++)
 		{
-			SpawnAreaToQTableIndexMap.Add(FSpawnAreaQTableIndexPair(SpawnAreaIndex, Mapping.Key));
+			UE_LOG(LogTargetManager, Display, TEXT("Index %d has %d SpawnAreas associated with it."), QTableIndex,
+				IndexMapping->GetSpawnAreaMask(QTableIndex).Num());
 		}
-		#if !UE_BUILD_SHIPPING
-		if (bPrintDebug_QTableInit)
-		{
-			UE_LOG(LogTargetManager, Display, TEXT("Index %d has %d SpawnAreas associated with it."), Mapping.Key,
-				Mapping.Value.MappedIndices.Num());
-		}
-		#endif
 	}
+	#endif
 
-	// Use existing QTable if possible
-	if (AgentParams.ScoreInfo.NumQTableRows == QTable.numRows() && AgentParams.ScoreInfo.NumQTableColumns == QTable.numCols())
+	// Use existing QTable if possible, each is left zeroed if its size does not match
+	if (AgentParams.ScoreInfo.NumQTableRows == M && AgentParams.ScoreInfo.NumQTableColumns == N)
 	{
-		if (QTable.size() == AgentParams.ScoreInfo.QTable.Num())
-		{
-			QTable = GetNdArrayFromTArray<float>(AgentParams.ScoreInfo.QTable, AgentParams.ScoreInfo.NumQTableRows,
-				AgentParams.ScoreInfo.NumQTableColumns);
-		}
-		if (TrainingSamples.size() == AgentParams.ScoreInfo.TrainingSamples.Num())
-		{
-			TrainingSamples = GetNdArrayFromTArray<int32>(AgentParams.ScoreInfo.TrainingSamples, AgentParams.ScoreInfo.NumQTableRows,
-				AgentParams.ScoreInfo.NumQTableColumns);
-		}
+		State.QTable.InitFromScoreInfoArray(AgentParams.ScoreInfo.QTable, M, N);
+		State.TrainingSamples.InitFromScoreInfoArray(AgentParams.ScoreInfo.TrainingSamples, M, N);
 	}
 
 	// Check NaNs
-	QTable = nc::nan_to_num<float>(QTable, 0.f);
+	State.QTable.ReplaceNaN(0.f);
+	State.InitOrdering();
+
+	// Hand the state to the learner, which applies rewards on its own thread and publishes snapshots
+	const float Lambda = AgentParams.AIConfig.UpdateMode == EReinforcementLearningUpdateMode::QLambda
+		? AgentParams.AIConfig.Lambda
+		: 0.f;
+	Learner = MakeShared<FQTableLearner>(MoveTemp(State), Alpha, Gamma, Lambda,
+		RandomStream.RandHelper(MAX_int32));
+
+	#if !UE_BUILD_SHIPPING
+	Learner->bPrintDebug_QTableUpdate = bPrintDebug_QTableUpdate;
+	#endif
+
+	if (AgentParams.bUseWorkerThread)
+	{
+		Learner->Start();
+
+		#if !UE_BUILD_SHIPPING
+		RemoveQTableWidgetTicker();
+		QTableWidgetTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &ThisClass::TickQTableWidget), QTableWidgetUpdateInterval);
+		#endif
+	}
+	CachedSnapshot = Learner->GetSnapshot();
+
+	if (!AgentParams.ExperienceLogPath.IsEmpty())
+	{
+		ExperienceLog = MakeUnique<FRLExperienceLog>(AgentParams.ExperienceLogPath, AgentParams.SpawnAreaSize);
+	}
 
 	#if !UE_BUILD_SHIPPING
 	if (bPrintDebug_QTableInit)
 	{
-		UE_LOG(LogTargetManager, Display, TEXT("Unique Indices across entire mapping: %d Input Size: %d"),
-			QTableToSpawnAreaIndexMap.Num(),
-		AgentParams.SpawnAreaSize.Z * AgentParams.SpawnAreaSize.Y);
+		UE_LOG(LogTargetManager, Display, TEXT("QTableGridRows: %d QTableGridColumns: %d Input Size: %d"),
+			IndexMapping->NumRows, IndexMapping->NumCols, IndexMapping->SpawnAreaToQTableIndex.Num());
 		UE_LOG(LogTargetManager, Display, TEXT("In QTable Size: %d  Actual QTable Size: %d"),
-			AgentParams.ScoreInfo.QTable.Num(), QTable.size());
+			AgentParams.ScoreInfo.QTable.Num(), GetQTable().Num());
 		UE_LOG(LogTargetManager, Display, TEXT("SpawnAreasRows: %d SpawnAreasColumns: %d"),
 			AgentParams.SpawnAreaSize.Z, AgentParams.SpawnAreaSize.Y);
 		UE_LOG(LogTargetManager, Display, TEXT("QTableRows: %d QTableColumns: %d"), M, N);
-		UE_LOG(LogTargetManager, Display, TEXT("QTable Training Samples: %lld"), TotalTrainingSamples);
+		UE_LOG(LogTargetManager, Display, TEXT("QTable Training Samples: %lld"), GetTotalTrainingSamples());
 	}
 	#endif
 }
@@ -123,16 +160,17 @@ void UReinforcementLearningComponent::Clear()
 {
 	ReinforcementLearningMode = EReinforcementLearningMode::None;
 	HyperParameterMode = EReinforcementLearningHyperParameterMode::None;
-	QTable = nc::NdArray<float>();
-	TrainingSamples = nc::NdArray<int32>();
-	SpawnAreaToQTableIndexMap.Empty();
-	QTableToSpawnAreaIndexMap.Empty();
-	TargetPairs.Empty();
+	Learner.Reset();
+	CachedSnapshot.Reset();
+	IndexMapping.Reset();
+	ExperienceLog.Reset();
 	ActiveTargetPairs.Empty();
+	#if !UE_BUILD_SHIPPING
+	RemoveQTableWidgetTicker();
+	#endif
 	Alpha = 0;
 	Gamma = 0;
 	Epsilon = 0;
-	TotalTrainingSamples = 0;
 	M = Constants::DefaultNumberOfQTableRows;
 	N = Constants::DefaultNumberOfQTableColumns;;
 }
@@ -155,19 +193,22 @@ void UReinforcementLearningComponent::AddToActiveTargetPairs(const int32 SpawnAr
 
 void UReinforcementLearningComponent::SetActiveTargetPairReward(const int32 SpawnAreaIndex, const bool bHit)
 {
-	if (ActiveTargetPairs.IsEmpty())
+	if (ActiveTargetPairs.IsEmpty() || !Learner)
 	{
 		return;
 	}
 	
-	if (FTargetPair* FoundPair = FindTargetPairByCurrentIndex(SpawnAreaIndex))
+	if (const FTargetPair* FoundPair = FindTargetPairByCurrentIndex(SpawnAreaIndex))
 	{
-		// Update reward
-		FTargetPair Copy = FTargetPair(*FoundPair);
-		Copy.SetReward(bHit ? -1.f : 1.f);
+		// Convert SpawnArea indices to QTable indices and queue the reward for the learner
+		const FQTableUpdateParams UpdateParams(FoundPair->First, FoundPair->Second, bHit ? -1.f : 1.f,
+			GetIndex_FromSpawnArea_ToQTable(FoundPair->First), GetIndex_FromSpawnArea_ToQTable(FoundPair->Second));
+		if (ExperienceLog)
+		{
+			ExperienceLog->Add(FoundPair->First, FoundPair->Second, bHit);
+		}
 		ActiveTargetPairs.RemoveSingle(*FoundPair);
-		TargetPairs.Enqueue(MoveTemp(Copy));
-		ClearCachedTargetPairs();
+		Learner->Enqueue(UpdateParams);
 	}
 	#if !UE_BUILD_SHIPPING
 	else
@@ -179,30 +220,29 @@ void UReinforcementLearningComponent::SetActiveTargetPairReward(const int32 Spaw
 
 void UReinforcementLearningComponent::ClearCachedTargetPairs()
 {
-	while (!TargetPairs.IsEmpty())
+	if (Learner)
 	{
-		FTargetPair TargetPair;
-		if (TargetPairs.Dequeue(TargetPair))
-		{
-			FQTableUpdateParams UpdateParams = FQTableUpdateParams(TargetPair);
-			UpdateQTable(UpdateParams);
-		}
+		Learner->Flush();
+	}
+	if (ExperienceLog)
+	{
+		ExperienceLog->Flush();
 	}
 }
 
 int32 UReinforcementLearningComponent::ChooseNextActionIndex(const int32 PreviousSpawnAreaIndex,
-	const TArray<int32>& SpawnAreaIndices) const
+	const FSpawnAreaBitSet& ValidSpawnAreas) const
 {
 	// Only Exploration and ActiveAgent Reinforcement Learning Modes should choose spawn locations
-	if (SpawnAreaIndices.IsEmpty() || ReinforcementLearningMode == EReinforcementLearningMode::None ||
+	if (ValidSpawnAreas.IsEmpty() || ReinforcementLearningMode == EReinforcementLearningMode::None ||
 		ReinforcementLearningMode == EReinforcementLearningMode::Training)
 	{
 		return INDEX_NONE;
 	}
 
-	if (FMath::FRandRange(0, 1.f) > Epsilon)
+	if (RandomStream.FRand() > Epsilon)
 	{
-		const int32 BestActionIndex = ChooseBestActionIndex(PreviousSpawnAreaIndex, SpawnAreaIndices);
+		const int32 BestActionIndex = ChooseBestActionIndex(PreviousSpawnAreaIndex, ValidSpawnAreas);
 		if (BestActionIndex == INDEX_NONE)
 		{
 			#if !UE_BUILD_SHIPPING
@@ -212,55 +252,68 @@ int32 UReinforcementLearningComponent::ChooseNextActionIndex(const int32 Previou
 					TEXT("No acceptable index range found, falling back to choosing random action"));
 			}
 			#endif
-			return ChooseRandomActionIndex(SpawnAreaIndices);
+			return ChooseRandomActionIndex(ValidSpawnAreas);
 		}
 		return BestActionIndex;
 	}
-	return ChooseRandomActionIndex(SpawnAreaIndices);
+	return ChooseRandomActionIndex(ValidSpawnAreas);
 }
 
-int32 UReinforcementLearningComponent::ChooseRandomActionIndex(const TArray<int32>& SpawnAreaIndices)
+int32 UReinforcementLearningComponent::ChooseRandomActionIndex(const FSpawnAreaBitSet& ValidSpawnAreas) const
 {
-	return SpawnAreaIndices[FMath::RandRange(0, SpawnAreaIndices.Num() - 1)];
+	return ValidSpawnAreas.GetRandomIndex(RandomStream);
 }
 
 int32 UReinforcementLearningComponent::ChooseBestActionIndex(const int32 PreviousSpawnAreaIndex,
-	const TArray<int32>& SpawnAreaIndices) const
+	const FSpawnAreaBitSet& ValidSpawnAreas) const
 {
 	int32 ReturnIndex = INDEX_NONE;
 	int32 NumFiltersRequired = 0;
 	int32 NumCurrentIndexChoices = 0;
 
-	const TArray<int32> MaxIndices = (PreviousSpawnAreaIndex == INDEX_NONE)
-		? GetIndices_MaximizeFirst()
-		: GetIndices_MaximizeSecond(GetIndex_FromSpawnArea_ToQTable(PreviousSpawnAreaIndex));
+	const int32 PreviousQTableIndex = PreviousSpawnAreaIndex == INDEX_NONE
+		? INDEX_NONE
+		: GetIndex_FromSpawnArea_ToQTable(PreviousSpawnAreaIndex);
+
+	// Read the orderings from the latest snapshot, never waiting on the learner
+	const FQTableState& State = GetQTableState();
+	const FArgMaxTree& Ordering = State.RowArgMaxTrees.IsValidIndex(PreviousQTableIndex)
+		? State.RowArgMaxTrees[PreviousQTableIndex]
+		: State.RowSumArgMaxTree;
+
+	/* Returns true and sets ReturnIndex if the QTable index represents any of the ValidSpawnAreas */
+	auto TryQTableIndex = [&](const int32 QTableIndex)
+	{
+		if (!IndexMapping || !IndexMapping->QTableToSpawnAreaMasks.IsValidIndex(QTableIndex)) return false;
+		NumFiltersRequired++;
+
+		/* Mask out any SpawnAreas that aren't valid, and choose a random one from what remains */
+		const FSpawnAreaBitSet& Mask = IndexMapping->GetSpawnAreaMask(QTableIndex);
+		NumCurrentIndexChoices = Mask.CountIntersection(ValidSpawnAreas);
+		if (NumCurrentIndexChoices == 0) return false;
+
+		ReturnIndex = Mask.FindNthSetBitInIntersection(ValidSpawnAreas,
+			RandomStream.RandRange(0, NumCurrentIndexChoices - 1));
+		return true;
+	};
+
+	/* Try the indices tied for the maximum in random order so that ties are not biased towards one index */
+	TArray<int32> MaxIndices;
+	Ordering.GetMaxIndices(MaxIndices);
+	for (int32 i = MaxIndices.Num() - 1; i > 0; i--)
+	{
+		MaxIndices.Swap(i, RandomStream.RandRange(0, i));
+	}
 
 	for (const int32 Index : MaxIndices)
 	{
-		/* Get the SpawnArea indices that the chosen index represents */
-		TArray<int32> UnfilteredSpawnAreaIndices = GetSpawnAreaIndexRange(Index);
+		if (TryQTableIndex(Index)) break;
+	}
 
-		/* Remove any indices that aren't inside the current SpawnAreaIndices */
-		const TArray<int32> FilteredSpawnAreaIndices = UnfilteredSpawnAreaIndices.FilterByPredicate(
-			[&SpawnAreaIndices, &NumFiltersRequired](const int32& Value)
-			{
-				NumFiltersRequired++;
-				if (SpawnAreaIndices.Contains(Value))
-				{
-					return true;
-				}
-				return false;
-			});
-
-		NumCurrentIndexChoices = FilteredSpawnAreaIndices.Num();
-
-		/* Return a random point inside the filtered spawn indices if not empty */
-		if (!FilteredSpawnAreaIndices.IsEmpty())
-		{
-			const int32 RandomIndex = FMath::RandRange(0, FilteredSpawnAreaIndices.Num() - 1);
-			ReturnIndex = FilteredSpawnAreaIndices[RandomIndex];
-			break;
-		}
+	/* Otherwise take the next best index that has a valid SpawnArea */
+	if (ReturnIndex == INDEX_NONE)
+	{
+		Ordering.FindBestIndex(TryQTableIndex);
 	}
 
 	#if !UE_BUILD_SHIPPING
@@ -275,153 +328,72 @@ int32 UReinforcementLearningComponent::ChooseBestActionIndex(const int32 Previou
 	return ReturnIndex;
 }
 
-void UReinforcementLearningComponent::UpdateQTable(FQTableUpdateParams& UpdateParams)
-{
-	// Convert SpawnArea indices to QTable indices
-	UpdateParams.StateIndex = GetIndex_FromSpawnArea_ToQTable(UpdateParams.TargetPair.First);
-	UpdateParams.ActionIndex = GetIndex_FromSpawnArea_ToQTable(UpdateParams.TargetPair.Second);
-	UpdateParams.StateIndex_2 = UpdateParams.ActionIndex;
-
-	// Choose a random max value
-	const TArray<int32> MaxIndex_2_Candidates = GetIndices_MaximizeSecond(UpdateParams.StateIndex_2);
-	UpdateParams.ActionIndex_2 = FMath::RandRange(0, MaxIndex_2_Candidates.Num() - 1);
-
-	// Q value for starting at State 1 and taking Action 1 (State 1, Action 1)
-	const float Predict = QTable(UpdateParams.StateIndex, UpdateParams.ActionIndex);
-
-	// Q value for starting at State 2 and taking the Max Action (State 2, Action 2)
-	const float Target = UpdateParams.TargetPair.GetReward() + Gamma * QTable(UpdateParams.StateIndex_2,
-		UpdateParams.ActionIndex_2);
-
-	// Q Table update function
-	const float NewValue = QTable(UpdateParams.StateIndex, UpdateParams.ActionIndex) + Alpha * (Target - Predict);
-	const float OldValue = QTable(UpdateParams.StateIndex, UpdateParams.ActionIndex);
-
-	// Assign new value to Q Table entry at (State 1, Action 1)
-	QTable(UpdateParams.StateIndex, UpdateParams.ActionIndex) = NewValue;
+// Getters and utility functions
 
-	// Increment training samples and TotalTrainingSamples
-	TrainingSamples(UpdateParams.StateIndex, UpdateParams.ActionIndex) += 1;
-	TotalTrainingSamples += 1;
+const FQTableState& UReinforcementLearningComponent::GetQTableState() const
+{
+	static const FQTableState EmptyState;
 
-	#if !UE_BUILD_SHIPPING
-	if (bPrintDebug_QTableUpdate)
+	if (Learner)
 	{
-		UE_LOG(LogTargetManager, Display,
-			TEXT("QTable Value for TargetPair [%d, %d] & QTableIndex [%d, %d]: Old: %f New: %f"),
-			UpdateParams.TargetPair.First, UpdateParams.TargetPair.Second, UpdateParams.StateIndex,
-			UpdateParams.ActionIndex, OldValue, NewValue);
+		CachedSnapshot = Learner->GetSnapshot();
 	}
-	UpdateQTableWidget();
-	#endif
+	return CachedSnapshot.IsValid() ? *CachedSnapshot : EmptyState;
 }
 
-// Getters and utility functions
-
 TArray<int32> UReinforcementLearningComponent::GetIndices_MaximizeFirst() const
 {
 	TArray<int32> MaxIndices;
-
-	// Compute the sum of values for each row
-	const nc::NdArray<float> RowSum = nc::sum(GetQTable(), nc::Axis::COL);
-
-	// Get the indices that correspond to sums
-	const nc::NdArray<unsigned> SortedIndices = nc::argsort(RowSum);
-
-	// Reverse to get descending order
-	const nc::NdArray<unsigned> ReverseSortedIndices = nc::flip(SortedIndices);
-
-	// Compute MaxValue
-	const float MaxValue = RowSum[ReverseSortedIndices[0]];
-
-	// Find any values equal to the MaxValue, and add them to MaxIndices
-	for (size_t i = 0; i < ReverseSortedIndices.size(); ++i)
-	{
-		if (RowSum[ReverseSortedIndices[i]] == MaxValue)
-		{
-			MaxIndices.Add(static_cast<int32>(ReverseSortedIndices[i]));
-		}
-		else
-		{
-			break; // Stop when values are no longer the maximum
-		}
-	}
-
+	GetQTableState().RowSumArgMaxTree.GetMaxIndices(MaxIndices);
 	return MaxIndices;
 }
 
 TArray<int32> UReinforcementLearningComponent::GetIndices_MaximizeSecond(const int32 InPreviousIndex) const
 {
 	TArray<int32> MaxIndices;
+	const FQTableState& State = GetQTableState();
+	if (!State.RowArgMaxTrees.IsValidIndex(InPreviousIndex)) return MaxIndices;
 
-	// Extract the row (all the columns) corresponding to the previous index
-	const nc::NdArray<float> PreviousRow = GetQTable()(InPreviousIndex, GetQTable().cSlice(0));
-
-	// Get the indices that correspond to sums
-	const nc::NdArray<unsigned> ArgSortedIndices = nc::argsort(PreviousRow);
-
-	// Reverse to get descending order
-	nc::NdArray<unsigned> ReverseSortedIndices = nc::flip(ArgSortedIndices);
-
-	// Maximum value within the row
-	const float MaxValue = PreviousRow[ReverseSortedIndices[0]];
-
-	// Find any values equal to the MaxValue, and add them to MaxIndices
-	for (size_t i = 0; i < ReverseSortedIndices.size(); ++i)
-	{
-		if (PreviousRow[ReverseSortedIndices[i]] == MaxValue)
-		{
-			MaxIndices.Add(static_cast<int32>(ReverseSortedIndices[i]));
-		}
-		else
-		{
-			break; // Stop when values are no longer the maximum
-		}
-	}
+	// Every column tied for the maximum value of the row, maintained as the row is updated
+	const FArgMaxTree& RowOrdering = State.RowArgMaxTrees[InPreviousIndex];
+	RowOrdering.GetMaxIndices(MaxIndices);
 
 	#if !UE_BUILD_SHIPPING
 	if (bPrintDebug_GetMaxIndex)
 	{
-		PrintGetMaxIndex(InPreviousIndex, MaxValue, PreviousRow, ReverseSortedIndices);
+		PrintGetMaxIndex(InPreviousIndex, RowOrdering.GetValue(RowOrdering.GetArgMax()),
+			State.GetRow(InPreviousIndex), MaxIndices);
 	}
 	#endif
 
 	return MaxIndices;
 }
 
-TArray<float> UReinforcementLearningComponent::GetTArray_FromNdArray_QTableAvg() const
+TArray<float> UReinforcementLearningComponent::GetTArray_QTableAvg() const
 {
-	nc::NdArray<float> QTableMean = nc::mean(GetQTable(), nc::Axis::ROW).astype<float>();
-	const nc::NdArray<float> Reshaped = QTableMean.reshape(5, 5);
-	const nc::NdArray<float> Flipped = nc::flipud<float>(Reshaped);
-	return GetTArrayFromNdArray<float>(Flipped);
-}
+	const TQTable<float>& QTable = GetQTable();
+	if (QTable.IsEmpty() || !IndexMapping || QTable.GetNumCols() != IndexMapping->Num()) return TArray<float>();
 
-TArray<float> UReinforcementLearningComponent::GetTArray_FromNdArray_QTableMax() const
-{
-	nc::NdArray<float> QTableMin = nc::max(GetQTable(), nc::Axis::ROW).astype<float>();
-	const nc::NdArray<float> Reshaped = QTableMin.reshape(5, 5);
-	const nc::NdArray<float> Flipped = nc::flipud<float>(Reshaped);
-	return GetTArrayFromNdArray<float>(Flipped);
+	TArray<float, TInlineAllocator<Constants::DefaultNumberOfQTableColumns>> Means;
+	Means.SetNumUninitialized(QTable.GetNumCols());
+	QTable.ColumnMeans(Means);
+	return GetFlippedUpDownTArray<float>(Means, IndexMapping->NumRows, IndexMapping->NumCols);
 }
 
-int32 UReinforcementLearningComponent::GetIndex_FromSpawnArea_ToQTable(const int32 SpawnAreaIndex) const
+TArray<float> UReinforcementLearningComponent::GetTArray_QTableMax() const
 {
-	const FSpawnAreaQTableIndexPair* Found = SpawnAreaToQTableIndexMap.FindByPredicate(
-		[&SpawnAreaIndex](const FSpawnAreaQTableIndexPair& IndexPair)
-		{
-			return IndexPair.SpawnAreaIndex == SpawnAreaIndex;
-		});
+	const TQTable<float>& QTable = GetQTable();
+	if (QTable.IsEmpty() || !IndexMapping || QTable.GetNumCols() != IndexMapping->Num()) return TArray<float>();
 
-	return Found ? Found->QTableIndex : INDEX_NONE;
+	TArray<float, TInlineAllocator<Constants::DefaultNumberOfQTableColumns>> Maxes;
+	Maxes.SetNumUninitialized(QTable.GetNumCols());
+	QTable.ColumnMaxes(Maxes);
+	return GetFlippedUpDownTArray<float>(Maxes, IndexMapping->NumRows, IndexMapping->NumCols);
 }
 
-TArray<int32> UReinforcementLearningComponent::GetSpawnAreaIndexRange(const int32 QTableIndex) const
+int32 UReinforcementLearningComponent::GetIndex_FromSpawnArea_ToQTable(const int32 SpawnAreaIndex) const
 {
-	TArray<int32> Out;
-	const FGenericIndexMapping* Found = QTableToSpawnAreaIndexMap.Find(QTableIndex);
-
-	return Found ? Found->MappedIndices : TArray<int32>();
+	return IndexMapping ? IndexMapping->GetQTableIndex(SpawnAreaIndex) : INDEX_NONE;
 }
 
 FTargetPair* UReinforcementLearningComponent::FindTargetPairByCurrentIndex(const int32 InCurrentIndex)
@@ -435,31 +407,64 @@ FTargetPair* UReinforcementLearningComponent::FindTargetPairByCurrentIndex(const
 // Debug functions
 #if !UE_BUILD_SHIPPING
 
-void UReinforcementLearningComponent::UpdateQTableWidget() const
+void UReinforcementLearningComponent::UpdateQTableWidget()
 {
-	if (OnQTableUpdate.IsBound())
+	if (!OnQTableUpdate.IsBound()) return;
+
+	const TArray<float> Values = bBroadcastAverageOnQTableUpdate ? GetTArray_QTableAvg() : GetTArray_QTableMax();
+	const bool bSendAll = LastWidgetValues.Num() != Values.Num();
+
+	// Only send cells that would display differently, since the widget shows two decimal places
+	TArray<int32> ChangedIndices;
+	TArray<float> ChangedValues;
+	for (int32 Index = 0; Index < Values.Num(); Index++)
 	{
-		if (bBroadcastAverageOnQTableUpdate)
-		{
-			OnQTableUpdate.Broadcast(GetTArray_FromNdArray_QTableAvg());
-		}
-		else
+		if (bSendAll || !FMath::IsNearlyEqual(Values[Index], LastWidgetValues[Index], 0.005f))
 		{
-			OnQTableUpdate.Broadcast(GetTArray_FromNdArray_QTableMax());
+			ChangedIndices.Add(Index);
+			ChangedValues.Add(Values[Index]);
 		}
 	}
+	LastWidgetValues = Values;
+
+	if (!ChangedIndices.IsEmpty())
+	{
+		OnQTableUpdate.Broadcast(ChangedIndices, ChangedValues);
+	}
+}
+
+bool UReinforcementLearningComponent::TickQTableWidget(float DeltaTime)
+{
+	const uint64 Version = GetQTableState().Version;
+	if (Version != LastWidgetSnapshotVersion)
+	{
+		LastWidgetSnapshotVersion = Version;
+		UpdateQTableWidget();
+	}
+	return true;
+}
+
+void UReinforcementLearningComponent::RemoveQTableWidgetTicker()
+{
+	if (QTableWidgetTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(QTableWidgetTickerHandle);
+		QTableWidgetTickerHandle.Reset();
+	}
+	LastWidgetSnapshotVersion = 0;
+	LastWidgetValues.Reset();
 }
 
 void UReinforcementLearningComponent::PrintRewards() const
 {
 	FString Row;
-	nc::NdArray<float> QTableCopy = GetQTable();
-	for (int j = 0; j < static_cast<int>(QTableCopy.numCols()); j++)
+	const TQTable<float>& QTableRef = GetQTable();
+	for (int j = 0; j < QTableRef.GetNumCols(); j++)
 	{
 		Row.Empty();
-		for (int i = 0; i < static_cast<int>(QTableCopy.numRows()); i++)
+		for (int i = 0; i < QTableRef.GetNumRows(); i++)
 		{
-			const float Value = round(QTableCopy(i, j) * 100.0) / 100.0;
+			const float Value = round(QTableRef(i, j) * 100.0) / 100.0;
 			if (Value >= 0.f)
 			{
 				Row.Append("+" + FString::SanitizeFloat(Value, 2) + " ");
@@ -472,12 +477,20 @@ void UReinforcementLearningComponent::PrintRewards() const
 		UE_LOG(LogTargetManager, Display, TEXT("%s"), *Row);
 	}
 
-	int i = 0;
-	nc::NdArray<double> FlippedMean = flipud(mean(GetQTable(), nc::Axis::ROW).reshape(5, 5));
+	if (!IndexMapping || QTableRef.GetNumCols() != IndexMapping->Num()) return;
+
+	// Column means in the shape of the grid, flipped upside down
+	const int32 GridRows = IndexMapping->NumRows;
+	const int32 GridCols = IndexMapping->NumCols;
+	TArray<float, TInlineAllocator<Constants::DefaultNumberOfQTableColumns>> Means;
+	Means.SetNumUninitialized(QTableRef.GetNumCols());
+	QTableRef.ColumnMeans(Means);
+
 	Row.Empty();
-	for (const double It : FlippedMean)
+	for (int i = 0; i < Means.Num(); i++)
 	{
-		const float Value = roundf(static_cast<float>(It) * 100.0) / 100.0;;
+		const float It = Means[(GridRows - 1 - i / GridCols) * GridCols + i % GridCols];
+		const float Value = roundf(It * 100.0) / 100.0;
 		if (It >= 0.f)
 		{
 			Row.Append("+" + FString::SanitizeFloat(Value, 2) + " ");
@@ -486,8 +499,7 @@ void UReinforcementLearningComponent::PrintRewards() const
 		{
 			Row.Append(FString::SanitizeFloat(Value, 2) + " ");
 		}
-		i++;
-		if (i % 5 == 0)
+		if ((i + 1) % GridCols == 0)
 		{
 			UE_LOG(LogTargetManager, Display, TEXT("%s"), *Row);
 			Row.Empty();
@@ -502,19 +514,35 @@ void UReinforcementLearningComponent::PrintMaxAverageIndices() const
 	FString Row3 = " ";
 	FString Row4;
 
-	/* Averages instead of maxes */
-	auto AvgValues = mean(GetQTable(), nc::Axis::ROW).sort();
-	auto AvgIndices = AvgValues.argsort(nc::Axis::COL);
+	const TQTable<float>& QTableRef = GetQTable();
+	if (QTableRef.IsEmpty()) return;
 
-	auto MaxValues = nc::max(GetQTable(), nc::Axis::ROW).sort();
-	auto MaxIndices = MaxValues.argsort(nc::Axis::COL);
+	/* Averages instead of maxes */
+	TArray<float, TInlineAllocator<Constants::DefaultNumberOfQTableColumns>> AvgValues;
+	AvgValues.SetNumUninitialized(QTableRef.GetNumCols());
+	QTableRef.ColumnMeans(AvgValues);
+
+	TArray<float, TInlineAllocator<Constants::DefaultNumberOfQTableColumns>> MaxValues;
+	MaxValues.SetNumUninitialized(QTableRef.GetNumCols());
+	QTableRef.ColumnMaxes(MaxValues);
+
+	// Column indices in ascending order of value
+	TArray<int32, TInlineAllocator<Constants::DefaultNumberOfQTableColumns>> AvgIndices;
+	TArray<int32, TInlineAllocator<Constants::DefaultNumberOfQTableColumns>> MaxIndices;
+	for (int j = 0; j < QTableRef.GetNumCols(); j++)
+	{
+		AvgIndices.Add(j);
+		MaxIndices.Add(j);
+	}
+	Algo::StableSort(AvgIndices, [&AvgValues](const int32 A, const int32 B) { return AvgValues[A] < AvgValues[B]; });
+	Algo::StableSort(MaxIndices, [&MaxValues](const int32 A, const int32 B) { return MaxValues[A] < MaxValues[B]; });
 
-	for (int j = 0; j < static_cast<int>(MaxIndices.numCols()); j++)
+	for (int j = 0; j < MaxIndices.Num(); j++)
 	{
-		const float MaxIndex = MaxIndices(0, j);
-		const float AverageIndex = AvgIndices(0, j);
-		const float MaxValue = MaxValues(0, j);
-		const float AverageValue = AvgValues(0, j);
+		const float MaxIndex = MaxIndices[j];
+		const float AverageIndex = AvgIndices[j];
+		const float MaxValue = MaxValues[MaxIndices[j]];
+		const float AverageValue = AvgValues[AvgIndices[j]];
 
 		Row += (FText::AsNumber(MaxIndex, &IntegerFormatting).ToString() + "     ");
 
@@ -547,7 +575,7 @@ void UReinforcementLearningComponent::PrintMaxAverageIndices() const
 }
 
 void UReinforcementLearningComponent::PrintGetMaxIndex(const int32 PreviousIndex, const float MaxValue,
-	const nc::NdArray<float>& PreviousRow, const nc::NdArray<unsigned>& ReverseSortedIndices) const
+	TConstArrayView<float> PreviousRow, const TArray<int32>& MaxIndices) const
 {
 	FString String;
 	for (const float Value : PreviousRow)
@@ -557,25 +585,10 @@ void UReinforcementLearningComponent::PrintGetMaxIndex(const int32 PreviousIndex
 	UE_LOG(LogTargetManager, Display, TEXT("RowIdx %d: %s"), PreviousIndex, *String);
 	String.Empty();
 
-	for (const unsigned Value : ReverseSortedIndices)
+	for (const int32 Value : MaxIndices)
 	{
 		String += ("  " + FText::AsNumber(Value, &IntegerFormatting).ToString() + " ");
 	}
-	UE_LOG(LogTargetManager, Display, TEXT("RowIdx %d ReversedArgSort: %s"), PreviousIndex, *String);
-	String.Empty();
-
-	// Find any values equal to the MaxValue, and add them to MaxIndices
-	for (size_t i = 0; i < ReverseSortedIndices.size(); ++i)
-	{
-		if (PreviousRow[ReverseSortedIndices[i]] == MaxValue)
-		{
-			String += ("  " + FText::AsNumber(ReverseSortedIndices[i], &IntegerFormatting).ToString() + " ");
-		}
-		else
-		{
-			break; // Stop when values are no longer the maximum
-		}
-	}
 	UE_LOG(LogTargetManager, Display, TEXT("Max Value for Row Index %d: %s, Max Indices: %s"), PreviousIndex,
 		*FString("  " + FText::AsNumber(MaxValue, &FloatFormatting).ToString() + " "), *String);
 }
@@ -0,0 +1,167 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "Target/SpawnAreaFloodFill.h"
+
+namespace
+{
+	/** Row and column offsets to each neighbor, starting to the left and going clockwise */
+	constexpr int32 NeighborRowOffsets[FSpawnAreaFloodFill::NumNeighbors] = {0, 1, 1, 1, 0, -1, -1, -1};
+	constexpr int32 NeighborColOffsets[FSpawnAreaFloodFill::NumNeighbors] = {-1, -1, 0, 1, 1, 1, 0, -1};
+}
+
+void FSpawnAreaFloodFill::Init(const int32 InNumRows, const int32 InNumCols)
+{
+	NumRows = InNumRows;
+	NumCols = InNumCols;
+	const int32 NumIndices = NumRows * NumCols;
+
+	for (int32 Neighbor = 0; Neighbor < NumNeighbors; Neighbor++)
+	{
+		NeighborOffsets[Neighbor] = NeighborRowOffsets[Neighbor] * NumCols + NeighborColOffsets[Neighbor];
+	}
+
+	NeighborMasks.SetNumUninitialized(NumIndices);
+	for (int32 Index = 0; Index < NumIndices; Index++)
+	{
+		const int32 Row = Index / NumCols;
+		const int32 Col = Index % NumCols;
+		uint8 Mask = 0;
+		for (int32 Neighbor = 0; Neighbor < NumNeighbors; Neighbor++)
+		{
+			const int32 NeighborRow = Row + NeighborRowOffsets[Neighbor];
+			const int32 NeighborCol = Col + NeighborColOffsets[Neighbor];
+			if (NeighborRow >= 0 && NeighborRow < NumRows && NeighborCol >= 0 && NeighborCol < NumCols)
+			{
+				Mask |= 1 << Neighbor;
+			}
+		}
+		NeighborMasks[Index] = Mask;
+	}
+
+	Generation = 0;
+	VisitedGenerations.Reset();
+	VisitedGenerations.AddZeroed(NumIndices);
+	Stack.SetNumUninitialized(NumIndices * NumNeighbors + 1);
+	Path.Reset(NumIndices);
+	BestPath.Reset(NumIndices);
+	StartCandidates.Reset(NumIndices);
+	Bordering.Init(NumIndices);
+	Dilated.Init(NumIndices);
+}
+
+TConstArrayView<int32> FSpawnAreaFloodFill::FindPath(const FSpawnAreaBitSet& Valid,
+	TConstArrayView<FSpawnAreaBitSet> BorderBlocks, const int32 NumToFind, const FRandomStream& Stream)
+{
+	check(Valid.GetMaxIndex() == NumRows * NumCols);
+
+	// Starting a new generation clears every visited flag, unless it wrapped around
+	if (++Generation == 0)
+	{
+		FMemory::Memzero(VisitedGenerations.GetData(), VisitedGenerations.Num() * sizeof(uint32));
+		Generation = 1;
+	}
+
+	BestPath.Reset();
+	UpdateStartCandidates(Valid, BorderBlocks);
+
+	while (BestPath.Num() < NumToFind && !StartCandidates.IsEmpty())
+	{
+		const int32 CandidateIndex = Stream.RandRange(0, StartCandidates.Num() - 1);
+		const int32 StartNode = StartCandidates[CandidateIndex];
+		StartCandidates.RemoveAtSwap(CandidateIndex, 1, false);
+
+		// Visited flags are kept between start nodes, since starting inside a group that was already searched would
+		// find the same group again
+		if (IsVisited(StartNode)) continue;
+
+		Path.Reset();
+		int32 StackNum = 0;
+		Stack[StackNum++] = StartNode;
+
+		while (StackNum > 0)
+		{
+			const int32 Vertex = Stack[--StackNum];
+			if (IsVisited(Vertex)) continue;
+
+			VisitedGenerations[Vertex] = Generation;
+			Path.Add(Vertex);
+
+			// Exit loop as soon as current path is filled with num to spawn elements
+			if (Path.Num() == NumToFind) break;
+
+			// Gather the valid neighbors that have not been visited
+			int32 Neighbors[NumNeighbors];
+			int32 NumValidNeighbors = 0;
+			uint32 Mask = NeighborMasks[Vertex];
+			while (Mask)
+			{
+				const int32 Neighbor = Vertex + NeighborOffsets[FMath::CountTrailingZeros(Mask)];
+				Mask &= Mask - 1;
+				if (!IsVisited(Neighbor) && Valid.Contains(Neighbor))
+				{
+					Neighbors[NumValidNeighbors++] = Neighbor;
+				}
+			}
+
+			// Push them in a random order
+			for (int32 i = NumValidNeighbors - 1; i > 0; i--)
+			{
+				Swap(Neighbors[i], Neighbors[Stream.RandRange(0, i)]);
+			}
+			for (int32 i = 0; i < NumValidNeighbors; i++)
+			{
+				Stack[StackNum++] = Neighbors[i];
+			}
+		}
+
+		// If not possible to find NumToFind, keep track of best attempt
+		if (Path.Num() > BestPath.Num())
+		{
+			Swap(Path, BestPath);
+		}
+	}
+
+	return BestPath;
+}
+
+void FSpawnAreaFloodFill::UpdateStartCandidates(const FSpawnAreaBitSet& Valid,
+	TConstArrayView<FSpawnAreaBitSet> BorderBlocks)
+{
+	StartCandidates.Reset();
+
+	if (!BorderBlocks.IsEmpty())
+	{
+		Bordering.Reset();
+		for (const FSpawnAreaBitSet& Block : BorderBlocks)
+		{
+			Dilated.Reset();
+			for (const int32 Index : Block)
+			{
+				uint32 Mask = NeighborMasks[Index];
+				while (Mask)
+				{
+					Dilated.Add(Index + NeighborOffsets[FMath::CountTrailingZeros(Mask)]);
+					Mask &= Mask - 1;
+				}
+			}
+			Dilated.DifferenceWith(Block);
+			Bordering.SymmetricDifferenceWith(Dilated);
+		}
+		Bordering.IntersectWith(Valid);
+
+		for (const int32 Index : Bordering)
+		{
+			StartCandidates.Add(Index);
+		}
+	}
+
+	// Fall back to any valid index if nothing borders exactly one block
+	if (StartCandidates.IsEmpty())
+	{
+		for (const int32 Index : Valid)
+		{
+			StartCandidates.Add(Index);
+		}
+	}
+}
@@ -0,0 +1,573 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "Target/SpawnAreaGrid.h"
+#include "GlobalConstants.h"
+
+using namespace Constants;
+
+FSpawnAreaGrid::FSpawnAreaGrid()
+{
+	BottomLeft = FVector(-1.f);
+	NumCols = 0;
+	NumRows = 0;
+	Width = 0.f;
+	Height = 0.f;
+	MinDistanceBetweenTargets = 10.f;
+	Extrema = FExtrema();
+	MaxVertexCol = INDEX_NONE;
+	MaxVertexRow = INDEX_NONE;
+}
+
+void FSpawnAreaGrid::Init(const FVector& InBottomLeft, const int32 InNumCols, const int32 InNumRows,
+	const float InWidth, const float InHeight, const FExtrema& InExtrema, const float InMinDistanceBetweenTargets)
+{
+	BottomLeft = InBottomLeft;
+	NumCols = InNumCols;
+	NumRows = InNumRows;
+	Width = InWidth;
+	Height = InHeight;
+	Extrema = InExtrema;
+	MinDistanceBetweenTargets = InMinDistanceBetweenTargets;
+
+	// Occupied vertices are clipped to those inside the extrema, which excludes the extra row and column of Grid
+	MaxVertexCol = FMath::Min(NumCols - 1,
+		FMath::FloorToInt32((Extrema.Max.Y - Width - BottomLeft.Y) / Width + UE_KINDA_SMALL_NUMBER));
+	MaxVertexRow = FMath::Min(NumRows - 1,
+		FMath::FloorToInt32((Extrema.Max.Z - Height - BottomLeft.Z) / Height + UE_KINDA_SMALL_NUMBER));
+
+	const int32 Size = Num();
+
+	Guids.Init(FGuid(), Size);
+	ChosenPoints.SetNumUninitialized(Size);
+	for (int32 Index = 0; Index < Size; Index++)
+	{
+		ChosenPoints[Index] = GetBottomLeftVertex(Index);
+	}
+	TargetScales.Init(FVector(1.f), Size);
+	TimesSetRecent.Init(DBL_MAX, Size);
+	TotalSpawns.Init(INDEX_NONE, Size);
+	TotalHits.Init(0, Size);
+	TotalTrackingDamagePossible.Init(INDEX_NONE, Size);
+	TotalTrackingDamage.Init(0, Size);
+
+	Managed.Init(Size);
+	Activated.Init(Size);
+	Recent.Init(Size);
+	AllowActivationWhileActivated.Init(Size);
+
+	ActiveCoverage.Init(0, Size);
+	ManagedCoverage.Init(0, Size);
+	StampedLayers.Init(ECoverageLayer::None, Size);
+	StampedKeys.Init(INDEX_NONE, Size);
+	DiskMasks.Empty();
+
+	#if !UE_BUILD_SHIPPING
+	LastOccupiedVerticesTargetScales.Init(FVector(1.f), Size);
+	DebugOccupiedVertices.Empty(Size);
+	DebugOccupiedVertices.SetNum(Size);
+	#endif
+}
+
+void FSpawnAreaGrid::Reset()
+{
+	*this = FSpawnAreaGrid();
+}
+
+FIntRect FSpawnAreaGrid::GetWindowFromExtrema(const FExtrema& InExtrema) const
+{
+	const int32 MinCol = FMath::Max(0,
+		FMath::CeilToInt32((InExtrema.Min.Y - BottomLeft.Y) / Width - UE_KINDA_SMALL_NUMBER));
+	const int32 MaxCol = FMath::Min(NumCols - 1,
+		FMath::CeilToInt32((InExtrema.Max.Y - BottomLeft.Y) / Width - UE_KINDA_SMALL_NUMBER) - 1);
+	const int32 MinRow = FMath::Max(0,
+		FMath::CeilToInt32((InExtrema.Min.Z - BottomLeft.Z) / Height - UE_KINDA_SMALL_NUMBER));
+	const int32 MaxRow = FMath::Min(NumRows - 1,
+		FMath::CeilToInt32((InExtrema.Max.Z - BottomLeft.Z) / Height - UE_KINDA_SMALL_NUMBER) - 1);
+	return FIntRect(MinCol, MinRow, MaxCol, MaxRow);
+}
+
+EGridIndexType FSpawnAreaGrid::GetIndexType(const int32 Index) const
+{
+	const int32 Size = Num();
+	const int32 MaxIndex = Size - 1;
+	const int32 BottomRowFirstIndex = NumCols - 1;
+	const int32 TopRowFirstIndex = Size - NumCols;
+
+	// Only one row
+	if (Size == NumCols)
+	{
+		if (Index == 0)
+		{
+			return EGridIndexType::SingleRowLeft;
+		}
+		if (Index == MaxIndex)
+		{
+			return EGridIndexType::SingleRowRight;
+		}
+		return EGridIndexType::SingleRowMiddle;
+	}
+	if (Index == 0)
+	{
+		return EGridIndexType::BottomLeftCorner;
+	}
+	if (Index == BottomRowFirstIndex)
+	{
+		return EGridIndexType::BottomRightCorner;
+	}
+	if (Index == MaxIndex)
+	{
+		return EGridIndexType::TopRightCorner;
+	}
+	if (Index == TopRowFirstIndex)
+	{
+		return EGridIndexType::TopLeftCorner;
+	}
+	if (Index > 0 && Index < BottomRowFirstIndex)
+	{
+		return EGridIndexType::Bottom;
+	}
+	if ((Index + 1) % NumCols == 0 && Index < MaxIndex)
+	{
+		return EGridIndexType::Right;
+	}
+	if (Index > TopRowFirstIndex && Index < MaxIndex)
+	{
+		return EGridIndexType::Top;
+	}
+	if (Index % NumCols == 0 && Index < TopRowFirstIndex)
+	{
+		return EGridIndexType::Left;
+	}
+
+	return EGridIndexType::Middle;
+}
+
+int32 FSpawnAreaGrid::GetAdjacentIndex(const int32 Index, const EAdjacentDirection Direction) const
+{
+	int32 RowOffset = 0;
+	int32 ColOffset = 0;
+
+	switch (Direction)
+	{
+	case EAdjacentDirection::Left:
+		ColOffset = -1;
+		break;
+	case EAdjacentDirection::Right:
+		ColOffset = 1;
+		break;
+	case EAdjacentDirection::Up:
+		RowOffset = 1;
+		break;
+	case EAdjacentDirection::Down:
+		RowOffset = -1;
+		break;
+	case EAdjacentDirection::UpLeft:
+		RowOffset = 1;
+		ColOffset = -1;
+		break;
+	case EAdjacentDirection::UpRight:
+		RowOffset = 1;
+		ColOffset = 1;
+		break;
+	case EAdjacentDirection::DownLeft:
+		RowOffset = -1;
+		ColOffset = -1;
+		break;
+	case EAdjacentDirection::DownRight:
+		RowOffset = -1;
+		ColOffset = 1;
+		break;
+	case EAdjacentDirection::None:
+		return INDEX_NONE;
+	}
+
+	const int32 Row = GetRow(Index) + RowOffset;
+	const int32 Col = GetCol(Index) + ColOffset;
+
+	if (Row < 0 || Row >= NumRows || Col < 0 || Col >= NumCols)
+	{
+		return INDEX_NONE;
+	}
+	return Row * NumCols + Col;
+}
+
+TArray<int32, TInlineAllocator<8>> FSpawnAreaGrid::GetAdjacentIndices(const int32 Index,
+	const TSet<EAdjacentDirection>& Directions) const
+{
+	TArray<int32, TInlineAllocator<8>> Out;
+	for (const EAdjacentDirection Direction : Directions)
+	{
+		const int32 Adjacent = GetAdjacentIndex(Index, Direction);
+		if (Adjacent != INDEX_NONE)
+		{
+			Out.Add(Adjacent);
+		}
+	}
+	return Out;
+}
+
+bool FSpawnAreaGrid::IsBorderingIndex(const int32 Index, const int32 Other) const
+{
+	if (!IsValidIndex(Index) || !IsValidIndex(Other) || Index == Other)
+	{
+		return false;
+	}
+	return FMath::Abs(GetRow(Index) - GetRow(Other)) <= 1 && FMath::Abs(GetCol(Index) - GetCol(Other)) <= 1;
+}
+
+float FSpawnAreaGrid::CalcTraceRadius(const FVector& InScale) const
+{
+	// Radius can never be less than half the max side dimension
+	const float MinRadius = FMath::Max(Width, Height) * 0.5f;
+
+	// Make Radius a multiple of the Spawn Area width or height
+	const float SnappedRadius = GetDiskMaskKey(InScale) * MinRadius;
+
+	// Multiply by two so that any point outside the sphere will not be overlapping
+	// Square root of two is used to reach the diagonals from the bottom left vertex
+	return SnappedRadius * FMath::Sqrt(2.f) * 2.f;
+}
+
+int32 FSpawnAreaGrid::GetDiskMaskKey(const FVector& InScale) const
+{
+	const float MinRadius = FMath::Max(Width, Height) * 0.5f;
+	return FMath::Max(0, FMath::CeilToInt32(InScale.X * SphereTargetRadius / MinRadius));
+}
+
+const FSpawnAreaDiskMask& FSpawnAreaGrid::GetDiskMask(const int32 Key) const
+{
+	if (Key >= DiskMasks.Num())
+	{
+		DiskMasks.SetNum(Key + 1);
+	}
+
+	FSpawnAreaDiskMask& Mask = DiskMasks[Key];
+	if (Mask.IsValid())
+	{
+		return Mask;
+	}
+
+	const float Radius = Key * FMath::Max(Width, Height) * 0.5f * FMath::Sqrt(2.f) * 2.f;
+
+	// Matches FSphere::IsInside
+	const float RadiusSquared = FMath::Square(Radius - UE_KINDA_SMALL_NUMBER);
+
+	const int32 IncY = FMath::FloorToInt32(Radius / Width);
+	const int32 IncZ = FMath::FloorToInt32(Radius / Height);
+
+	Mask.HalfHeight = IncZ;
+	Mask.MaxHalfWidth = IncY;
+	Mask.HalfWidths.SetNumUninitialized(IncZ * 2 + 1);
+
+	// Each row of a disk is contiguous, so only the outermost column inside the disk needs to be found
+	for (int32 Row = -IncZ; Row <= IncZ; Row++)
+	{
+		const float RowDistSquared = FMath::Square(Row * Height);
+		int32 HalfWidth = IncY;
+		while (HalfWidth > 0 && FMath::Square(HalfWidth * Width) + RowDistSquared > RadiusSquared)
+		{
+			HalfWidth--;
+		}
+		Mask.HalfWidths[Row + IncZ] = HalfWidth;
+	}
+
+	return Mask;
+}
+
+void FSpawnAreaGrid::StampCoverage(TArray<uint16>& Coverage, const int32 Index, const int32 Key, const bool bAdd)
+{
+	const FSpawnAreaDiskMask& Mask = GetDiskMask(Key);
+	const int32 CenterRow = GetRow(Index);
+	const int32 CenterCol = GetCol(Index);
+	const int32 MinRow = FMath::Max(0, CenterRow - Mask.HalfHeight);
+	const int32 MaxRow = FMath::Min(MaxVertexRow, CenterRow + Mask.HalfHeight);
+
+	for (int32 Row = MinRow; Row <= MaxRow; Row++)
+	{
+		const int32 HalfWidth = Mask.HalfWidths[Row - CenterRow + Mask.HalfHeight];
+		const int32 MinCol = FMath::Max(0, CenterCol - HalfWidth);
+		const int32 MaxCol = FMath::Min(MaxVertexCol, CenterCol + HalfWidth);
+
+		uint16* RowCoverage = Coverage.GetData() + Row * NumCols;
+		for (int32 Col = MinCol; Col <= MaxCol; Col++)
+		{
+			if (bAdd)
+			{
+				++RowCoverage[Col];
+			}
+			else
+			{
+				checkSlow(RowCoverage[Col] > 0);
+				--RowCoverage[Col];
+			}
+		}
+	}
+}
+
+void FSpawnAreaGrid::UpdateCoverage(const int32 Index)
+{
+	ECoverageLayer Layer = ECoverageLayer::None;
+	if (Activated.Contains(Index) || Recent.Contains(Index))
+	{
+		Layer = ECoverageLayer::Active;
+	}
+	else if (Managed.Contains(Index))
+	{
+		Layer = ECoverageLayer::Managed;
+	}
+
+	const int32 Key = Layer == ECoverageLayer::None ? INDEX_NONE : GetDiskMaskKey(TargetScales[Index]);
+	if (Layer == StampedLayers[Index] && Key == StampedKeys[Index])
+	{
+		return;
+	}
+
+	if (StampedLayers[Index] != ECoverageLayer::None)
+	{
+		StampCoverage(GetCoverage(StampedLayers[Index]), Index, StampedKeys[Index], false);
+	}
+	if (Layer != ECoverageLayer::None)
+	{
+		StampCoverage(GetCoverage(Layer), Index, Key, true);
+	}
+
+	StampedLayers[Index] = Layer;
+	StampedKeys[Index] = Key;
+}
+
+void FSpawnAreaGrid::FindCoveredSpawnAreas(const FSpawnAreaBitSet& InOccupying, const FVector& InMinScale,
+	const bool bIncludeManaged, FSpawnAreaBitSet& OutCovered)
+{
+	struct FTempStamp
+	{
+		int32 Index;
+		int32 Key;
+		ECoverageLayer Layer;
+		bool bAdd;
+	};
+	TArray<FTempStamp, TInlineAllocator<16>> TempStamps;
+
+	auto ApplyTempStamp = [this, &TempStamps](const int32 Index, const int32 Key, const ECoverageLayer Layer,
+		const bool bAdd)
+	{
+		StampCoverage(GetCoverage(Layer), Index, Key, bAdd);
+		TempStamps.Add({Index, Key, Layer, bAdd});
+	};
+
+	auto IsLayerIncluded = [bIncludeManaged](const ECoverageLayer Layer)
+	{
+		return Layer == ECoverageLayer::Active || (bIncludeManaged && Layer == ECoverageLayer::Managed);
+	};
+
+	// Unstamp any stamped Spawn Areas that were not requested
+	FSpawnAreaBitSet Excluded = Managed.Union(Activated);
+	Excluded.UnionWith(Recent);
+	Excluded.DifferenceWith(InOccupying);
+	for (const int32 Index : Excluded)
+	{
+		if (IsLayerIncluded(StampedLayers[Index]))
+		{
+			ApplyTempStamp(Index, StampedKeys[Index], StampedLayers[Index], false);
+		}
+	}
+
+	// Stamp any requested Spawn Areas that are not stamped, or need a larger radius than they are stamped with
+	const int32 MinKey = GetDiskMaskKey(InMinScale);
+	for (const int32 Index : InOccupying)
+	{
+		const int32 Key = FMath::Max(GetDiskMaskKey(TargetScales[Index]), MinKey);
+		if (IsLayerIncluded(StampedLayers[Index]) && StampedKeys[Index] >= Key)
+		{
+			continue;
+		}
+		ApplyTempStamp(Index, Key, ECoverageLayer::Active, true);
+	}
+
+	OutCovered.Init(Num());
+	for (int32 Index = 0; Index < Num(); Index++)
+	{
+		if (ActiveCoverage[Index] > 0 || (bIncludeManaged && ManagedCoverage[Index] > 0))
+		{
+			OutCovered.Add(Index);
+		}
+	}
+
+	// Revert the temporary stamps
+	for (int32 i = TempStamps.Num() - 1; i >= 0; i--)
+	{
+		const FTempStamp& Stamp = TempStamps[i];
+		StampCoverage(GetCoverage(Stamp.Layer), Stamp.Index, Stamp.Key, !Stamp.bAdd);
+	}
+}
+
+TSet<FVector> FSpawnAreaGrid::MakeVerticesBase(const int32 Index, const FVector& InScale, const bool bOccupied) const
+{
+	const FSpawnAreaDiskMask& Mask = GetDiskMask(GetDiskMaskKey(InScale));
+	const int32 CenterRow = GetRow(Index);
+	const int32 CenterCol = GetCol(Index);
+	const int32 MinRow = FMath::Max(0, CenterRow - Mask.HalfHeight);
+	const int32 MaxRow = FMath::Min(MaxVertexRow, CenterRow + Mask.HalfHeight);
+	const int32 MinSquareCol = FMath::Max(0, CenterCol - Mask.MaxHalfWidth);
+	const int32 MaxSquareCol = FMath::Min(MaxVertexCol, CenterCol + Mask.MaxHalfWidth);
+
+	TSet<FVector> Out;
+	Out.Reserve((MaxRow - MinRow + 1) * (MaxSquareCol - MinSquareCol + 1));
+
+	for (int32 Row = MinRow; Row <= MaxRow; Row++)
+	{
+		const int32 HalfWidth = Mask.HalfWidths[Row - CenterRow + Mask.HalfHeight];
+		const int32 MinCol = FMath::Max(0, CenterCol - HalfWidth);
+		const int32 MaxCol = FMath::Min(MaxVertexCol, CenterCol + HalfWidth);
+
+		for (int32 Col = MinSquareCol; Col <= MaxSquareCol; Col++)
+		{
+			if ((Col >= MinCol && Col <= MaxCol) == bOccupied)
+			{
+				Out.Add(GetBottomLeftVertex(Row * NumCols + Col));
+			}
+		}
+	}
+
+	return Out;
+}
+
+TSet<FVector> FSpawnAreaGrid::MakeOccupiedVertices(const int32 Index, const FVector& InScale) const
+{
+	return MakeVerticesBase(Index, InScale, true);
+}
+
+TSet<FVector> FSpawnAreaGrid::MakeUnoccupiedVertices(const int32 Index, const FVector& InScale) const
+{
+	return MakeVerticesBase(Index, InScale, false);
+}
+
+FVector FSpawnAreaGrid::GenerateRandomOffset(const FRandomStream& Stream) const
+{
+	#if !UE_BUILD_SHIPPING
+	if (GIsAutomationTesting)
+	{
+		const int32 RandomNum = Stream.RandRange(0, 3);
+		if (RandomNum == 0)
+		{
+			return FVector(0.f, 0.f, 0.f);
+		}
+		if (RandomNum == 1)
+		{
+			return FVector(0.f, Width - 1.f, 0.f);
+		}
+		if (RandomNum == 2)
+		{
+			return FVector(0.f, 0.f, Height - 1.f);
+		}
+		if (RandomNum == 3)
+		{
+			return FVector(0.f, Width - 1.f, Height - 1.f);
+		}
+	}
+	#endif
+
+	const float Y = roundf(Stream.FRandRange(0.f, Width - 1.f));
+	const float Z = roundf(Stream.FRandRange(0.f, Height - 1.f));
+	return FVector(0.f, Y, Z);
+}
+
+void FSpawnAreaGrid::SetChosenPoint(const int32 Index, const FVector& InOffset)
+{
+	ChosenPoints[Index] = GetBottomLeftVertex(Index) + InOffset;
+}
+
+void FSpawnAreaGrid::SetTargetScale(const int32 Index, const FVector& InScale)
+{
+	TargetScales[Index] = InScale;
+	UpdateCoverage(Index);
+}
+
+void FSpawnAreaGrid::SetIsManaged(const int32 Index, const bool bManaged)
+{
+	if (bManaged)
+	{
+		Managed.Add(Index);
+	}
+	else
+	{
+		Managed.Remove(Index);
+		#if !UE_BUILD_SHIPPING
+		DebugOccupiedVertices[Index].Empty();
+		#endif
+	}
+
+	UpdateCoverage(Index);
+}
+
+void FSpawnAreaGrid::SetIsActivated(const int32 Index, const bool bActivated, const bool bAllow)
+{
+	if (bActivated)
+	{
+		Activated.Add(Index);
+	}
+	else
+	{
+		Activated.Remove(Index);
+	}
+
+	if (bAllow)
+	{
+		AllowActivationWhileActivated.Add(Index);
+	}
+	else
+	{
+		AllowActivationWhileActivated.Remove(Index);
+	}
+
+	UpdateCoverage(Index);
+}
+
+void FSpawnAreaGrid::SetIsRecent(const int32 Index, const bool bRecent)
+{
+	if (bRecent)
+	{
+		Recent.Add(Index);
+		TimesSetRecent[Index] = FPlatformTime::Seconds();
+	}
+	else
+	{
+		Recent.Remove(Index);
+		TimesSetRecent[Index] = DBL_MAX;
+	}
+
+	UpdateCoverage(Index);
+}
+
+void FSpawnAreaGrid::IncrementTotalSpawns(const int32 Index)
+{
+	TotalSpawns[Index] = TotalSpawns[Index] == INDEX_NONE ? 1 : TotalSpawns[Index] + 1;
+}
+
+void FSpawnAreaGrid::IncrementTotalHits(const int32 Index)
+{
+	TotalHits[Index]++;
+}
+
+void FSpawnAreaGrid::IncrementTotalTrackingDamagePossible(const int32 Index)
+{
+	TotalTrackingDamagePossible[Index] = TotalTrackingDamagePossible[Index] == INDEX_NONE
+		? 1
+		: TotalTrackingDamagePossible[Index] + 1;
+}
+
+void FSpawnAreaGrid::IncrementTotalTrackingDamage(const int32 Index)
+{
+	TotalTrackingDamage[Index]++;
+}
+
+#if !UE_BUILD_SHIPPING
+
+const TSet<FVector>& FSpawnAreaGrid::SetMakeDebugOccupiedVertices(const int32 Index, const FVector& InScale)
+{
+	DebugOccupiedVertices[Index] = MakeOccupiedVertices(Index, InScale);
+	LastOccupiedVerticesTargetScales[Index] = InScale;
+	return DebugOccupiedVertices[Index];
+}
+
+#endif
@@ -5,57 +5,10 @@
 #include "Target/Target.h"
 #include "Target/MatrixFunctions.h"
 #include "Target/SpawnArea.h"
-#include "Algo/RandomShuffle.h"
-#include <stack>
 #if !UE_BUILD_SHIPPING
 #include "Target/TargetManager.h"
 #endif
 
-void FRectCandidate::MergeSubRectangles()
-{
-	if (SubRectangles.IsEmpty()) return;
-
-	TArray<FSubRectangle> SortedSubRectangles = SubRectangles.Array();
-	SortedSubRectangles.Sort();
-
-	if (SubRectangles.Num() > 1)
-	{
-		TArray<FSubRectangle> FilteredArray;
-		int CurrentIndex = 1;
-		FIndexPair LastStartEndIndex = SortedSubRectangles[0].BoundingIndices;
-
-		if (LastStartEndIndex.EndIndex != SortedSubRectangles[1].BoundingIndices.EndIndex)
-		{
-			FilteredArray.Add(SortedSubRectangles[0]);
-		}
-
-		while (CurrentIndex < SortedSubRectangles.Num())
-		{
-			const FIndexPair CurrentStartEndIndex = SortedSubRectangles[CurrentIndex].BoundingIndices;
-			if (LastStartEndIndex.EndIndex == CurrentStartEndIndex.EndIndex)
-			{
-				if (CurrentStartEndIndex.StartIndex != (LastStartEndIndex.StartIndex + 1))
-				{
-					FilteredArray.Add(SortedSubRectangles[CurrentIndex]);
-				}
-			}
-			else
-			{
-				FilteredArray.Add(SortedSubRectangles[CurrentIndex]);
-			}
-			LastStartEndIndex = CurrentStartEndIndex;
-			CurrentIndex += 1;
-		}
-
-		if (!FilteredArray.IsEmpty())
-		{
-			SortedSubRectangles = MoveTemp(FilteredArray);
-		}
-	}
-
-	SubRectangles = TSet<FSubRectangle, FFSubRectangleKeyFuncs>(MoveTemp(SortedSubRectangles));
-}
-
 USpawnAreaManagerComponent::USpawnAreaManagerComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
@@ -82,17 +35,17 @@ USpawnAreaManagerComponent::USpawnAreaManagerComponent()
 	StaticExtents = FVector();
 	StaticExtrema = FExtrema();
 
-	SpawnAreas = TSet<USpawnArea*>();
-	AreaKeyMap = TMap<FAreaKey, USpawnArea*>();
-	GuidMap = TMap<FGuid, USpawnArea*>();
-	CachedExtrema = TSet<USpawnArea*>();
-	CachedManaged = TSet<USpawnArea*>();
-	CachedActivated = TSet<USpawnArea*>();
-	CachedRecent = TSet<USpawnArea*>();
-	RecentGridBlocks = TArray<TSet<USpawnArea*>>();
-
-	MostRecentSpawnArea = nullptr;
-	OriginSpawnArea = nullptr;
+	SpawnAreas = FSpawnAreaGrid();
+	GuidMap = TMap<FGuid, int32>();
+	CachedExtrema = FSpawnAreaBitSet();
+	CachedExtremaWindow = FIntRect();
+	RecentGridBlocks = TArray<FSpawnAreaBitSet>();
+	RectangleFinder = FLargestRectangleFinder();
+	FloodFill = FSpawnAreaFloodFill();
+
+	MostRecentSpawnAreaIndex = INDEX_NONE;
+	OriginSpawnAreaIndex = INDEX_NONE;
+	bHasFixedRandomSeed = false;
 }
 
 void USpawnAreaManagerComponent::DestroyComponent(bool bPromoteChildren)
@@ -114,7 +67,7 @@ FIntVector3 USpawnAreaManagerComponent::Init(const TSharedPtr<FBSConfig>& InConf
 	SetSpawnAreaDimensions();
 	InitializeSpawnAreas();
 
-	OriginSpawnArea = GetSpawnArea(Origin);
+	OriginSpawnAreaIndex = GetSpawnAreaIndex(Origin);
 
 	#if !UE_BUILD_SHIPPING
 	if (!GIsAutomationTesting)
@@ -125,8 +78,7 @@ FIntVector3 USpawnAreaManagerComponent::Init(const TSharedPtr<FBSConfig>& InConf
 			*StaticExtrema.Max.ToString());
 		UE_LOG(LogTargetManager, Display, TEXT("SpawnAreaInc: Y: %d Z: %d"), SpawnAreaDimensions.Y,
 			SpawnAreaDimensions.Z);
-		UE_LOG(LogTargetManager, Display, TEXT("Num Spawn Areas: %d Allocated Size: %llu"), SpawnAreas.Num(),
-			SpawnAreas.GetAllocatedSize());
+		UE_LOG(LogTargetManager, Display, TEXT("Num Spawn Areas: %d"), SpawnAreas.Num());
 	}
 	#endif
 
@@ -197,10 +149,6 @@ void USpawnAreaManagerComponent::SetSpawnAreaDimensions()
 
 void USpawnAreaManagerComponent::InitializeSpawnAreas()
 {
-	int SizeY = 0;
-	int SizeZ = 0;
-	int Index = 0;
-
 	// Add an extra row and column if using grid
 	const bool bGrid = TargetConfig().TargetDistributionPolicy == ETargetDistributionPolicy::Grid;
 
@@ -216,43 +164,60 @@ void USpawnAreaManagerComponent::InitializeSpawnAreas()
 	TotalSpawnAreaSize.Z = FMath::CeilToInt32(TotalHeight / SpawnAreaDimensions.Z);
 	const int32 TotalSize = TotalSpawnAreaSize.Y * TotalSpawnAreaSize.Z;
 
-	USpawnArea::SetWidth(SpawnAreaDimensions.Y);
-	USpawnArea::SetHeight(SpawnAreaDimensions.Z);
-	USpawnArea::SetTotalNumHorizontalSpawnAreas(TotalSpawnAreaSize.Y);
-	USpawnArea::SetTotalNumVerticalSpawnAreas(TotalSpawnAreaSize.Z);
-	USpawnArea::SetSize(TotalSize);
-	USpawnArea::SetMinDistanceBetweenTargets(TargetConfig().MinDistanceBetweenTargets);
-	USpawnArea::SetTotalSpawnAreaExtrema(StaticExtrema);
+	SpawnAreas.Init(FVector(Origin.X, MinY, MinZ), TotalSpawnAreaSize.Y, TotalSpawnAreaSize.Z, SpawnAreaDimensions.Y,
+		SpawnAreaDimensions.Z, StaticExtrema, TargetConfig().MinDistanceBetweenTargets);
 
-	SpawnAreas.Reserve(TotalSize);
-	AreaKeyMap.Reserve(TotalSize);
+	CachedExtrema.Init(TotalSize, true);
+	CachedExtremaWindow = FIntRect(0, 0, TotalSpawnAreaSize.Y - 1, TotalSpawnAreaSize.Z - 1);
+	RectangleFinder.Init(TotalSpawnAreaSize.Z, TotalSpawnAreaSize.Y);
+	FloodFill.Init(TotalSpawnAreaSize.Z, TotalSpawnAreaSize.Y);
+	if (!bHasFixedRandomSeed)
+	{
+		RandomStream.GenerateNewSeed();
+	}
+}
 
-	for (float Z = MinZ; Z < MaxZ; Z += SpawnAreaDimensions.Z)
+void USpawnAreaManagerComponent::UpdateCachedExtremaWindow(const FIntRect& NewWindow)
+{
+	auto SetRowSegment = [this](const int32 Row, const int32 MinCol, const int32 MaxCol, const bool bValue)
 	{
-		SizeY = 0;
-		for (float Y = MinY; Y < MaxY; Y += SpawnAreaDimensions.Y)
+		if (MaxCol >= MinCol)
 		{
-			const FVector Loc(Origin.X, Y, Z);
-			const FSetElementId ID = SpawnAreas.Emplace(NewObject<USpawnArea>());
-
-			SpawnAreas[ID]->Init(Index, Loc);
-			AreaKeyMap.Add(FAreaKey(Loc, SpawnAreaDimensions), SpawnAreas[ID]);
+			CachedExtrema.SetRange(SpawnAreas.GetIndex(Row, MinCol), MaxCol - MinCol + 1, bValue);
+		}
+	};
 
-			Index++;
-			SizeY++;
+	// Sets the segments of each row of From that are not inside To
+	auto SetStrips = [&SetRowSegment](const FIntRect& From, const FIntRect& To, const bool bValue)
+	{
+		for (int32 Row = From.Min.Y; Row <= From.Max.Y; Row++)
+		{
+			if (Row < To.Min.Y || Row > To.Max.Y || To.Max.X < To.Min.X)
+			{
+				SetRowSegment(Row, From.Min.X, From.Max.X, bValue);
+			}
+			else
+			{
+				SetRowSegment(Row, From.Min.X, FMath::Min(From.Max.X, To.Min.X - 1), bValue);
+				SetRowSegment(Row, FMath::Max(From.Min.X, To.Max.X + 1), From.Max.X, bValue);
+			}
 		}
-		SizeZ++;
-	}
+	};
 
-	ensure(TotalSpawnAreaSize.Y == SizeY);
-	ensure(TotalSpawnAreaSize.Z == SizeZ);
+	// Remove strips leaving the window, then add strips entering it
+	SetStrips(CachedExtremaWindow, NewWindow, false);
+	SetStrips(NewWindow, CachedExtremaWindow, true);
 
-	CachedExtrema = SpawnAreas;
+	CachedExtremaWindow = NewWindow;
 }
 
 void USpawnAreaManagerComponent::Clear()
 {
-	GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
+	// May not have a world if used outside of a TargetManager, e.g. by the RL trainer
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearAllTimersForObject(this);
+	}
 	BSConfig.Reset();
 
 	TotalSpawnAreaSize = FIntVector3();
@@ -261,55 +226,56 @@ void USpawnAreaManagerComponent::Clear()
 	StaticExtents = FVector();
 	StaticExtrema = FExtrema();
 
-	SpawnAreas.Empty();
-	AreaKeyMap.Empty();
+	SpawnAreas.Reset();
 	GuidMap.Empty();
 	CachedExtrema.Empty();
-	CachedManaged.Empty();
-	CachedActivated.Empty();
-	CachedRecent.Empty();
-	RecentGridBlocks = TArray<TSet<USpawnArea*>>();
+	CachedExtremaWindow = FIntRect();
+	RecentGridBlocks = TArray<FSpawnAreaBitSet>();
+	RectangleFinder = FLargestRectangleFinder();
+	FloodFill = FSpawnAreaFloodFill();
 
-	MostRecentSpawnArea = nullptr;
-	OriginSpawnArea = nullptr;
+	MostRecentSpawnAreaIndex = INDEX_NONE;
+	OriginSpawnAreaIndex = INDEX_NONE;
 
 	RequestRLCSpawnArea.Unbind();
 
 	#if !UE_BUILD_SHIPPING
-	FlushPersistentDebugLines(GetWorld());
+	if (GetWorld())
+	{
+		FlushPersistentDebugLines(GetWorld());
+	}
 	#endif
 }
 
-bool USpawnAreaManagerComponent::ShouldConsiderManagedAsInvalid() const
+void USpawnAreaManagerComponent::SetRandomSeed(const int32 Seed)
 {
-	return TargetConfig().TargetSpawningPolicy == ETargetSpawningPolicy::RuntimeOnly;
+	RandomStream.Initialize(Seed);
+	bHasFixedRandomSeed = true;
 }
 
-int32 USpawnAreaManagerComponent::GetMostRecentSpawnAreaIndex() const
+bool USpawnAreaManagerComponent::ShouldConsiderManagedAsInvalid() const
 {
-	if (!MostRecentSpawnArea) return -1;
-	return MostRecentSpawnArea->GetIndex();
+	return TargetConfig().TargetSpawningPolicy == ETargetSpawningPolicy::RuntimeOnly;
 }
 
-int32 USpawnAreaManagerComponent::GetSpawnAreaIndex(const FGuid& TargetGuid) const
+int32 USpawnAreaManagerComponent::GetMostRecentSpawnAreaIndex() const
 {
-	const USpawnArea* SpawnArea = GetSpawnArea(TargetGuid);
-	if (!SpawnArea) return -1;
-	return SpawnArea->GetIndex();
+	return MostRecentSpawnAreaIndex;
 }
 
 void USpawnAreaManagerComponent::UpdateTotalTrackingDamagePossible(const FVector& InLocation) const
 {
-	if (USpawnArea* SpawnArea = GetSpawnArea(InLocation))
+	const int32 Index = GetSpawnAreaIndex(InLocation);
+	if (IsSpawnAreaValid(Index))
 	{
-		SpawnArea->IncrementTotalTrackingDamagePossible();
+		SpawnAreas.IncrementTotalTrackingDamagePossible(Index);
 	}
 }
 
 void USpawnAreaManagerComponent::HandleTargetDamageEvent(const FTargetDamageEvent& DamageEvent)
 {
-	USpawnArea* SpawnArea = GetSpawnArea(DamageEvent.Guid);
-	if (!SpawnArea)
+	const int32 Index = GetSpawnAreaIndex(DamageEvent.Guid);
+	if (!IsSpawnAreaValid(Index))
 	{
 		#if !UE_BUILD_SHIPPING
 		UE_LOG(LogTargetManager, Warning, TEXT("Could not find SpawnArea from DamageEvent Guid."));
@@ -322,8 +288,8 @@ void USpawnAreaManagerComponent::HandleTargetDamageEvent(const FTargetDamageEven
 	case ETargetDamageType::Tracking:
 		{
 			// Instead of using the spawn area where the target started, use the current location
-			USpawnArea* SpawnAreaByLoc = GetSpawnArea(DamageEvent.Transform.GetLocation());
-			if (!SpawnAreaByLoc)
+			const int32 IndexByLoc = GetSpawnAreaIndex(DamageEvent.Transform.GetLocation());
+			if (!IsSpawnAreaValid(IndexByLoc))
 			{
 				#if !UE_BUILD_SHIPPING
 				UE_LOG(LogTargetManager, Warning, TEXT("Could not find SpawnArea from Transform: %s."),
@@ -335,17 +301,19 @@ void USpawnAreaManagerComponent::HandleTargetDamageEvent(const FTargetDamageEven
 			// Total Tracking Damage Possible is done on tick in UpdateTotalTrackingDamagePossible
 
 			// Only increment total tracking damage if damage came from player
-			if (!DamageEvent.bDamagedSelf && DamageEvent.DamageDelta > 0.f) SpawnAreaByLoc->
-				IncrementTotalTrackingDamage();
+			if (!DamageEvent.bDamagedSelf && DamageEvent.DamageDelta > 0.f)
+			{
+				SpawnAreas.IncrementTotalTrackingDamage(IndexByLoc);
+			}
 		}
 		break;
 	case ETargetDamageType::Hit:
 		{
 			// Always increment total spawns for Hit Damage Events
-			SpawnArea->IncrementTotalSpawns();
+			SpawnAreas.IncrementTotalSpawns(Index);
 
 			// Only increment total hits if damage came from player
-			if (!DamageEvent.bDamagedSelf && DamageEvent.DamageDelta > 0.f) SpawnArea->IncrementTotalHits();
+			if (!DamageEvent.bDamagedSelf && DamageEvent.DamageDelta > 0.f) SpawnAreas.IncrementTotalHits(Index);
 		}
 		break;
 	case ETargetDamageType::Self:
@@ -353,7 +321,7 @@ void USpawnAreaManagerComponent::HandleTargetDamageEvent(const FTargetDamageEven
 			if (DamageEvent.VulnerableToDamageTypes.Contains(ETargetDamageType::Hit))
 			{
 				// Always increment total spawns for Hit Damage Events
-				SpawnArea->IncrementTotalSpawns();
+				SpawnAreas.IncrementTotalSpawns(Index);
 			}
 			if (DamageEvent.VulnerableToDamageTypes.Contains(ETargetDamageType::Tracking))
 			{
@@ -374,8 +342,8 @@ void USpawnAreaManagerComponent::HandleTargetDamageEvent(const FTargetDamageEven
 	// Applies to any damage type
 	if (DamageEvent.bWillDeactivate || DamageEvent.bWillDestroy)
 	{
-		RemoveActivatedFlagFromSpawnArea(SpawnArea);
-		FlagSpawnAreaAsRecent(SpawnArea);
+		RemoveActivatedFlagFromSpawnArea(Index);
+		FlagSpawnAreaAsRecent(Index);
 	}
 
 	if (DamageEvent.bWillDestroy)
@@ -393,57 +361,30 @@ void USpawnAreaManagerComponent::OnExtremaChanged(const FExtrema& Extrema)
 		return;
 	case ETargetDistributionPolicy::EdgeOnly:
 		{
-			const float MaxY = Extrema.Max.Y - SpawnAreaDimensions.Y;
-			const float MaxZ = Extrema.Max.Z - SpawnAreaDimensions.Z;
+			const int32 MinCol = SpawnAreas.GetColFromY(Extrema.Min.Y);
+			const int32 MaxCol = SpawnAreas.GetColFromY(Extrema.Max.Y - SpawnAreaDimensions.Y);
+			const int32 MinRow = SpawnAreas.GetRowFromZ(Extrema.Min.Z);
+			const int32 MaxRow = SpawnAreas.GetRowFromZ(Extrema.Max.Z - SpawnAreaDimensions.Z);
 
-			const float MinY = Extrema.Min.Y;
-			const float MinZ = Extrema.Min.Z;
+			CachedExtrema.Reset();
 
-			TSet<USpawnArea*> Temp;
-
-			for (float Y = MinY; Y <= MaxY; Y += SpawnAreaDimensions.Y)
+			for (int32 Col = MinCol; Col <= MaxCol; Col++)
 			{
-				if (USpawnArea* SpawnArea_MinZ = GetSpawnArea(FVector(0, Y, MinZ)))
-				{
-					Temp.Add(SpawnArea_MinZ);
-				}
-				if (USpawnArea* SpawnArea_MaxZ = GetSpawnArea(FVector(0, Y, MaxZ)))
-				{
-					Temp.Add(SpawnArea_MaxZ);
-				}
+				CachedExtrema.Add(SpawnAreas.GetIndex(MinRow, Col));
+				CachedExtrema.Add(SpawnAreas.GetIndex(MaxRow, Col));
 			}
 
-			for (float Z = MinZ; Z <= MaxZ; Z += SpawnAreaDimensions.Z)
+			for (int32 Row = MinRow; Row <= MaxRow; Row++)
 			{
-				if (USpawnArea* SpawnArea_MinY = GetSpawnArea(FVector(0, MinY, Z)))
-				{
-					Temp.Add(SpawnArea_MinY);
-				}
-				if (USpawnArea* SpawnArea_MaxY = GetSpawnArea(FVector(0, MaxY, Z)))
-				{
-					Temp.Add(SpawnArea_MaxY);
-				}
+				CachedExtrema.Add(SpawnAreas.GetIndex(Row, MinCol));
+				CachedExtrema.Add(SpawnAreas.GetIndex(Row, MaxCol));
 			}
-
-			CachedExtrema = MoveTemp(Temp);
 		}
 		break;
 	case ETargetDistributionPolicy::HeadshotHeightOnly:
 	case ETargetDistributionPolicy::FullRange:
 		{
-			for (USpawnArea* SpawnArea : SpawnAreas)
-			{
-				const FVector Location = SpawnArea->GetBottomLeftVertex();
-				if (Location.Y < Extrema.Min.Y || Location.Y >= Extrema.Max.Y || Location.Z < Extrema.Min.Z || Location.
-					Z >= Extrema.Max.Z)
-				{
-					CachedExtrema.Remove(SpawnArea);
-				}
-				else
-				{
-					CachedExtrema.Add(SpawnArea);
-				}
-			}
+			UpdateCachedExtremaWindow(SpawnAreas.GetWindowFromExtrema(Extrema));
 		}
 		break;
 	}
@@ -453,121 +394,74 @@ void USpawnAreaManagerComponent::OnExtremaChanged(const FExtrema& Extrema)
 /* -- SpawnArea finders/getters -- */
 /* ------------------------------- */
 
-USpawnArea* USpawnAreaManagerComponent::GetSpawnArea(const int32 Index) const
-{
-	return IsSpawnAreaValid(Index) ? SpawnAreas[FSetElementId::FromInteger(Index)] : nullptr;
-}
-
-USpawnArea* USpawnAreaManagerComponent::GetSpawnArea(const FVector& InLocation) const
+int32 USpawnAreaManagerComponent::GetSpawnAreaIndex(const FVector& InLocation) const
 {
-	// Adjust for the SpawnAreaInc being aligned to the BoxBounds Origin
-	const FVector RelativeLocation = InLocation - Origin;
-
-	// Snap to lowest SpawnAreaInc (49.9 -> 0 if SpawnAreaInc value is 50)
-	int32 GridY = Origin.Y + SpawnAreaDimensions.Y * FMath::FloorToInt(RelativeLocation.Y / SpawnAreaDimensions.Y);
-	int32 GridZ = Origin.Z + SpawnAreaDimensions.Z * FMath::FloorToInt(RelativeLocation.Z / SpawnAreaDimensions.Z);
-
-	GridY = FMath::Clamp(GridY, StaticExtrema.Min.Y, StaticExtrema.Max.Y - SpawnAreaDimensions.Y);
-	GridZ = FMath::Clamp(GridZ, StaticExtrema.Min.Z, StaticExtrema.Max.Z - SpawnAreaDimensions.Z);
-
-	const auto Found = AreaKeyMap.Find(FAreaKey(FVector(0, GridY, GridZ), SpawnAreaDimensions));
-	return Found ? *Found : nullptr;
+	return SpawnAreas.GetIndexFromLocation(InLocation);
 }
 
-USpawnArea* USpawnAreaManagerComponent::GetSpawnArea(const FGuid& TargetGuid) const
+int32 USpawnAreaManagerComponent::GetSpawnAreaIndex(const FGuid& TargetGuid) const
 {
-	const auto Found = GuidMap.Find(TargetGuid);
-	return Found ? *Found : nullptr;
+	const int32* Found = GuidMap.Find(TargetGuid);
+	return Found ? *Found : INDEX_NONE;
 }
 
-USpawnArea* USpawnAreaManagerComponent::GetOldestRecentSpawnArea() const
+int32 USpawnAreaManagerComponent::GetOldestRecentSpawnAreaIndex() const
 {
-	TSet<USpawnArea*>&& RecentSpawnAreas = GetRecentSpawnAreas();
-
-	if (RecentSpawnAreas.IsEmpty())
-	{
-		return nullptr;
-	}
-
-	USpawnArea* MostRecent = nullptr;
+	int32 Oldest = INDEX_NONE;
 
-	for (USpawnArea* SpawnArea : RecentSpawnAreas)
+	for (const int32 Index : GetRecentSpawnAreas())
 	{
-		if (!MostRecent)
+		if (Oldest == INDEX_NONE || SpawnAreas.TimesSetRecent[Index] < SpawnAreas.TimesSetRecent[Oldest])
 		{
-			MostRecent = SpawnArea;
-			continue;
-		}
-		if (SpawnArea->GetTimeSetRecent() < MostRecent->GetTimeSetRecent())
-		{
-			MostRecent = SpawnArea;
+			Oldest = Index;
 		}
 	}
-	return MostRecent;
+	return Oldest;
 }
 
-USpawnArea* USpawnAreaManagerComponent::GetOldestDeactivatedSpawnArea() const
+int32 USpawnAreaManagerComponent::GetOldestDeactivatedSpawnAreaIndex() const
 {
-	USpawnArea* MostRecent = nullptr;
+	int32 Oldest = INDEX_NONE;
 
-	for (USpawnArea* SpawnArea : GetDeactivatedSpawnAreas())
+	for (const int32 Index : GetDeactivatedSpawnAreas())
 	{
-		if (!MostRecent)
-		{
-			MostRecent = SpawnArea;
-			continue;
-		}
-		if (SpawnArea->GetTimeSetRecent() < MostRecent->GetTimeSetRecent())
+		if (Oldest == INDEX_NONE || SpawnAreas.TimesSetRecent[Index] < SpawnAreas.TimesSetRecent[Oldest])
 		{
-			MostRecent = SpawnArea;
+			Oldest = Index;
 		}
 	}
-	return MostRecent;
-}
-
-bool USpawnAreaManagerComponent::IsSpawnAreaValid(const int32 InIndex) const
-{
-	return InIndex >= 0 && InIndex < SpawnAreas.Num();
-}
-
-TSet<USpawnArea*> USpawnAreaManagerComponent::GetManagedSpawnAreas() const
-{
-	return CachedManaged;
-}
-
-TSet<USpawnArea*> USpawnAreaManagerComponent::GetDeactivatedSpawnAreas() const
-{
-	return CachedManaged.Difference(CachedActivated);
+	return Oldest;
 }
 
-TSet<USpawnArea*> USpawnAreaManagerComponent::GetRecentSpawnAreas() const
+FSpawnAreaBitSet USpawnAreaManagerComponent::GetDeactivatedSpawnAreas() const
 {
-	return CachedRecent;
+	return SpawnAreas.Managed.Difference(SpawnAreas.Activated);
 }
 
-TSet<USpawnArea*> USpawnAreaManagerComponent::GetActivatedSpawnAreas() const
+FSpawnAreaBitSet USpawnAreaManagerComponent::GetActivatedOrRecentSpawnAreas() const
 {
-	return CachedActivated;
+	return SpawnAreas.Activated.Union(SpawnAreas.Recent);
 }
 
-TSet<USpawnArea*> USpawnAreaManagerComponent::GetActivatedOrRecentSpawnAreas() const
+FSpawnAreaBitSet USpawnAreaManagerComponent::GetManagedActivatedOrRecentSpawnAreas() const
 {
-	return CachedActivated.Union(CachedRecent);
-}
-
-TSet<USpawnArea*> USpawnAreaManagerComponent::GetManagedActivatedOrRecentSpawnAreas() const
-{
-	return CachedManaged.Union(GetActivatedOrRecentSpawnAreas());
+	FSpawnAreaBitSet Out = SpawnAreas.Managed.Union(SpawnAreas.Activated);
+	Out.UnionWith(SpawnAreas.Recent);
+	return Out;
 }
 
-TSet<USpawnArea*> USpawnAreaManagerComponent::GetManagedDeactivatedNotRecentSpawnAreas() const
+FSpawnAreaBitSet USpawnAreaManagerComponent::GetManagedDeactivatedNotRecentSpawnAreas() const
 {
-	return GetDeactivatedSpawnAreas().Difference(CachedRecent);
+	FSpawnAreaBitSet Out = SpawnAreas.Managed.Difference(SpawnAreas.Activated);
+	Out.DifferenceWith(SpawnAreas.Recent);
+	return Out;
 }
 
-TSet<USpawnArea*> USpawnAreaManagerComponent::GetUnflaggedSpawnAreas() const
+FSpawnAreaBitSet USpawnAreaManagerComponent::GetUnflaggedSpawnAreas() const
 {
-	return SpawnAreas.Difference(GetManagedActivatedOrRecentSpawnAreas());
+	FSpawnAreaBitSet Out = GetManagedActivatedOrRecentSpawnAreas();
+	Out.Invert();
+	return Out;
 }
 
 /* ------------------------ */
@@ -576,71 +470,64 @@ TSet<USpawnArea*> USpawnAreaManagerComponent::GetUnflaggedSpawnAreas() const
 
 void USpawnAreaManagerComponent::FlagSpawnAreaAsManaged(const int32 SpawnAreaIndex, const FGuid TargetGuid)
 {
-	USpawnArea* SpawnArea = GetSpawnArea(SpawnAreaIndex);
-	if (!SpawnArea) return;
+	if (!IsSpawnAreaValid(SpawnAreaIndex)) return;
 
-	if (SpawnArea->IsManaged())
+	if (SpawnAreas.Managed.Contains(SpawnAreaIndex))
 	{
 		UE_LOG(LogTargetManager, Warning, TEXT("Tried to flag an already managed SpawnArea as managed."));
 		return;
 	}
 
-	SpawnArea->SetGuid(TargetGuid);
-	SpawnArea->SetIsManaged(true);
+	SpawnAreas.Guids[SpawnAreaIndex] = TargetGuid;
+	SpawnAreas.SetIsManaged(SpawnAreaIndex, true);
 
-	// Add to caches and GuidMap
-	GuidMap.Add(TargetGuid, SpawnArea);
-	CachedManaged.Add(SpawnArea);
+	GuidMap.Add(TargetGuid, SpawnAreaIndex);
 }
 
 void USpawnAreaManagerComponent::FlagSpawnAreaAsActivated(const FGuid TargetGuid, const FVector& TargetScale)
 {
-	USpawnArea* SpawnArea = GetSpawnArea(TargetGuid);
-	if (!SpawnArea)
+	const int32 Index = GetSpawnAreaIndex(TargetGuid);
+	if (!IsSpawnAreaValid(Index))
 	{
 		UE_LOG(LogTargetManager, Warning, TEXT("Failed to find target from Guid to activate."));
 		return;
 	}
 
+	const bool bActivated = SpawnAreas.Activated.Contains(Index);
+
 	// Ignore already activated target that can be reactivated
-	if (SpawnArea->CanActivateWhileActivated() && SpawnArea->IsActivated()) return;
+	if (bActivated && SpawnAreas.AllowActivationWhileActivated.Contains(Index)) return;
 
 	// Should no longer be considered recent if activated
-	if (SpawnArea->IsRecent()) RemoveRecentFlagFromSpawnArea(SpawnArea);
+	if (SpawnAreas.Recent.Contains(Index)) RemoveRecentFlagFromSpawnArea(Index);
 
-	if (SpawnArea->IsActivated())
+	if (bActivated)
 	{
 		UE_LOG(LogTargetManager, Warning, TEXT("Tried to flag as Activated when already Activated."));
 		return;
 	}
 
-	// Add to activated cache
-	CachedActivated.Add(SpawnArea);
+	// Update scale before activating so that coverage is only stamped once
+	SpawnAreas.SetTargetScale(Index, TargetScale);
 
 	// Set is activated
-	SpawnArea->SetIsActivated(true, TargetConfig().bAllowActivationWhileActivated);
+	SpawnAreas.SetIsActivated(Index, true, TargetConfig().bAllowActivationWhileActivated);
 
 	// Set as the most recently activated SpawnArea
-	SetMostRecentSpawnArea(SpawnArea);
-
-	// Update scale
-	SpawnArea->SetTargetScale(TargetScale);
+	SetMostRecentSpawnAreaIndex(Index);
 }
 
-void USpawnAreaManagerComponent::FlagSpawnAreaAsRecent(USpawnArea* SpawnArea)
+void USpawnAreaManagerComponent::FlagSpawnAreaAsRecent(const int32 Index)
 {
-	if (!SpawnArea) return;
+	if (!IsSpawnAreaValid(Index)) return;
 
-	if (SpawnArea->IsRecent())
+	if (SpawnAreas.Recent.Contains(Index))
 	{
 		UE_LOG(LogTargetManager, Warning, TEXT("Tried to flag as Recent when already Recent."));
 		return;
 	}
 
-	// Add to cache
-	CachedRecent.Add(SpawnArea);
-
-	SpawnArea->SetIsRecent(true);
+	SpawnAreas.SetIsRecent(Index, true);
 
 	FTimerHandle TimerHandle;
 
@@ -648,11 +535,11 @@ void USpawnAreaManagerComponent::FlagSpawnAreaAsRecent(USpawnArea* SpawnArea)
 	switch (TargetConfig().RecentTargetMemoryPolicy)
 	{
 	case ERecentTargetMemoryPolicy::None:
-		RemoveRecentFlagFromSpawnArea(SpawnArea);
+		RemoveRecentFlagFromSpawnArea(Index);
 		break;
 	case ERecentTargetMemoryPolicy::CustomTimeBased:
 		{
-			RemoveFromRecentDelegate.BindUObject(this, &ThisClass::RemoveRecentFlagFromSpawnArea, SpawnArea);
+			RemoveFromRecentDelegate.BindUObject(this, &ThisClass::RemoveRecentFlagFromSpawnArea, Index);
 			const float Time = TargetConfig().RecentTargetTimeLength;
 			GetWorld()->GetTimerManager().SetTimer(TimerHandle, RemoveFromRecentDelegate, Time, false);
 		}
@@ -664,7 +551,7 @@ void USpawnAreaManagerComponent::FlagSpawnAreaAsRecent(USpawnArea* SpawnArea)
 		break;
 	case ERecentTargetMemoryPolicy::UseTargetSpawnCD:
 		{
-			RemoveFromRecentDelegate.BindUObject(this, &ThisClass::RemoveRecentFlagFromSpawnArea, SpawnArea);
+			RemoveFromRecentDelegate.BindUObject(this, &ThisClass::RemoveRecentFlagFromSpawnArea, Index);
 			const float Time = TargetConfig().TargetSpawnCD;
 			GetWorld()->GetTimerManager().SetTimer(TimerHandle, RemoveFromRecentDelegate, Time, false);
 		}
@@ -676,62 +563,51 @@ void USpawnAreaManagerComponent::FlagSpawnAreaAsRecent(USpawnArea* SpawnArea)
 
 void USpawnAreaManagerComponent::RemoveManagedFlagFromSpawnArea(const FGuid TargetGuid)
 {
-	USpawnArea* SpawnArea = GetSpawnArea(TargetGuid);
-	if (!SpawnArea)
+	const int32 Index = GetSpawnAreaIndex(TargetGuid);
+	if (!IsSpawnAreaValid(Index))
 	{
 		UE_LOG(LogTargetManager, Warning, TEXT("Failed to find target by Guid to remove from managed."));
 		return;
 	}
 
 	const int32 NumRemoved = GuidMap.Remove(TargetGuid);
-	const int32 NumRemovedManaged = CachedManaged.Remove(SpawnArea);
 
-	if (!SpawnArea->IsManaged())
+	if (!SpawnAreas.Managed.Contains(Index))
 	{
 		UE_LOG(LogTargetManager, Warning, TEXT("Tried to remove managed flag from from non-managed SpawnArea."));
 		return;
 	}
 
 	if (NumRemoved == 0) UE_LOG(LogTargetManager, Warning, TEXT("Failed to remove from TargetGuidToSpawnArea map."));
-	if (NumRemovedManaged == 0) UE_LOG(LogTargetManager, Warning, TEXT("Failed to remove from CachedManaged."));
 
-	SpawnArea->SetIsManaged(false);
-	SpawnArea->ResetGuid();
+	SpawnAreas.SetIsManaged(Index, false);
+	SpawnAreas.Guids[Index].Invalidate();
 }
 
-void USpawnAreaManagerComponent::RemoveActivatedFlagFromSpawnArea(USpawnArea* SpawnArea)
+void USpawnAreaManagerComponent::RemoveActivatedFlagFromSpawnArea(const int32 Index)
 {
-	if (!SpawnArea) return;
-
-	// Remove from activated cache
-	const int32 NumRemovedFromCache = CachedActivated.Remove(SpawnArea);
+	if (!IsSpawnAreaValid(Index)) return;
 
-	if (!SpawnArea->IsActivated())
+	if (!SpawnAreas.Activated.Contains(Index))
 	{
 		UE_LOG(LogTargetManager, Warning, TEXT("Tried to remove an activated flag from non-activated SpawnArea."));
 		return;
 	}
 
-	if (NumRemovedFromCache == 0) UE_LOG(LogTargetManager, Warning, TEXT("Failed to remove from CachedActivated set."));
-
-	SpawnArea->SetIsActivated(false);
+	SpawnAreas.SetIsActivated(Index, false);
 }
 
-void USpawnAreaManagerComponent::RemoveRecentFlagFromSpawnArea(USpawnArea* SpawnArea)
+void USpawnAreaManagerComponent::RemoveRecentFlagFromSpawnArea(const int32 Index)
 {
-	if (!SpawnArea) return;
+	if (!IsSpawnAreaValid(Index)) return;
 
-	const int32 NumRemovedFromCache = CachedRecent.Remove(SpawnArea);
-
-	if (!SpawnArea->IsRecent())
+	if (!SpawnAreas.Recent.Contains(Index))
 	{
 		UE_LOG(LogTargetManager, Warning, TEXT("Tried to remove a recent flag from non-recent SpawnArea."));
 		return;
 	}
 
-	if (NumRemovedFromCache == 0) UE_LOG(LogTargetManager, Warning, TEXT("Failed to remove from CachedRecent set."));
-
-	SpawnArea->SetIsRecent(false);
+	SpawnAreas.SetIsRecent(Index, false);
 }
 
 void USpawnAreaManagerComponent::RefreshRecentFlags()
@@ -745,12 +621,13 @@ void USpawnAreaManagerComponent::RefreshRecentFlags()
 
 	if (TargetConfig().RecentTargetMemoryPolicy != ERecentTargetMemoryPolicy::NumTargetsBased) return;
 
-	const int32 NumToRemove = CachedRecent.Num() - TargetConfig().MaxNumRecentTargets;
+	const int32 NumToRemove = SpawnAreas.Recent.Num() - TargetConfig().MaxNumRecentTargets;
 	if (NumToRemove <= 0) return;
 
 	for (int32 CurrentRemoveNum = 0; CurrentRemoveNum < NumToRemove; CurrentRemoveNum++)
 	{
-		if (USpawnArea* Found = GetOldestRecentSpawnArea())
+		const int32 Found = GetOldestRecentSpawnAreaIndex();
+		if (IsSpawnAreaValid(Found))
 		{
 			RemoveRecentFlagFromSpawnArea(Found);
 		}
@@ -765,7 +642,7 @@ TSet<FGuid> USpawnAreaManagerComponent::GetActivatableTargets(const int32 NumToA
 {
 	// Assumes that we cannot activate an already activated target
 
-	TSet<USpawnArea*> ValidSpawnAreas = GetManagedDeactivatedNotRecentSpawnAreas();
+	FSpawnAreaBitSet ValidSpawnAreas = GetManagedDeactivatedNotRecentSpawnAreas();
 
 	/* TODO: Might need to have separate "Recent" for spawning and activation
 	 * For game modes like ChargedBeatTrack, there will be 4 managed targets but also 4 recent targets at some point,
@@ -780,15 +657,14 @@ TSet<FGuid> USpawnAreaManagerComponent::GetActivatableTargets(const int32 NumToA
 		}
 	}
 
-	// ReSharper disable once CppLocalVariableMayBeConst
-	USpawnArea* PreviousSpawnArea = GetMostRecentSpawnArea();
+	int32 PreviousIndex = GetMostRecentSpawnAreaIndex();
 
 	switch (TargetConfig().TargetActivationSelectionPolicy)
 	{
 	case ETargetActivationSelectionPolicy::Bordering:
 		{
-			TSet<USpawnArea*> Filtered = ValidSpawnAreas;
-			RemoveNonAdjacentIndices(Filtered, PreviousSpawnArea);
+			FSpawnAreaBitSet Filtered = ValidSpawnAreas;
+			RemoveNonAdjacentIndices(Filtered, PreviousIndex);
 			if (Filtered.Num() >= NumToActivate)
 			{
 				ValidSpawnAreas = MoveTemp(Filtered);
@@ -802,38 +678,35 @@ TSet<FGuid> USpawnAreaManagerComponent::GetActivatableTargets(const int32 NumToA
 		break;
 	}
 
-	TSet<USpawnArea*> ChosenSpawnAreas;
-	ChosenSpawnAreas.Reserve(NumToActivate);
+	FSpawnAreaBitSet ChosenSpawnAreas(SpawnAreas.Num());
+	TSet<FGuid> Out;
+	Out.Reserve(NumToActivate);
 
 	// Main loop for choosing spawn areas
 	for (int i = 0; i < NumToActivate; i++)
 	{
-		if (USpawnArea* Chosen = ChooseActivatableSpawnArea(PreviousSpawnArea, ValidSpawnAreas, ChosenSpawnAreas))
+		const int32 Chosen = ChooseActivatableSpawnArea(PreviousIndex, ValidSpawnAreas, ChosenSpawnAreas);
+		if (IsSpawnAreaValid(Chosen))
 		{
-			// Add to the return array
+			// Add to the return set
 			ChosenSpawnAreas.Add(Chosen);
+			Out.Add(SpawnAreas.Guids[Chosen]);
 
 			// Remove from options available to choose
 			ValidSpawnAreas.Remove(Chosen);
 
 			// Set as the previous SpawnArea since it will be activated before any chosen later
-			PreviousSpawnArea = Chosen;
+			PreviousIndex = Chosen;
 		}
 	}
 
-	TSet<FGuid> Out;
-	for (const USpawnArea* SpawnArea : ChosenSpawnAreas)
-	{
-		Out.Add(SpawnArea->GetGuid());
-	}
-
 	return Out;
 }
 
 TSet<FTargetSpawnParams> USpawnAreaManagerComponent::GetTargetSpawnParams(const TArray<FVector>& Scales,
 	const int32 NumToSpawn) const
 {
-	TSet<USpawnArea*> ValidSpawnAreas;
+	FSpawnAreaBitSet ValidSpawnAreas;
 
 	/* ------------------------------------ */
 	/* -- Grid-Based Target Distribution -- */
@@ -859,9 +732,17 @@ TSet<FTargetSpawnParams> USpawnAreaManagerComponent::GetTargetSpawnParams(const
 		case ERuntimeTargetSpawningLocationSelectionMode::None:
 		case ERuntimeTargetSpawningLocationSelectionMode::Random:
 			{
-				TArray<USpawnArea*> Temp = ValidSpawnAreas.Array();
-				Algo::RandomShuffle(Temp);
-				ValidSpawnAreas = TSet(MoveTemp(Temp));
+				TArray<int32> Temp = ValidSpawnAreas.Array();
+				for (int32 i = Temp.Num() - 1; i > 0; i--)
+				{
+					Temp.Swap(i, RandomStream.RandRange(0, i));
+				}
+				Temp.SetNum(FMath::Min(Temp.Num(), NumToSpawn));
+				ValidSpawnAreas.Reset();
+				for (const int32 Index : Temp)
+				{
+					ValidSpawnAreas.Add(Index);
+				}
 			}
 			break;
 		case ERuntimeTargetSpawningLocationSelectionMode::Bordering:
@@ -871,14 +752,12 @@ TSet<FTargetSpawnParams> USpawnAreaManagerComponent::GetTargetSpawnParams(const
 			break;
 		case ERuntimeTargetSpawningLocationSelectionMode::RandomGridBlock:
 			{
-				FindGridBlockUsingLargestRectangle(ValidSpawnAreas,
-					CreateIndexValidityArray(ValidSpawnAreas, SpawnAreas.Num()), NumToSpawn, false);
+				FindGridBlockUsingLargestRectangle(ValidSpawnAreas, NumToSpawn, false);
 			}
 			break;
 		case ERuntimeTargetSpawningLocationSelectionMode::NearbyGridBlock:
 			{
-				FindGridBlockUsingLargestRectangle(ValidSpawnAreas,
-					CreateIndexValidityArray(ValidSpawnAreas, SpawnAreas.Num()), NumToSpawn, true);
+				FindGridBlockUsingLargestRectangle(ValidSpawnAreas, NumToSpawn, true);
 			}
 			break;
 		case ERuntimeTargetSpawningLocationSelectionMode::RandomVertical: // TODO: NYI
@@ -896,9 +775,9 @@ TSet<FTargetSpawnParams> USpawnAreaManagerComponent::GetTargetSpawnParams(const
 
 		// Set the target scales
 		int i = 0;
-		for (USpawnArea* SpawnArea : ValidSpawnAreas)
+		for (const int32 Index : ValidSpawnAreas)
 		{
-			SpawnArea->SetTargetScale(Scales[i++]);
+			SpawnAreas.SetTargetScale(Index, Scales[i++]);
 			if (i >= Scales.Num()) break;
 		}
 	}
@@ -910,31 +789,31 @@ TSet<FTargetSpawnParams> USpawnAreaManagerComponent::GetTargetSpawnParams(const
 		// Start with all SpawnAreas within the current box bounds
 		ValidSpawnAreas = CachedExtrema;
 		
-		USpawnArea* PreviousSpawnArea = GetMostRecentSpawnArea();
+		int32 PreviousIndex = GetMostRecentSpawnAreaIndex();
 
 		// Only consider Managed Targets to be invalid if runtime
-		TSet<USpawnArea*> InvalidSpawnAreas = ShouldConsiderManagedAsInvalid()
+		FSpawnAreaBitSet InvalidSpawnAreas = ShouldConsiderManagedAsInvalid()
 			? GetManagedActivatedOrRecentSpawnAreas()
 			: GetActivatedOrRecentSpawnAreas();
 		
 		if (RequestMovingTargetLocations.IsBound())
 		{
 			FMovingTargetLocations MovingTargetLocations;
-			TSet<USpawnArea*> TempMoved;
+			FSpawnAreaBitSet TempMoved(SpawnAreas.Num());
 			RequestMovingTargetLocations.Execute(MovingTargetLocations);
 			
 			for (const TPair<FGuid, FVector>& Pair : MovingTargetLocations.Map)
 			{
-				USpawnArea* FoundByLocation = GetSpawnArea(Pair.Value);
-				USpawnArea* FoundByGuid = GetSpawnArea(Pair.Key);
+				const int32 FoundByLocation = GetSpawnAreaIndex(Pair.Value);
+				const int32 FoundByGuid = GetSpawnAreaIndex(Pair.Key);
 
-				check(FoundByLocation);
-				check(FoundByGuid);
+				check(IsSpawnAreaValid(FoundByLocation));
+				check(IsSpawnAreaValid(FoundByGuid));
 
-				if (!FoundByGuid || !FoundByLocation) continue;
+				if (!IsSpawnAreaValid(FoundByGuid) || !IsSpawnAreaValid(FoundByLocation)) continue;
 				
 				// If target has moved from its original location, don't make overlapping vertices at original
-				if (FoundByLocation->GetIndex() != FoundByGuid->GetIndex())
+				if (FoundByLocation != FoundByGuid)
 				{
 					InvalidSpawnAreas.Remove(FoundByGuid);
 					InvalidSpawnAreas.Add(FoundByLocation);
@@ -942,15 +821,16 @@ TSet<FTargetSpawnParams> USpawnAreaManagerComponent::GetTargetSpawnParams(const
 				}
 			}
 			// Add back original Spawn Areas that may have been removed due to moving targets
-			ValidSpawnAreas = ValidSpawnAreas.Difference(TempMoved);
+			ValidSpawnAreas.DifferenceWith(TempMoved);
 		}
 		
-		TSet<USpawnArea*> ChosenSpawnAreas;
+		FSpawnAreaBitSet ChosenSpawnAreas(SpawnAreas.Num());
+		FSpawnAreaBitSet ValidSpawnAreasCopy;
 		
 		// Main loop for choosing Spawn Areas
 		for (int i = 0; i < NumToSpawn; i++)
 		{
-			TSet<USpawnArea*> ValidSpawnAreasCopy = ValidSpawnAreas;
+			ValidSpawnAreasCopy = ValidSpawnAreas;
 			
 			// Remove any overlap caused by any managed/activated Spawn Areas or any already chosen Spawn Areas.
 			// Done at every iteration in case current scale > Spawn Area's scale being compared
@@ -966,17 +846,18 @@ TSet<FTargetSpawnParams> USpawnAreaManagerComponent::GetTargetSpawnParams(const
 			}
 			#endif
 
-			if (USpawnArea* Chosen = ChooseSpawnableSpawnArea(PreviousSpawnArea, ValidSpawnAreasCopy, ChosenSpawnAreas))
+			const int32 Chosen = ChooseSpawnableSpawnArea(PreviousIndex, ValidSpawnAreasCopy, ChosenSpawnAreas);
+			if (IsSpawnAreaValid(Chosen))
 			{
 				if (TargetConfig().TargetDistributionPolicy != ETargetDistributionPolicy::HeadshotHeightOnly)
 				{
-					if (GetOriginSpawnArea() && Chosen->GetIndex() != GetOriginSpawnArea()->GetIndex())
+					if (IsSpawnAreaValid(OriginSpawnAreaIndex) && Chosen != OriginSpawnAreaIndex)
 					{
-						Chosen->SetChosenPoint(USpawnArea::GenerateRandomOffset());
+						SpawnAreas.SetChosenPoint(Chosen, SpawnAreas.GenerateRandomOffset(RandomStream));
 					}
 				}
 				// Set the scale for the target to be spawned
-				Chosen->SetTargetScale(Scales[i]);
+				SpawnAreas.SetTargetScale(Chosen, Scales[i]);
 
 				// Add to the return array
 				ChosenSpawnAreas.Add(Chosen);
@@ -988,7 +869,7 @@ TSet<FTargetSpawnParams> USpawnAreaManagerComponent::GetTargetSpawnParams(const
 				ValidSpawnAreas.Remove(Chosen);
 
 				// Set as the previous SpawnArea since it will be spawned before any chosen later
-				PreviousSpawnArea = Chosen;
+				PreviousIndex = Chosen;
 			}
 		}
 
@@ -996,27 +877,27 @@ TSet<FTargetSpawnParams> USpawnAreaManagerComponent::GetTargetSpawnParams(const
 	}
 
 	TSet<FTargetSpawnParams> Out;
-	for (const USpawnArea* SpawnArea : ValidSpawnAreas)
+	Out.Reserve(ValidSpawnAreas.Num());
+	for (const int32 Index : ValidSpawnAreas)
 	{
-		Out.Emplace(FTargetSpawnParams(SpawnArea->GetChosenPoint(), SpawnArea->GetTargetScale(),
-			SpawnArea->GetIndex()));
+		Out.Emplace(FTargetSpawnParams(SpawnAreas.ChosenPoints[Index], SpawnAreas.TargetScales[Index], Index));
 	}
 
 	return Out;
 }
 
-USpawnArea* USpawnAreaManagerComponent::ChooseActivatableSpawnArea(const USpawnArea* PreviousSpawnArea,
-	const TSet<USpawnArea*>& ValidSpawnAreas, const TSet<USpawnArea*>& SelectedSpawnAreas) const
+int32 USpawnAreaManagerComponent::ChooseActivatableSpawnArea(const int32 PreviousIndex,
+	const FSpawnAreaBitSet& ValidSpawnAreas, const FSpawnAreaBitSet& SelectedSpawnAreas) const
 {
 	// 1st priority: force activate at origin
 	// Requirements: Not the previous SpawnArea, not in selected, and corresponds to a spawned target (Valid Guid).
 	// Unique exception that does not check ValidSpawnAreas.
 	if (TargetConfig().bSpawnEveryOtherTargetInCenter)
 	{
-		USpawnArea* Candidate = GetOriginSpawnArea();
-		if (Candidate && Candidate != PreviousSpawnArea)
+		const int32 Candidate = OriginSpawnAreaIndex;
+		if (IsSpawnAreaValid(Candidate) && Candidate != PreviousIndex)
 		{
-			if (Candidate->GetGuid().IsValid() && !SelectedSpawnAreas.Contains(Candidate))
+			if (SpawnAreas.Guids[Candidate].IsValid() && !SelectedSpawnAreas.Contains(Candidate))
 			{
 				return Candidate;
 			}
@@ -1026,8 +907,8 @@ USpawnArea* USpawnAreaManagerComponent::ChooseActivatableSpawnArea(const USpawnA
 	// 2st priority: origin if settings permit
 	if (TargetConfig().bSpawnAtOriginWheneverPossible)
 	{
-		USpawnArea* Candidate = GetOriginSpawnArea();
-		if (ValidSpawnAreas.Contains(Candidate) && Candidate->GetGuid().IsValid())
+		const int32 Candidate = OriginSpawnAreaIndex;
+		if (ValidSpawnAreas.Contains(Candidate) && SpawnAreas.Guids[Candidate].IsValid())
 		{
 			return Candidate;
 		}
@@ -1036,19 +917,8 @@ USpawnArea* USpawnAreaManagerComponent::ChooseActivatableSpawnArea(const USpawnA
 	// 3rd priority: Let RLC choose the SpawnArea if settings permit
 	if (RequestRLCSpawnArea.IsBound())
 	{
-		const int32 PreviousIndex = !PreviousSpawnArea ? -1 : PreviousSpawnArea->GetIndex();
-
-		// Transform to array of indices
-		TArray<int32> ValidIndices;
-		ValidIndices.Reserve(ValidIndices.Num());
-		Algo::Transform(ValidSpawnAreas, ValidIndices, [](const USpawnArea* SpawnArea)
-		{
-			return SpawnArea->GetIndex();
-		});
-
-		const int32 CandidateIndex = RequestRLCSpawnArea.Execute(PreviousIndex, ValidIndices);
-		USpawnArea* Candidate = GetSpawnArea(CandidateIndex);
-		if (Candidate && Candidate->GetGuid().IsValid())
+		const int32 Candidate = RequestRLCSpawnArea.Execute(PreviousIndex, ValidSpawnAreas);
+		if (IsSpawnAreaValid(Candidate) && SpawnAreas.Guids[Candidate].IsValid())
 		{
 			return Candidate;
 		}
@@ -1057,29 +927,28 @@ USpawnArea* USpawnAreaManagerComponent::ChooseActivatableSpawnArea(const USpawnA
 	// 4th priority: Randomly select an index from ValidSpawnAreas
 	if (!ValidSpawnAreas.IsEmpty())
 	{
-		const int32 RandomIndex = FMath::RandRange(0, ValidSpawnAreas.Num() - 1);
-		USpawnArea* RandomSpawnArea = ValidSpawnAreas.Array()[RandomIndex];
-		if (RandomSpawnArea && RandomSpawnArea->GetGuid().IsValid())
+		const int32 Candidate = ValidSpawnAreas.GetRandomIndex(RandomStream);
+		if (IsSpawnAreaValid(Candidate) && SpawnAreas.Guids[Candidate].IsValid())
 		{
-			return RandomSpawnArea;
+			return Candidate;
 		}
 	}
 
 	// No valid spawn area found
-	return nullptr;
+	return INDEX_NONE;
 }
 
-USpawnArea* USpawnAreaManagerComponent::ChooseSpawnableSpawnArea(const USpawnArea* PreviousSpawnArea,
-	const TSet<USpawnArea*>& ValidSpawnAreas, const TSet<USpawnArea*>& SelectedSpawnAreas) const
+int32 USpawnAreaManagerComponent::ChooseSpawnableSpawnArea(const int32 PreviousIndex,
+	const FSpawnAreaBitSet& ValidSpawnAreas, const FSpawnAreaBitSet& SelectedSpawnAreas) const
 {
 	// 1st priority: force spawn at origin
 	// Requirements: Not the previous SpawnArea, not managed, and not in selected.
 	// Unique exception that does not check ValidSpawnAreas
 	if (TargetConfig().bSpawnEveryOtherTargetInCenter)
 	{
-		USpawnArea* Candidate = GetOriginSpawnArea();
-		if (Candidate && !Candidate->IsManaged() && PreviousSpawnArea != Candidate && !SelectedSpawnAreas.
-			Contains(Candidate))
+		const int32 Candidate = OriginSpawnAreaIndex;
+		if (IsSpawnAreaValid(Candidate) && !SpawnAreas.Managed.Contains(Candidate) && PreviousIndex != Candidate && !
+			SelectedSpawnAreas.Contains(Candidate))
 		{
 			return Candidate;
 		}
@@ -1088,28 +957,17 @@ USpawnArea* USpawnAreaManagerComponent::ChooseSpawnableSpawnArea(const USpawnAre
 	// 2st priority: origin if settings permit
 	if (TargetConfig().bSpawnAtOriginWheneverPossible)
 	{
-		USpawnArea* Candidate = GetOriginSpawnArea();
-		if (Candidate && ValidSpawnAreas.Contains(Candidate))
+		if (ValidSpawnAreas.Contains(OriginSpawnAreaIndex))
 		{
-			return Candidate;
+			return OriginSpawnAreaIndex;
 		}
 	}
 
 	// 3rd priority: Let RLC choose the SpawnArea if settings permit
 	if (RequestRLCSpawnArea.IsBound())
 	{
-		const int32 PreviousIndex = PreviousSpawnArea ? PreviousSpawnArea->GetIndex() : -1;
-
-		// Transform to array of indices
-		TArray<int32> ValidIndices;
-		ValidIndices.Reserve(ValidIndices.Num());
-		Algo::Transform(ValidSpawnAreas, ValidIndices, [](const USpawnArea* SpawnArea)
-		{
-			return SpawnArea->GetIndex();
-		});
-
-		const int32 CandidateIndex = RequestRLCSpawnArea.Execute(PreviousIndex, ValidIndices);
-		if (USpawnArea* Candidate = GetSpawnArea(CandidateIndex))
+		const int32 Candidate = RequestRLCSpawnArea.Execute(PreviousIndex, ValidSpawnAreas);
+		if (IsSpawnAreaValid(Candidate))
 		{
 			return Candidate;
 		}
@@ -1119,119 +977,57 @@ USpawnArea* USpawnAreaManagerComponent::ChooseSpawnableSpawnArea(const USpawnAre
 	// 4th priority: Randomly select an index from ValidSpawnAreas
 	if (!ValidSpawnAreas.IsEmpty())
 	{
-		return ValidSpawnAreas.Array()[FMath::RandRange(0, ValidSpawnAreas.Num() - 1)];
+		return ValidSpawnAreas.GetRandomIndex(RandomStream);
 	}
 
 	// No valid spawn area found
-	return nullptr;
+	return INDEX_NONE;
 }
 
 /* ---------------------------------------------------------------- */
 /* -- Helper functions for Valid SpawnAreas for Spawn/Activation -- */
 /* ---------------------------------------------------------------- */
 
-void USpawnAreaManagerComponent::FindAdjacentGridUsingDFS(TSet<USpawnArea*>& ValidSpawnAreas,
+void USpawnAreaManagerComponent::FindAdjacentGridUsingDFS(FSpawnAreaBitSet& ValidSpawnAreas,
 	const int32 NumToSpawn) const
 {
-	TArray<USpawnArea*> StartNodeCandidates;
-
-	if (RecentGridBlocks.IsEmpty())
-	{
-		StartNodeCandidates = ValidSpawnAreas.Array();
-	}
-	else
-	{
-		TSet<USpawnArea*> Adjacent;
-		for (const TSet<USpawnArea*>& GridBlock : RecentGridBlocks)
-		{
-			const TSet<USpawnArea*>&& NewAdjacent = GetAdjacentSpawnAreas<USpawnArea*>(GridBlock, DirectionTypes::All);
-			const TSet<USpawnArea*>&& Common = Adjacent.Intersect(NewAdjacent);
-			Adjacent = Adjacent.Union(NewAdjacent).Difference(Common);
-		}
-		StartNodeCandidates = Adjacent.Array();
-	}
+	// Start next to exactly one recent grid block if there are any
+	const TConstArrayView<int32> ValidPath = FloodFill.FindPath(ValidSpawnAreas, RecentGridBlocks, NumToSpawn,
+		RandomStream);
 
-	TSet<USpawnArea*> ValidPath;
-
-	while (ValidPath.Num() < NumToSpawn)
+	ValidSpawnAreas.Reset();
+	for (const int32 Index : ValidPath)
 	{
-		// Explore all candidate paths if necessary
-		if (StartNodeCandidates.IsEmpty()) break;
-		USpawnArea* StartNode = StartNodeCandidates[FMath::RandRange(0, StartNodeCandidates.Num() - 1)];
-		StartNodeCandidates.RemoveSwap(StartNode);
-
-		TSet<USpawnArea*> Visited;
-		TSet<USpawnArea*> CurrentPath;
-		TArray<USpawnArea*> Stack;
-		Stack.Push(StartNode);
-
-		while (!Stack.IsEmpty())
-		{
-			USpawnArea* Vertex = Stack.Pop(false);
-			if (Visited.Contains(Vertex)) continue;
-
-			CurrentPath.Add(Vertex);
-
-			// Exit loop as soon as current path is filled with num to spawn elements
-			if (CurrentPath.Num() == NumToSpawn)
-			{
-				ValidPath = MoveTemp(CurrentPath);
-				break;
-			}
-			// If not possible to spawn NumToSpawn, keep track of best attempt
-			if (CurrentPath.Num() > ValidPath.Num())
-			{
-				ValidPath = CurrentPath;
-			}
-
-			TArray<int32> AdjacentIndices = Vertex->GetAdjacentIndices().Array();
-			Algo::RandomShuffle(AdjacentIndices);
-
-			for (const int32 Index : AdjacentIndices)
-			{
-				if (USpawnArea* Adjacent = GetSpawnArea(Index))
-				{
-					if (!Visited.Contains(Adjacent) && ValidSpawnAreas.Contains(Adjacent))
-					{
-						Stack.Push(Adjacent);
-					}
-				}
-			}
-			Visited.Add(Vertex);
-		}
+		ValidSpawnAreas.Add(Index);
 	}
-	ValidSpawnAreas = MoveTemp(ValidPath);
 	UpdateMostRecentGridBlocks(ValidSpawnAreas, NumToSpawn);
 }
 
-void USpawnAreaManagerComponent::FindGridBlockUsingLargestRectangle(TSet<USpawnArea*>& ValidSpawnAreas,
-	const TArray<int32>& IndexValidity, const int32 BlockSize, const bool bBordering) const
+void USpawnAreaManagerComponent::FindGridBlockUsingLargestRectangle(FSpawnAreaBitSet& ValidSpawnAreas,
+	const int32 BlockSize, const bool bBordering) const
 {
-	ValidSpawnAreas.Empty();
-
-	// Get all factors for the block size so that FindLargestValidRectangles can make informed decision
-	const TSet<FFactor>&& RectangleFactors = IsPrime(BlockSize)
-		? FindAllFactors(BlockSize - 1).Union(FindAllFactors(BlockSize + 1))
-		: FindAllFactors(BlockSize);
+	// Get all rectangle candidates for the block size's factors before ValidSpawnAreas is reused for the chosen block
+	RectangleFinder.FindRectangles(ValidSpawnAreas, GridBlockFactors::GetFactors(BlockSize));
 
-	TArray<FFactor> SortedRectangleFactors = RectangleFactors.Array();
-	SortedRectangleFactors.Sort();
+	#if !UE_BUILD_SHIPPING
+	if (bPrintDebug_Grid)
+	{
+		PrintDebug_Matrix(ValidSpawnAreas, TotalSpawnAreaSize.Z, TotalSpawnAreaSize.Y);
+	}
+	#endif
 
-	// Get all rectangle candidates
-	FRectangleSet&& Rectangles = FindLargestValidRectangles(IndexValidity, SortedRectangleFactors, TotalSpawnAreaSize.Z,
-		TotalSpawnAreaSize.Y);
+	ValidSpawnAreas.Reset();
 
-	// If bordering, find the adjacent indices from recent Spawn Areas, and add them to rectangles they intersect with
+	// If bordering, find the adjacent indices from recent Spawn Areas so that rectangles touching them are preferred
 	if (bBordering)
 	{
-		TSet<int32> Adjacent;
-		for (const TSet<USpawnArea*>& GridBlock : RecentGridBlocks)
+		// Indices adjacent to exactly one recent grid block
+		FSpawnAreaBitSet Adjacent(SpawnAreas.Num());
+		for (const FSpawnAreaBitSet& GridBlock : RecentGridBlocks)
 		{
-			const TSet<int32>&& NewAdjacent = GetAdjacentSpawnAreas<int32>(GridBlock, DirectionTypes::All);
-			const TSet<int32>&& Common = Adjacent.Intersect(NewAdjacent);
-			Adjacent = Adjacent.Union(NewAdjacent).Difference(Common);
+			Adjacent.SymmetricDifferenceWith(GetAdjacentSpawnAreas(GridBlock, DirectionTypes::All));
 		}
-		UpdateRectangleCandidateAdjacentIndices(Rectangles, Adjacent);
+		RectangleFinder.SetAdjacentIndices(Adjacent);
 
 		#if !UE_BUILD_SHIPPING
 		if (bPrintDebug_Grid)
@@ -1242,7 +1038,7 @@ void USpawnAreaManagerComponent::FindGridBlockUsingLargestRectangle(TSet<USpawnA
 	}
 
 	// Choose a rectangle
-	FRectCandidate&& ChosenRectangle = ChooseRectangleCandidate(Rectangles, bBordering, BlockSize);
+	FRectCandidate ChosenRectangle = RectangleFinder.ChooseRectangleCandidate(bBordering, BlockSize, RandomStream);
 	if (!ChosenRectangle.HasChosenSubRectangle())
 	{
 		#if !UE_BUILD_SHIPPING
@@ -1252,16 +1048,16 @@ void USpawnAreaManagerComponent::FindGridBlockUsingLargestRectangle(TSet<USpawnA
 	}
 
 	// Choose a rectangle orientation
-	const FIndexPair Orientation = ChooseRectangleOrientation(ChosenRectangle, ChosenRectangle.Factor);
+	const FIndexPair Orientation = ChooseRectangleOrientation(ChosenRectangle, ChosenRectangle.Factor, RandomStream);
 
 	// Choose the position and start/end indices within the chosen rectangle's available area
-	const auto [bIAsRow, bIncrement] = ChooseRectanglePosition(ChosenRectangle, Orientation, bBordering);
+	const auto [bIAsRow, bIncrement] = ChooseRectanglePosition(ChosenRectangle, Orientation,
+		RectangleFinder.GetStartIndexCandidates(), RandomStream);
 
 	#if !UE_BUILD_SHIPPING
 	if (bPrintDebug_Grid)
 	{
-		PrintDebug_Matrix(IndexValidity, TotalSpawnAreaSize.Z, TotalSpawnAreaSize.Y);
-		PrintDebug_GridLargestRect(Rectangles, ChosenRectangle, TotalSpawnAreaSize.Y, Orientation);
+		PrintDebug_GridLargestRect(RectangleFinder, ChosenRectangle, TotalSpawnAreaSize.Y, Orientation);
 	}
 	#endif
 
@@ -1278,19 +1074,21 @@ void USpawnAreaManagerComponent::FindGridBlockUsingLargestRectangle(TSet<USpawnA
 	};
 
 	// Iterate through the chosen block, adding the SpawnAreas to the set
+	int32 NumAdded = 0;
 	for (int i = ChosenRectangle.ChosenRow.StartIndex; ICheck(i); bIncrement ? ++i : --i)
 	{
 		for (int j = ChosenRectangle.ChosenCol.StartIndex; JCheck(j); bIncrement ? ++j : --j)
 		{
 			// Choosing a larger block size can lead to having to exit early
-			if (ValidSpawnAreas.Num() >= ChosenRectangle.ActualBlockSize)
+			if (NumAdded >= ChosenRectangle.ActualBlockSize)
 			{
 				break;
 			}
 			const int32 Index = bIAsRow ? i * TotalSpawnAreaSize.Y + j : j * TotalSpawnAreaSize.Y + i;
-			if (USpawnArea* SpawnArea = GetSpawnArea(Index))
+			if (IsSpawnAreaValid(Index))
 			{
-				ValidSpawnAreas.Add(SpawnArea);
+				NumAdded += ValidSpawnAreas.Contains(Index) ? 0 : 1;
+				ValidSpawnAreas.Add(Index);
 			}
 			#if !UE_BUILD_SHIPPING
 			else
@@ -1302,82 +1100,54 @@ void USpawnAreaManagerComponent::FindGridBlockUsingLargestRectangle(TSet<USpawnA
 	}
 
 	// Choose a remainder index if ActualBlockSize is prime and a smaller grid is chosen
-	if (ValidSpawnAreas.Num() < ChosenRectangle.ActualBlockSize)
+	if (NumAdded < ChosenRectangle.ActualBlockSize)
 	{
-		const TSet<int32>&& RemainderSet = GetAdjacentSpawnAreas<int32>(ValidSpawnAreas, DirectionTypes::GridBlock);
-		if (!RemainderSet.IsEmpty())
+		const FSpawnAreaBitSet Adjacent = GetAdjacentSpawnAreas(ValidSpawnAreas, DirectionTypes::GridBlock);
+		const int32 RemainderIndex = Adjacent.GetRandomIndex(RandomStream);
+		if (IsSpawnAreaValid(RemainderIndex))
 		{
-			if (USpawnArea* SpawnArea = GetSpawnArea(RemainderSet.Array()[FMath::RandRange(0, RemainderSet.Num() - 1)]))
-			{
-				ValidSpawnAreas.Add(SpawnArea);
-			}
+			ValidSpawnAreas.Add(RemainderIndex);
 		}
 	}
 
 	UpdateMostRecentGridBlocks(ValidSpawnAreas, BlockSize);
 }
 
-void USpawnAreaManagerComponent::RemoveOverlappingSpawnAreas(TSet<USpawnArea*>& ValidSpawnAreas,
-	const TSet<USpawnArea*>& InvalidSpawnAreas, const FVector& NewScale) const
+void USpawnAreaManagerComponent::RemoveOverlappingSpawnAreas(FSpawnAreaBitSet& ValidSpawnAreas,
+	const FSpawnAreaBitSet& InvalidSpawnAreas, const FVector& NewScale) const
 {
-	// TODO: This is terribly expensive if going from small target scale to large target scale
-	TSet<FVector> Invalid;
-	
-	for (USpawnArea* SpawnArea : InvalidSpawnAreas)
+	// Larger of target scale to be spawned and existing spawned target scale is used for each invalid Spawn Area
+	FSpawnAreaBitSet Covered;
+	SpawnAreas.FindCoveredSpawnAreas(InvalidSpawnAreas, NewScale, ShouldConsiderManagedAsInvalid(), Covered);
+	ValidSpawnAreas.DifferenceWith(Covered);
+
+	#if !UE_BUILD_SHIPPING
+	if (ShowDebug_Vertices > 0 && !GIsAutomationTesting)
 	{
-		// Choose larger of target scale to be spawned and existing spawned target scale
-		if (SpawnArea->GetTargetScale().Length() >= NewScale.Length())
-		{
-			if (!SpawnArea->GetOccupiedVertices().IsEmpty())
-			{
-				Invalid.Append(SpawnArea->GetOccupiedVertices());
-			}
-			else
-			{
-				Invalid.Append(SpawnArea->MakeOccupiedVertices(SpawnArea->GetTargetScale()));
-			}
-		}
-		else
+		for (const int32 Index : InvalidSpawnAreas)
 		{
-			#if !UE_BUILD_SHIPPING
-			if (!GIsAutomationTesting)
-			{
-				Invalid.Append(SpawnArea->SetMakeDebugOccupiedVertices(NewScale));
-			}
-			else
+			if (SpawnAreas.TargetScales[Index].Length() < NewScale.Length())
 			{
-				Invalid.Append(SpawnArea->MakeOccupiedVertices(NewScale));
+				SpawnAreas.SetMakeDebugOccupiedVertices(Index, NewScale);
 			}
-			#else
-			Invalid.Append(SpawnArea->MakeOccupiedVertices(NewScale));
-			#endif
-		}
-	}
-
-	for (const FVector& BotLeft : Invalid)
-	{
-		if (const USpawnArea* Found = GetSpawnArea(BotLeft))
-		{
-			ValidSpawnAreas.Remove(Found);
 		}
 	}
+	#endif
 }
 
-int32 USpawnAreaManagerComponent::RemoveNonAdjacentIndices(TSet<USpawnArea*>& ValidSpawnAreas,
-	const USpawnArea* Current) const
+int32 USpawnAreaManagerComponent::RemoveNonAdjacentIndices(FSpawnAreaBitSet& ValidSpawnAreas,
+	const int32 CurrentIndex) const
 {
-	if (!Current) return 0;
+	if (!IsSpawnAreaValid(CurrentIndex)) return 0;
 
 	const int32 PreviousSize = ValidSpawnAreas.Num();
-	TSet<USpawnArea*> BorderingSpawnAreas;
+	FSpawnAreaBitSet BorderingSpawnAreas(SpawnAreas.Num());
 
-	for (const int32 Index : Current->GetAdjacentIndices())
+	for (const int32 Index : SpawnAreas.GetAdjacentIndices(CurrentIndex))
 	{
-		USpawnArea* SpawnArea = GetSpawnArea(Index);
-		check(SpawnArea);
-		if (ValidSpawnAreas.Contains(SpawnArea))
+		if (ValidSpawnAreas.Contains(Index))
 		{
-			BorderingSpawnAreas.Add(SpawnArea);
+			BorderingSpawnAreas.Add(Index);
 		}
 	}
 
@@ -1392,7 +1162,7 @@ int32 USpawnAreaManagerComponent::RemoveNonAdjacentIndices(TSet<USpawnArea*>& Va
 	return PreviousSize - ValidSpawnAreas.Num();
 }
 
-void USpawnAreaManagerComponent::UpdateMostRecentGridBlocks(const TSet<USpawnArea*>& ValidSpawnAreas,
+void USpawnAreaManagerComponent::UpdateMostRecentGridBlocks(const FSpawnAreaBitSet& ValidSpawnAreas,
 	const int32 NumToSpawn) const
 {
 	const int32 GridBlockCapacity = TargetConfig().MaxNumRecentTargets > 0
@@ -1409,196 +1179,26 @@ void USpawnAreaManagerComponent::UpdateMostRecentGridBlocks(const TSet<USpawnAre
 /* -- Utility -- */
 /* ------------- */
 
-template <typename OutType>
-TSet<OutType> USpawnAreaManagerComponent::GetAdjacentSpawnAreas(const TSet<USpawnArea*>& InSpawnAreas,
-	const TSet<EAdjacentDirection>& Directions) const
-{
-	return TSet<OutType>();
-}
-
-template <>
-TSet<int32> USpawnAreaManagerComponent::GetAdjacentSpawnAreas<int32>(const TSet<USpawnArea*>& InSpawnAreas,
+FSpawnAreaBitSet USpawnAreaManagerComponent::GetAdjacentSpawnAreas(const FSpawnAreaBitSet& InSpawnAreas,
 	const TSet<EAdjacentDirection>& Directions) const
 {
-	TSet<int32> Out;
-
-	for (const USpawnArea* SpawnArea : InSpawnAreas)
-	{
-		Out.Append(SpawnArea->GetAdjacentIndices(Directions));
-	}
+	FSpawnAreaBitSet Out(SpawnAreas.Num());
 
-	// Don't return any SpawnAreas in the original input
-	TSet<int32> Temp;
-	Algo::Transform(InSpawnAreas, Temp, [](const USpawnArea* SpawnArea)
+	for (const int32 Index : InSpawnAreas)
 	{
-		return SpawnArea->GetIndex();
-	});
-
-	return Out.Difference(Temp);
-}
-
-template <>
-TSet<USpawnArea*> USpawnAreaManagerComponent::GetAdjacentSpawnAreas<USpawnArea*>(const TSet<USpawnArea*>& InSpawnAreas,
-	const TSet<EAdjacentDirection>& Directions) const
-{
-	TSet<USpawnArea*> Out;
-
-	for (const USpawnArea* SpawnArea : InSpawnAreas)
-	{
-		for (const int32 Index : SpawnArea->GetAdjacentIndices(Directions))
+		for (const int32 AdjacentIndex : SpawnAreas.GetAdjacentIndices(Index, Directions))
 		{
-			if (USpawnArea* Adjacent = GetSpawnArea(Index))
-			{
-				Out.Add(Adjacent);
-			}
+			Out.Add(AdjacentIndex);
 		}
 	}
 
 	// Don't return any SpawnAreas in the original input
-	return Out.Difference(InSpawnAreas);
-}
-
-TArray<int32> USpawnAreaManagerComponent::CreateIndexValidityArray(const TSet<USpawnArea*>& ValidSpawnAreas,
-	const int32 NumSpawnAreas)
-{
-	TArray<int32> IndexValidity;
-	IndexValidity.Init(0, NumSpawnAreas);
-	for (const USpawnArea* SpawnArea : ValidSpawnAreas)
-	{
-		IndexValidity[SpawnArea->GetIndex()] = 1;
-	}
-	return IndexValidity;
-}
-
-FRectangleSet USpawnAreaManagerComponent::FindLargestValidRectangles(const TArray<int32>& IndexValidity,
-	const TArray<FFactor>& Factors, const int32 NumRows, const int32 NumCols)
-{
-	FRectangleSet ValidRectangles;
-
-	// Create a histogram of column heights initialized with zeros
-	TArray<int32> Heights;
-	Heights.Init(0, NumCols);
-	FSubRectangle::SetNumCols(NumCols);
-
-	for (int32 Row = 0; Row < NumRows; Row++)
-	{
-		// Update the column heights based on the current row's validity
-		for (int32 Col = 0; Col < NumCols; Col++)
-		{
-			const int32 Index = Row * NumCols + Col;
-			// If the cell is valid, increment the column height; otherwise, reset to 0
-			Heights[Col] = IndexValidity[Index] ? Heights[Col] + 1 : 0;
-		}
-		UpdateLargestRectangles(ValidRectangles, Factors, Heights, Row);
-	}
-
-	for (auto& Rectangle : ValidRectangles) Rectangle.MergeSubRectangles();
-
-	return ValidRectangles;
-}
-
-void USpawnAreaManagerComponent::UpdateLargestRectangles(FRectangleSet& Rectangles, const TArray<FFactor>& Factors,
-	TArray<int32>& Heights, const int32 CurrentRow)
-{
-	std::stack<FSubRectangle> Stack;
-
-	// Iterate through the columns to identify potential rectangles
-	for (int32 i = 0; i < Heights.Num(); ++i)
-	{
-		int32 StartColIndex = i;
-
-		// Compare the current column's height with the height of the column at the top of the stack
-		// If the current height is less than the stack's height, it suggests the potential end of a rectangle
-		while (!Stack.empty() && Stack.top().Dimensions.Height > Heights[i])
-		{
-			// Area of the potential rectangle with the current column as the right boundary
-			if (Stack.top().Dimensions.Height > 0)
-			{
-				// Update the width and start end index
-				Stack.top().UpdateDimensions(i - Stack.top().ColIndex);
-				UpdateSubRectangles(Rectangles, Factors, Stack.top());
-			}
-
-			// Update StartColIndex to the column index at the top of the stack since measuring width from there to i
-			StartColIndex = Stack.top().ColIndex;
-
-			Stack.pop();
-		}
-		Stack.push(FSubRectangle(CurrentRow * FSubRectangle::NumCols + StartColIndex, StartColIndex, Heights[i]));
-	}
-	// After processing all columns, check if there are remaining elements in the stack
-	while (!Stack.empty())
-	{
-		if (Stack.top().Dimensions.Height > 0)
-		{
-			// Update the width and start end index
-			Stack.top().UpdateDimensions(FSubRectangle::NumCols - Stack.top().ColIndex);
-			UpdateSubRectangles(Rectangles, Factors, Stack.top());
-		}
-		Stack.pop();
-	}
-}
-
-void USpawnAreaManagerComponent::UpdateSubRectangles(FRectangleSet& Rectangles, const TArray<FFactor>& Factors,
-	const FSubRectangle& SubRectangle)
-{
-	for (const FFactor& Factor : Factors)
-	{
-		if ((SubRectangle.Dimensions.Width >= Factor.Factor1 && SubRectangle.Dimensions.Height >= Factor.Factor2) || (
-			SubRectangle.Dimensions.Width >= Factor.Factor2 && SubRectangle.Dimensions.Height >= Factor.Factor1))
-		{
-			if (FRectCandidate* FoundRectCandidate = Rectangles.Find(Factor))
-			{
-				FoundRectCandidate->UpdateSubRectangles(SubRectangle);
-			}
-			else
-			{
-				Rectangles.Emplace(FRectCandidate(Factor));
-			}
-		}
-	}
-}
-
-FRectCandidate USpawnAreaManagerComponent::ChooseRectangleCandidate(const FRectangleSet& Rectangles,
-	const bool bBordering, const int32 BlockSize)
-{
-	// Convert to array and sort based on FRectCandidate < operator
-	TArray<FRectCandidate> RectanglesArr = Rectangles.Array();
-	RectanglesArr.Sort();
-
-	if (bBordering)
-	{
-		for (auto& Rectangle : RectanglesArr)
-		{
-			TArray<FSubRectangle> SortedSubRectangles = Rectangle.SubRectangles.Array();
-			Algo::RandomShuffle(SortedSubRectangles);
-			for (const auto& SubRectangle : SortedSubRectangles)
-			{
-				if (!SubRectangle.StartIndexCandidates.IsEmpty())
-				{
-					// choose the first encountered sub rectangle that has start index candidates
-					Rectangle.SetChosenSubRectangle(SubRectangle, BlockSize);
-					return Rectangle;
-				}
-			}
-		}
-	}
-
-	// Choose a random one that has SubRectangles
-	for (auto& Rectangle : RectanglesArr)
-	{
-		if (!Rectangle.SubRectangles.IsEmpty())
-		{
-			TArray<FSubRectangle> SubRectangles = Rectangle.SubRectangles.Array();
-			Rectangle.SetChosenSubRectangle(SubRectangles[FMath::RandRange(0, SubRectangles.Num() - 1)], BlockSize);
-			return Rectangle;
-		}
-	}
-
-	return FRectCandidate();
+	Out.DifferenceWith(InSpawnAreas);
+	return Out;
 }
 
-FIndexPair USpawnAreaManagerComponent::ChooseRectangleOrientation(const FRectCandidate& Rect, const FFactor& Factor)
+FIndexPair USpawnAreaManagerComponent::ChooseRectangleOrientation(const FRectCandidate& Rect, const FFactor& Factor,
+	const FRandomStream& Stream)
 {
 	int32 SubRowSize = -1;
 	int32 SubColSize = -1;
@@ -1606,7 +1206,7 @@ FIndexPair USpawnAreaManagerComponent::ChooseRectangleOrientation(const FRectCan
 	// All fit, choose random
 	if (Rect.AllFactorsFit())
 	{
-		const bool bRandom = FMath::RandBool();
+		const bool bRandom = Stream.FRand() < 0.5f;
 		SubRowSize = bRandom ? Factor.Factor1 : Factor.Factor2;
 		SubColSize = bRandom ? Factor.Factor2 : Factor.Factor1;
 	}
@@ -1624,24 +1224,23 @@ FIndexPair USpawnAreaManagerComponent::ChooseRectangleOrientation(const FRectCan
 }
 
 std::pair<bool, bool> USpawnAreaManagerComponent::ChooseRectanglePosition(FRectCandidate& ChosenRectangle,
-	const FIndexPair& Orientation, const bool bBordering)
+	const FIndexPair& Orientation, TConstArrayView<FIndexPair> StartIndexCandidates, const FRandomStream& Stream)
 {
 	// ChosenRow and ChosenCol are initialized to the chosen sub rectangles full Row, Col
 	const int32 MaxStartRowIndex = ChosenRectangle.ChosenRow.EndIndex - Orientation.StartIndex + 1;
 	const int32 MaxStartColIndex = ChosenRectangle.ChosenCol.EndIndex - Orientation.EndIndex + 1;
 	ChosenRectangle.ChosenBlockSize = Orientation.StartIndex * Orientation.EndIndex;
 
-	if (bBordering && !ChosenRectangle.ChosenSubRectangle.StartIndexCandidates.IsEmpty())
+	if (!StartIndexCandidates.IsEmpty())
 	{
-		const auto RandomAdjacent = ChosenRectangle.ChosenSubRectangle.StartIndexCandidates[FMath::RandRange(0,
-			ChosenRectangle.ChosenSubRectangle.StartIndexCandidates.Num() - 1)];
+		const FIndexPair RandomAdjacent = StartIndexCandidates[Stream.RandRange(0, StartIndexCandidates.Num() - 1)];
 		ChosenRectangle.ChosenRow.StartIndex = RandomAdjacent.StartIndex;
 		ChosenRectangle.ChosenCol.StartIndex = RandomAdjacent.EndIndex;
 	}
 	else
 	{
-		ChosenRectangle.ChosenRow.StartIndex = FMath::RandRange(ChosenRectangle.ChosenRow.StartIndex, MaxStartRowIndex);
-		ChosenRectangle.ChosenCol.StartIndex = FMath::RandRange(ChosenRectangle.ChosenRow.StartIndex, MaxStartColIndex);
+		ChosenRectangle.ChosenRow.StartIndex = Stream.RandRange(ChosenRectangle.ChosenRow.StartIndex, MaxStartRowIndex);
+		ChosenRectangle.ChosenCol.StartIndex = Stream.RandRange(ChosenRectangle.ChosenCol.StartIndex, MaxStartColIndex);
 	}
 
 	ChosenRectangle.ChosenRow.EndIndex = ChosenRectangle.ChosenRow.StartIndex + Orientation.StartIndex - 1;
@@ -1653,8 +1252,8 @@ std::pair<bool, bool> USpawnAreaManagerComponent::ChooseRectanglePosition(FRectC
 	// Randomize the start indices if it will get chopped off
 	if (ChosenRectangle.ChosenBlockSize > ChosenRectangle.ActualBlockSize)
 	{
-		bIAsRow = FMath::RandBool();
-		bIncrement = FMath::RandBool();
+		bIAsRow = Stream.FRand() < 0.5f;
+		bIncrement = Stream.FRand() < 0.5f;
 
 		// Swap rows and columns
 		if (!bIAsRow)
@@ -1674,180 +1273,13 @@ std::pair<bool, bool> USpawnAreaManagerComponent::ChooseRectanglePosition(FRectC
 	return std::pair(bIAsRow, bIncrement);
 }
 
-TSet<FFactor> USpawnAreaManagerComponent::GetPreferredRectangleDimensions(const int32 BlockSize, const int32 NumRows,
-	const int32 NumCols)
-{
-	TSet<FFactor> MinFactors;
-	// If the block size is prime, find the min factors of one less and one greater than the ActualBlockSize
-	if (IsPrime(BlockSize))
-	{
-		const TSet<FFactor> OneLessBlockSize = FindBestFittingFactors(BlockSize - 1, NumRows, NumCols);
-		const TSet<FFactor> OneGreaterBlockSize = FindBestFittingFactors(BlockSize + 1, NumRows, NumCols);
-
-		if (OneLessBlockSize.IsEmpty() && OneGreaterBlockSize.IsEmpty())
-		{
-			return MinFactors;
-		}
-
-		FFactor MinDifferenceFactor = FFactor(BlockSize);
-		for (const FFactor Factor : OneLessBlockSize.Union(OneGreaterBlockSize))
-		{
-			if (Factor.Distance < MinDifferenceFactor.Distance)
-			{
-				MinDifferenceFactor = Factor;
-				MinFactors.Empty();
-			}
-			if (Factor.Distance <= MinDifferenceFactor.Distance)
-			{
-				MinFactors.Add(Factor);
-			}
-		}
-	}
-	else
-	{
-		MinFactors = FindBestFittingFactors(BlockSize, NumRows, NumCols);
-	}
-
-	return MinFactors;
-}
-
-void USpawnAreaManagerComponent::UpdateRectangleCandidateAdjacentIndices(FRectangleSet& Rectangles,
-	const TSet<int32>& Adjacent)
-{
-	for (FRectCandidate& Rectangle : Rectangles)
-	{
-		for (FSubRectangle& SubRectangle : Rectangle.SubRectangles)
-		{
-			for (const int32 Index : Adjacent)
-			{
-				const int32 Row = Index / FSubRectangle::NumCols;
-				const int32 Col = Index % FSubRectangle::NumCols;
-
-				const bool bGrEqualToStart = Row >= SubRectangle.Row.StartIndex && Col >= SubRectangle.Col.StartIndex;
-				const bool bLeEqualToEnd = Row <= SubRectangle.Row.EndIndex && Col <= SubRectangle.Col.EndIndex;
-				if (bGrEqualToStart && bLeEqualToEnd)
-				{
-					SubRectangle.AdjacentIndices.Add(Index);
-				}
-				for (int i = SubRectangle.Row.StartIndex; i <= SubRectangle.Row.EndIndex; ++i)
-				{
-					for (int j = SubRectangle.Col.StartIndex; j <= SubRectangle.Col.EndIndex; ++j)
-					{
-						const int32 BlockRowEnd = i + Rectangle.Factor.Factor1 - 1;
-						const int32 BlockColEnd = j + Rectangle.Factor.Factor2 - 1;
-						if (BlockRowEnd <= SubRectangle.Row.EndIndex && BlockColEnd <= SubRectangle.Col.EndIndex)
-						{
-							if (Row >= i && Col >= j && Row <= BlockRowEnd && Col <= BlockColEnd)
-							{
-								SubRectangle.StartIndexCandidates.Add(FIndexPair(i, j));
-							}
-						}
-					}
-				}
-			}
-		}
-	}
-}
-
-TSet<FFactor> USpawnAreaManagerComponent::FindAllFactors(const int32 Number)
-{
-	TSet<FFactor> Out;
-	if (Number == 0) return Out;
-	if (Number == 1)
-	{
-		Out.Add(FFactor(1, 1));
-		return Out;
-	}
-	for (int i = 1; i <= Number / 2; i++)
-	{
-		if (Number % i == 0)
-		{
-			Out.Add(FFactor(i, Number / i));
-		}
-	}
-	return Out;
-}
-
-FFactor USpawnAreaManagerComponent::FindLargestFactors(const int32 Number)
-{
-	FFactor Factor(-1, -1);
-	float MinDistance = Number;
-	for (int i = 2; i <= Number / 2; i++)
-	{
-		if (Number % i == 0)
-		{
-			const int32 OtherNumber = Number / i;
-			const float Distance = abs(i - OtherNumber);
-			if (Distance < MinDistance)
-			{
-				MinDistance = Distance;
-				Factor.Factor1 = i;
-				Factor.Factor2 = OtherNumber;
-			}
-		}
-	}
-	return Factor;
-}
-
-TSet<FFactor> USpawnAreaManagerComponent::FindBestFittingFactors(const int32 Number, const int32 Constraint1,
-	const int32 Constraint2)
-{
-	TSet<FFactor> FittingFactors;
-	float MinDistance = Number;
-	// Add any factors that that fit within constraints, and record the minimum distance between them
-	for (const FFactor& Factor : FindAllFactors(Number))
-	{
-		const float Dist = abs(Factor.Factor1 - Factor.Factor2);
-		if ((Factor.Factor1 <= Constraint1 && Factor.Factor2 <= Constraint2) || (Factor.Factor2 <= Constraint1 && Factor
-			.Factor1 <= Constraint2))
-		{
-			FittingFactors.Add(Factor);
-			if (Dist < MinDistance)
-			{
-				MinDistance = Dist;
-			}
-		}
-	}
-
-	TSet<FFactor> BestFactors;
-	// Add the factors with the minimum distance, since there might be more than one
-	for (const FFactor& Factor : FittingFactors)
-	{
-		if (abs(Factor.Factor1 - Factor.Factor2) == MinDistance)
-		{
-			BestFactors.Add(Factor);
-		}
-	}
-
-	return BestFactors;
-}
-
-constexpr bool USpawnAreaManagerComponent::IsPrime(const int32 Number)
-{
-	if (Number <= 1) return false;
-	if (Number == 2 || Number == 3) return true;
-	if (Number % 2 == 0 || Number % 3 == 0) return false;
-
-	// All prime numbers > 3 can be expressed by 6k ± 1, where k is a positive integer
-	int i = 5;
-
-	while (i * i <= Number)
-	{
-		// Check divisibility from (5, sqrt(number)), or by an integer that is 2 greater
-		if (Number % i == 0 || Number % (i + 2) == 0) return false;
-		i += 6;
-	}
-
-	return true;
-}
-
 FAccuracyData USpawnAreaManagerComponent::GetLocationAccuracy()
 {
-	TArray<int32> TotalSpawns;
-	TArray<int32> TotalHits;
+	const bool bHitDamage = TargetConfig().TargetDamageType == ETargetDamageType::Hit;
 
-	TotalSpawns.Init(-1, SpawnAreas.Num());
-	TotalHits.Init(0, SpawnAreas.Num());
+	// For now only handle separate Hit and Tracking Damage
+	const TArray<int32>& TotalSpawns = bHitDamage ? SpawnAreas.TotalSpawns : SpawnAreas.TotalTrackingDamagePossible;
+	const TArray<int32>& TotalHits = bHitDamage ? SpawnAreas.TotalHits : SpawnAreas.TotalTrackingDamage;
 
 	#if !UE_BUILD_SHIPPING
 	int32 TotalSpawnsValueRef = 0;
@@ -1856,33 +1288,19 @@ FAccuracyData USpawnAreaManagerComponent::GetLocationAccuracy()
 	int32 TotalHitsValueTest = 0;
 	#endif
 
-	const bool bHitDamage = TargetConfig().TargetDamageType == ETargetDamageType::Hit;
-	// For now only handle separate Hit and Tracking Damage
-	int32 (USpawnArea::*TotalFunc)() const = bHitDamage
-		? &USpawnArea::GetTotalSpawns
-		: &USpawnArea::GetTotalTrackingDamagePossible;
-	int32 (USpawnArea::*HitFunc)() const = bHitDamage ? &USpawnArea::GetTotalHits : &USpawnArea::GetTotalTrackingDamage;
-
-	for (USpawnArea* SpawnArea : SpawnAreas)
+	#if !UE_BUILD_SHIPPING
+	for (int32 Index = 0; Index < SpawnAreas.Num(); Index++)
 	{
-		const int32 Index = SpawnArea->GetIndex();
-		const int32 SpawnsValue = (SpawnArea->*TotalFunc)();
-		const int32 HitsValue = (SpawnArea->*HitFunc)();
-
-		TotalSpawns[Index] = SpawnsValue;
-		TotalHits[Index] = HitsValue;
-
-		#if !UE_BUILD_SHIPPING
-		if (SpawnsValue >= 0)
+		if (TotalSpawns[Index] >= 0)
 		{
-			TotalSpawnsValueRef += SpawnsValue;
+			TotalSpawnsValueRef += TotalSpawns[Index];
 		}
-		if (HitsValue > 0)
+		if (TotalHits[Index] > 0)
 		{
-			TotalHitsValueRef += HitsValue;
+			TotalHitsValueRef += TotalHits[Index];
 		}
-		#endif
 	}
+	#endif
 
 	FAccuracyData OutData = GetAveragedAccuracyData(TotalSpawns, TotalHits, TotalSpawnAreaSize.Z, TotalSpawnAreaSize.Y);
 
@@ -1930,22 +1348,6 @@ int32 USpawnAreaManagerComponent::CalcManhattanDist(const int32 Index1, const in
 	return FMath::Abs(Row2 - Row1) + FMath::Abs(Col2 - Col1);
 }
 
-TArray<int32> USpawnAreaManagerComponent::FilterIndices(TArray<USpawnArea*>& ValidSpawnAreas,
-	bool (USpawnArea::*FilterFunc)() const)
-{
-	TArray<int32> Removed;
-	ValidSpawnAreas = ValidSpawnAreas.FilterByPredicate([&](const USpawnArea* SpawnArea)
-	{
-		if ((SpawnArea->*FilterFunc)())
-		{
-			Removed.Add(SpawnArea->GetIndex());
-			return false;
-		}
-		return true;
-	});
-	return Removed;
-}
-
 /* ----------- */
 /* -- Debug -- */
 /* ----------- */
@@ -1956,79 +1358,45 @@ void USpawnAreaManagerComponent::DrawDebug() const
 {
 	if (bShowDebug_AllSpawnAreas)
 	{
-		DrawDebug_Boxes(SpawnAreas, DebugColor_AllSpawnAreas, DebugBoxLineThickness, true);
+		DrawDebug_Boxes(FSpawnAreaBitSet(SpawnAreas.Num(), true), DebugColor_AllSpawnAreas, DebugBoxLineThickness,
+			true);
 	}
 	if (bShowDebug_ValidInvalidSpawnAreas)
 	{
-		const TSet<USpawnArea*> InvalidSpawnAreas = ShouldConsiderManagedAsInvalid()
-			? CachedManaged.Union(CachedActivated)
-			: CachedActivated;
-		const TSet<USpawnArea*> RecentSpawnAreas = CachedRecent;
-
-		TSet<FVector> InvalidLocations;
-		TSet<FVector> RecentLocations;
-
-		TSet<USpawnArea*> OverlappingInvalid;
-		TSet<USpawnArea*> OverlappingRecent;
-
-		for (USpawnArea* SpawnArea : InvalidSpawnAreas)
-		{
-			TSet Occupied = SpawnArea->GetOccupiedVertices();
-			if (Occupied.IsEmpty())
-			{
-				Occupied = SpawnArea->MakeOccupiedVertices(SpawnArea->GetTargetScale());
-			}
-			InvalidLocations.Append(Occupied);
-		}
-		for (const FVector& BotLeft : InvalidLocations)
-		{
-			if (USpawnArea* Found = GetSpawnArea(BotLeft))
-			{
-				OverlappingInvalid.Add(Found);
-			}
-		}
+		const FSpawnAreaBitSet InvalidSpawnAreas = ShouldConsiderManagedAsInvalid()
+			? SpawnAreas.Managed.Union(SpawnAreas.Activated)
+			: SpawnAreas.Activated;
+		const FSpawnAreaBitSet& RecentSpawnAreas = SpawnAreas.Recent;
 
-		for (USpawnArea* SpawnArea : RecentSpawnAreas)
-		{
-			TSet Occupied = SpawnArea->GetOccupiedVertices();
-			if (Occupied.IsEmpty())
-			{
-				Occupied = SpawnArea->MakeOccupiedVertices(SpawnArea->GetTargetScale());
-			}
-			RecentLocations.Append(Occupied);
-		}
-		for (const FVector& BotLeft : RecentLocations)
-		{
-			if (USpawnArea* Found = GetSpawnArea(BotLeft))
-			{
-				OverlappingRecent.Add(Found);
-			}
-		}
+		FSpawnAreaBitSet OverlappingInvalid;
+		FSpawnAreaBitSet OverlappingRecent;
+		SpawnAreas.FindCoveredSpawnAreas(InvalidSpawnAreas, FVector::ZeroVector, ShouldConsiderManagedAsInvalid(),
+			OverlappingInvalid);
+		SpawnAreas.FindCoveredSpawnAreas(RecentSpawnAreas, FVector::ZeroVector, false, OverlappingRecent);
 
-		const TSet<USpawnArea*> OverlappingValid = CachedExtrema.
-			Difference(OverlappingInvalid.Union(OverlappingRecent));
+		FSpawnAreaBitSet OverlappingValid = CachedExtrema.Difference(OverlappingInvalid);
+		OverlappingValid.DifferenceWith(OverlappingRecent);
 		DrawDebug_Boxes(OverlappingValid, DebugColor_ValidOverlap, DebugBoxLineThickness, true);
 		DrawDebug_Boxes(OverlappingRecent, DebugColor_RecentSpawnAreas, DebugBoxLineThickness, true);
 		DrawDebug_Boxes(OverlappingInvalid, DebugColor_InvalidOverlap, DebugBoxLineThickness, true);
 	}
 	if (bShowDebug_RemovedFromExtremaChange)
 	{
-		const TSet<USpawnArea*> RemovedExtrema = SpawnAreas.Difference(CachedExtrema);
+		FSpawnAreaBitSet RemovedExtrema = CachedExtrema;
+		RemovedExtrema.Invert();
 		DrawDebug_Boxes(RemovedExtrema, DebugColor_RemovedFromExtremaChange, DebugBoxLineThickness, true);
 	}
 	if (bShowDebug_NonAdjacent)
 	{
-		const TSet<USpawnArea*> NonAdjacent = DebugCached_NonAdjacentSpawnAreas;
-		DrawDebug_Boxes(NonAdjacent, DebugColor_NonAdjacent, DebugBoxLineThickness, true);
+		DrawDebug_Boxes(DebugCached_NonAdjacentSpawnAreas, DebugColor_NonAdjacent, DebugBoxLineThickness, true);
 	}
 	if (bShowDebug_SpawnableSpawnAreas)
 	{
-		const TSet<USpawnArea*> ValidSpawnable = DebugCached_SpawnableValidSpawnAreas;
-		DrawDebug_Boxes(ValidSpawnable, DebugColor_SpawnableSpawnAreas, DebugBoxLineThickness, true);
+		DrawDebug_Boxes(DebugCached_SpawnableValidSpawnAreas, DebugColor_SpawnableSpawnAreas, DebugBoxLineThickness, true);
 	}
 	if (bShowDebug_ActivatableSpawnAreas)
 	{
-		TSet<USpawnArea*> ValidActivatable = GetManagedDeactivatedNotRecentSpawnAreas();
+		FSpawnAreaBitSet ValidActivatable = GetManagedDeactivatedNotRecentSpawnAreas();
 		if (ValidActivatable.IsEmpty())
 		{
 			ValidActivatable = GetDeactivatedSpawnAreas();
@@ -2054,47 +1422,46 @@ void USpawnAreaManagerComponent::DrawDebug() const
 	}
 }
 
-void USpawnAreaManagerComponent::DrawDebug_Boxes(const TSet<USpawnArea*>& InSpawnAreas, const FColor& Color,
+void USpawnAreaManagerComponent::DrawDebug_Boxes(const FSpawnAreaBitSet& InSpawnAreas, const FColor& Color,
 	const int32 Thickness, const bool bPersistent) const
 {
 	const float Time = bPersistent ? -1.f : TargetConfig().TargetSpawnCD;
 	const FVector HalfInc = {0.f, GetSpawnAreaDimensions().Y * 0.5f, GetSpawnAreaDimensions().Z * 0.5f};
 	const FVector Offset = {DebugBoxXOffset, 0.f, 0.f};
 	const UWorld* World = GetWorld();
-	for (const USpawnArea* SpawnArea : InSpawnAreas)
+	for (const int32 Index : InSpawnAreas)
 	{
-		DrawDebugBox(World, SpawnArea->GetCenterPoint() + Offset, HalfInc, Color, bPersistent, Time, 0, Thickness);
+		DrawDebugBox(World, SpawnAreas.GetCenterPoint(Index) + Offset, HalfInc, Color, bPersistent, Time, 0, Thickness);
 	}
 }
 
-void USpawnAreaManagerComponent::DrawDebug_Vertices(const TSet<USpawnArea*>& InSpawnAreas, const bool bGenerateNew,
+void USpawnAreaManagerComponent::DrawDebug_Vertices(const FSpawnAreaBitSet& InSpawnAreas, const bool bGenerateNew,
 	const bool bDrawSphere) const
 {
 	TSet<FVector> InvalidVertices, ValidVertices, SpawnAreaVertices;
-	for (const USpawnArea* SpawnArea : InSpawnAreas)
+	for (const int32 Index : InSpawnAreas)
 	{
-		const FVector Scale = bGenerateNew || SpawnArea->DebugOccupiedVertices.IsEmpty()
-			? SpawnArea->GetTargetScale()
-			: SpawnArea->LastOccupiedVerticesTargetScale;
+		const bool bUseNew = bGenerateNew || SpawnAreas.DebugOccupiedVertices[Index].IsEmpty();
+		const FVector Scale = bUseNew ? SpawnAreas.TargetScales[Index] : SpawnAreas.LastOccupiedVerticesTargetScales[Index];
 
 		if (bDrawSphere)
 		{
-			const float Radius = USpawnArea::CalcTraceRadius(Scale);
-			DrawDebugSphere(GetWorld(), SpawnArea->GetBottomLeftVertex(), Radius, DebugSphereSegments, FColor::Magenta,
-				true);
+			const float Radius = SpawnAreas.CalcTraceRadius(Scale);
+			DrawDebugSphere(GetWorld(), SpawnAreas.GetBottomLeftVertex(Index), Radius, DebugSphereSegments,
+				FColor::Magenta, true);
 		}
 
-		if (bGenerateNew || SpawnArea->DebugOccupiedVertices.IsEmpty())
+		if (bUseNew)
 		{
-			InvalidVertices.Append(SpawnArea->MakeOccupiedVertices(Scale));
+			InvalidVertices.Append(SpawnAreas.MakeOccupiedVertices(Index, Scale));
 		}
 		else
 		{
-			InvalidVertices.Append(SpawnArea->DebugOccupiedVertices);
+			InvalidVertices.Append(SpawnAreas.DebugOccupiedVertices[Index]);
 		}
 
-		ValidVertices.Append(SpawnArea->MakeUnoccupiedVertices(Scale));
-		SpawnAreaVertices.Add(SpawnArea->GetBottomLeftVertex());
+		ValidVertices.Append(SpawnAreas.MakeUnoccupiedVertices(Index, Scale));
+		SpawnAreaVertices.Add(SpawnAreas.GetBottomLeftVertex(Index));
 	}
 
 	InvalidVertices = InvalidVertices.Difference(SpawnAreaVertices);
@@ -2123,6 +1490,15 @@ void USpawnAreaManagerComponent::PrintDebug_SpawnAreaStateInfo() const
 		NumManaged);
 }
 
+USpawnArea* USpawnAreaManagerComponent::CreateSpawnAreaView(const int32 Index) const
+{
+	if (!IsSpawnAreaValid(Index)) return nullptr;
+
+	USpawnArea* View = NewObject<USpawnArea>(GetTransientPackage());
+	View->Init(&SpawnAreas, Index);
+	return View;
+}
+
 void USpawnAreaManagerComponent::PrintDebug_SpawnArea(const USpawnArea* SpawnArea)
 {
 	UE_LOG(LogTargetManager, Display, TEXT("SpawnArea:"));
@@ -2145,12 +1521,13 @@ void USpawnAreaManagerComponent::PrintDebug_SpawnArea(const USpawnArea* SpawnAre
 		SpawnArea->GetTotalHits());
 }
 
-void USpawnAreaManagerComponent::PrintDebug_SpawnAreaDist(const USpawnArea* SpawnArea) const
+void USpawnAreaManagerComponent::PrintDebug_SpawnAreaDist(const int32 Index) const
 {
-	const float MaxAllowedDistance = SpawnArea->GetTargetScale().X * Constants::SphereTargetRadius;
-	for (const USpawnArea* ActivatedOrRecent : GetActivatedOrRecentSpawnAreas())
+	const float MaxAllowedDistance = SpawnAreas.TargetScales[Index].X * Constants::SphereTargetRadius;
+	for (const int32 ActivatedOrRecent : GetActivatedOrRecentSpawnAreas())
 	{
-		const double Distance = FVector::Distance(ActivatedOrRecent->GetChosenPoint(), SpawnArea->GetChosenPoint());
+		const double Distance = FVector::Distance(SpawnAreas.ChosenPoints[ActivatedOrRecent],
+			SpawnAreas.ChosenPoints[Index]);
 
 		if (Distance < MaxAllowedDistance)
 		{
@@ -2160,7 +1537,7 @@ void USpawnAreaManagerComponent::PrintDebug_SpawnAreaDist(const USpawnArea* Spaw
 	}
 }
 
-void USpawnAreaManagerComponent::PrintDebug_GridLargestRect(const FRectangleSet& Rectangles,
+void USpawnAreaManagerComponent::PrintDebug_GridLargestRect(const FLargestRectangleFinder& Finder,
 	const FRectCandidate& Chosen, const int32 NumCols, const FIndexPair& Orientation)
 {
 	const int32 StartRowIndex = Chosen.ChosenSubRectangle.BoundingIndices.StartIndex / NumCols;
@@ -2190,25 +1567,18 @@ void USpawnAreaManagerComponent::PrintDebug_GridLargestRect(const FRectangleSet&
 	Options.MinimumIntegralDigits = 3;
 	Options.MaximumIntegralDigits = 3;
 
-	FNumberFormattingOptions Options2;
-	Options2.MinimumIntegralDigits = 2;
-	Options2.MaximumIntegralDigits = 2;
-
-	UE_LOG(LogTargetManager, Display, TEXT("Rectangles length: %d"), Rectangles.Num());
-	for (const auto& Rectangle : Rectangles)
+	UE_LOG(LogTargetManager, Display, TEXT("Rectangles length: %d"), Finder.GetNumRectangles());
+	for (int32 FactorIndex = 0; FactorIndex < Finder.GetNumFactors(); FactorIndex++)
 	{
-		UE_LOG(LogTargetManager, Display, TEXT("%s"), *Rectangle.ToString());
-		for (const auto& SubRectangle : Rectangle.SubRectangles)
+		const FFactor& Factor = Finder.GetFactor(FactorIndex);
+		UE_LOG(LogTargetManager, Display, TEXT("Candidate [%d, %d]"), Factor.Factor1, Factor.Factor2);
+		for (const int32 RectIndex : Finder.GetCandidates(FactorIndex))
 		{
-			if (Idx < 5)
-			{
-				FString Number = FText::AsNumber(SubRectangle.AdjacentIndices.Num(), &Options2).ToString();
-				FString Number2 = FText::AsNumber(SubRectangle.BoundingIndices.StartIndex, &Options).ToString();
-				FString Number3 = FText::AsNumber(SubRectangle.BoundingIndices.EndIndex, &Options).ToString();
-				Line += FString::Printf(TEXT("%s [%s, %s]"), *Number, *Number2, *Number3) + " ";
-				Idx++;
-			}
-			else
+			const FSubRectangle& SubRectangle = Finder.GetRectangle(RectIndex);
+			FString Number = FText::AsNumber(SubRectangle.BoundingIndices.StartIndex, &Options).ToString();
+			FString Number2 = FText::AsNumber(SubRectangle.BoundingIndices.EndIndex, &Options).ToString();
+			Line += FString::Printf(TEXT("[%s, %s]"), *Number, *Number2) + " ";
+			if (++Idx == 5)
 			{
 				UE_LOG(LogTargetManager, Display, TEXT("%s"), *Line);
 				Line.Empty();
@@ -2229,7 +1599,7 @@ void USpawnAreaManagerComponent::PrintDebug_GridLargestRect(const FRectangleSet&
 	check(Chosen.ChosenCol.EndIndex <= Chosen.ChosenSubRectangle.BoundingIndices.EndIndex);
 }
 
-void USpawnAreaManagerComponent::PrintDebug_Matrix(const TArray<int32>& Matrix, const int32 NumRows,
+void USpawnAreaManagerComponent::PrintDebug_Matrix(const FSpawnAreaBitSet& ValidSpawnAreas, const int32 NumRows,
 	const int32 NumCols)
 {
 	FString Line;
@@ -2249,17 +1619,16 @@ void USpawnAreaManagerComponent::PrintDebug_Matrix(const TArray<int32>& Matrix,
 	int32 CurrentIndex = 0;
 	int32 CurrentRow = NumRows - 1;
 
-	for (const int32 i : Matrix)
+	for (; CurrentIndex < NumRows * NumCols; CurrentIndex++)
 	{
 		FString Number = FText::AsNumber(CurrentIndex, &Options).ToString();
-		Line += (i == 1 ? Number : Xs) + " ";
+		Line += (ValidSpawnAreas.Contains(CurrentIndex) ? Number : Xs) + " ";
 		if ((CurrentIndex + 1) % NumCols == 0 && (CurrentIndex + 1) >= NumCols)
 		{
 			Lines[CurrentRow] = Line;
 			CurrentRow--;
 			Line.Empty();
 		}
-		CurrentIndex++;
 	}
 	Line.Empty();
 
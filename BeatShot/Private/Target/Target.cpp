@@ -14,7 +14,6 @@
 #include "Components/StaticMeshComponent.h"
 #include "AbilitySystem/Globals/BSAttributeSetBase.h"
 #include "GameFramework/ProjectileMovementComponent.h"
-#include "Kismet/KismetMathLibrary.h"
 
 
 FTargetDamageEvent::FTargetDamageEvent(const FDamageEventData& InData, const float InTimeAlive, ATarget* InTarget)
@@ -68,7 +67,8 @@ void FTargetDamageEvent::SetTargetManagerData(const bool bDeactivate, const bool
 
 ATarget::ATarget()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Color and scale animations are played by the TargetManager's FTargetAnimationManager
+	PrimaryActorTick.bCanEverTick = false;
 
 	if (!RootComponent)
 	{
@@ -132,6 +132,7 @@ ATarget::ATarget()
 	PeakToEndTimelinePlayRate = 1.f;
 	bApplyLifetimeTargetScaling = false;
 	bHasBeenActivated = false;
+	bIsPooled = false;
 }
 
 void ATarget::BeginPlay()
@@ -145,24 +146,9 @@ void ATarget::BeginPlay()
 	TargetColorChangeMaterial = UMaterialInstanceDynamic::Create(SphereMesh->GetMaterial(0), this);
 	SphereMesh->SetMaterial(0, TargetColorChangeMaterial);
 
-	/* Start to Peak Target Color */
-	OnStartToPeak.BindDynamic(this, &ATarget::InterpStartToPeak);
-	StartToPeakTimeline.AddInterpFloat(StartToPeakCurve, OnStartToPeak);
-
-	/* Play InterpPeakToEnd when InterpStartToPeak is finished */
-	OnStartToPeakFinished.BindDynamic(this, &ATarget::PlayPeakToEndTimeline);
-	StartToPeakTimeline.SetTimelineFinishedFunc(OnStartToPeakFinished);
-
-	/* Peak Color to Fade Color */
-	OnPeakToFade.BindDynamic(this, &ATarget::InterpPeakToEnd);
-	PeakToEndTimeline.AddInterpFloat(PeakToEndCurve, OnPeakToFade);
-
 	/* Set the playback rates based on TargetMaxLifeSpan */
 	StartToPeakTimelinePlayRate = 1 / Config.SpawnBeatDelay;
 	PeakToEndTimelinePlayRate = 1 / (Config.TargetMaxLifeSpan - Config.SpawnBeatDelay);
-	StartToPeakTimeline.SetPlayRate(StartToPeakTimelinePlayRate);
-	PeakToEndTimeline.SetPlayRate(PeakToEndTimelinePlayRate);
-	ShrinkQuickAndGrowSlowTimeline.SetPlayRate(StartToPeakTimelinePlayRate);
 	
 	SetTargetColor(Config.OnSpawnColor);
 
@@ -170,13 +156,6 @@ void ATarget::BeginPlay()
 	{
 		SetUseSeparateOutlineColor(true);
 	}
-
-	if (Config.TargetDeactivationResponses.Contains(ETargetDeactivationResponse::ShrinkQuickGrowSlow))
-	{
-		/* Fade the target from ColorWhenDamageTaken to BeatGridInactiveColor */
-		OnShrinkQuickAndGrowSlow.BindDynamic(this, &ATarget::InterpShrinkQuickAndGrowSlow);
-		ShrinkQuickAndGrowSlowTimeline.AddInterpFloat(ShrinkQuickAndGrowSlowCurve, OnShrinkQuickAndGrowSlow);
-	}
 }
 
 void ATarget::PostInitializeComponents()
@@ -256,14 +235,6 @@ void ATarget::PostInitializeComponents()
 	}
 }
 
-void ATarget::Tick(float DeltaSeconds)
-{
-	Super::Tick(DeltaSeconds);
-	StartToPeakTimeline.TickTimeline(DeltaSeconds);
-	PeakToEndTimeline.TickTimeline(DeltaSeconds);
-	ShrinkQuickAndGrowSlowTimeline.TickTimeline(DeltaSeconds);
-}
-
 void ATarget::Init(const FBS_TargetConfig& InTargetConfig)
 {
 	Config = InTargetConfig;
@@ -447,8 +418,10 @@ void ATarget::ResetHealth()
 		FGameplayEffectContextHandle EffectContextHandle = Comp->MakeEffectContext();
 		EffectContextHandle.Get()->AddInstigator(this, this);
 		const FGameplayEffectSpecHandle Handle = Comp->MakeOutgoingSpec(GE_ResetHealth, 1.f, EffectContextHandle);
-		const FGameplayEffectSpec* Spec = Handle.Data.Get();
-		Comp->ApplyGameplayEffectSpecToSelf(*Spec);
+		if (const FGameplayEffectSpec* Spec = Handle.Data.Get())
+		{
+			Comp->ApplyGameplayEffectSpecToSelf(*Spec);
+		}
 	}
 }
 
@@ -499,77 +472,129 @@ void ATarget::CheckForHealthReset(const bool bOutOfHealth)
 	if (bUnlimitedHealth && bOutOfHealth) ResetHealth();
 }
 
-/* ------------------------ */
-/* -- Timeline Functions -- */
-/* ------------------------ */
-
-void ATarget::PlayStartToPeakTimeline()
+void ATarget::ReturnToPool()
 {
+	GetWorldTimerManager().ClearTimer(ExpirationTimer);
 	StopAllTimelines();
-	StartToPeakTimeline.PlayFromStart();
+
+	ProjectileMovementComponent->StopMovementImmediately();
+	ProjectileMovementComponent->InitialSpeed = 0.f;
+	ProjectileMovementComponent->SetComponentTickEnabled(false);
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	bIsCurrentlyActivated = false;
+	bIsPooled = true;
 }
 
-void ATarget::PlayPeakToEndTimeline()
+void ATarget::ReuseFromPool(const FTransform& InTransform)
 {
+	// Generates a new Guid, since the old one may still be referenced by recent spawn areas
+	Init(Config);
+
+	SetActorTransform(InTransform, false, nullptr, ETeleportType::ResetPhysics);
+	TargetScale_Spawn = GetActorScale();
+	TargetLocation_Spawn = GetActorLocation();
+	TargetScale_Activation = FVector::ZeroVector;
+	TargetScale_Deactivation = FVector::ZeroVector;
+	TargetLocation_Activation = FVector::ZeroVector;
+	ColorWhenDamageTaken = FLinearColor();
+	CurrentDeactivationHealthThreshold = Config.MaxHealth - Config.DeactivationHealthLostThreshold;
+	bLastDirectionChangeHorizontal = false;
+	bHasBeenActivated = false;
+	bIsCurrentlyActivated = false;
+
+	// Deferred until now since the target is returned to the pool from inside a damage event
+	RemoveImmunityEffect();
+	ResetHealth();
 	StopAllTimelines();
-	PeakToEndTimeline.PlayFromStart();
+	SetTargetColor(Config.OnSpawnColor);
+
+	if (Config.MovingTargetDirectionMode != EMovingTargetDirectionMode::None)
+	{
+		ProjectileMovementComponent->SetComponentTickEnabled(true);
+	}
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	bIsPooled = false;
 }
 
-void ATarget::PlayShrinkQuickAndGrowSlowTimeline()
+/* ------------------------- */
+/* -- Animation Functions -- */
+/* ------------------------- */
+
+void ATarget::PlayStartToPeakTimeline()
 {
-	StopAllTimelines();
-	ShrinkQuickAndGrowSlowTimeline.PlayFromStart();
+	const TSharedPtr<FTargetAnimationManager> Manager = AnimationManager.Pin();
+	if (!Manager) return;
+
+	FTargetAnimationParams Params;
+	Params.Animation = ETargetAnimation::StartToPeak;
+	Params.PlayRate = StartToPeakTimelinePlayRate;
+	Params.ColorFrom = Config.StartColor;
+	Params.ColorTo = Config.PeakColor;
+	Params.bAnimateScale = bApplyLifetimeTargetScaling;
+	Params.ScaleFrom = GetTargetScale_Deactivation().X;
+	Params.ScaleTo = Params.ScaleFrom * Config.LifetimeTargetScaleMultiplier;
+	Params.ScaleAlphaMultiplier = Config.SpawnBeatDelay / Config.TargetMaxLifeSpan;
+	Manager->Play(this, Params);
 }
 
-void ATarget::StopAllTimelines()
+void ATarget::PlayPeakToEndTimeline()
 {
-	if (StartToPeakTimeline.IsPlaying())
-	{
-		StartToPeakTimeline.Stop();
-	}
-	if (PeakToEndTimeline.IsPlaying())
-	{
-		PeakToEndTimeline.Stop();
-	}
-	if (ShrinkQuickAndGrowSlowTimeline.IsPlaying())
-	{
-		ShrinkQuickAndGrowSlowTimeline.Stop();
-	}
-}
+	const TSharedPtr<FTargetAnimationManager> Manager = AnimationManager.Pin();
+	if (!Manager) return;
 
-/* ------------------------ */
-/* -- Timeline Callbacks -- */
-/* ------------------------ */
+	FTargetAnimationParams Params;
+	Params.Animation = ETargetAnimation::PeakToEnd;
+	Params.PlayRate = PeakToEndTimelinePlayRate;
+	Params.ColorFrom = Config.PeakColor;
+	Params.ColorTo = Config.EndColor;
+	Params.bAnimateScale = bApplyLifetimeTargetScaling;
+	Params.ScaleFrom = GetTargetScale_Deactivation().X;
+	Params.ScaleTo = Params.ScaleFrom * Config.LifetimeTargetScaleMultiplier;
+	Params.ScaleAlphaOffset = Config.SpawnBeatDelay / Config.TargetMaxLifeSpan;
+	Params.ScaleAlphaMultiplier = (Config.TargetMaxLifeSpan - Config.SpawnBeatDelay) / Config.TargetMaxLifeSpan;
+	Manager->Play(this, Params);
+}
 
-void ATarget::InterpStartToPeak(const float Alpha)
+void ATarget::PlayShrinkQuickAndGrowSlowTimeline()
 {
-	SetTargetColor(UKismetMathLibrary::LinearColorLerp(Config.StartColor, Config.PeakColor, Alpha));
-	if (bApplyLifetimeTargetScaling)
-	{
-		SetTargetScale(FVector(UKismetMathLibrary::Lerp(GetTargetScale_Deactivation().X,
-			GetTargetScale_Deactivation().X * Config.LifetimeTargetScaleMultiplier,
-			StartToPeakTimeline.GetPlaybackPosition() * Config.SpawnBeatDelay / Config.TargetMaxLifeSpan)));
-	}
+	const TSharedPtr<FTargetAnimationManager> Manager = AnimationManager.Pin();
+	if (!Manager) return;
+
+	// Fade the target from ColorWhenDamageTaken to InactiveTargetColor while the scale follows the curve
+	FTargetAnimationParams Params;
+	Params.Animation = ETargetAnimation::ShrinkQuickAndGrowSlow;
+	Params.PlayRate = StartToPeakTimelinePlayRate;
+	Params.ColorFrom = ColorWhenDamageTaken;
+	Params.ColorTo = Config.InactiveTargetColor;
+	Params.bColorFollowsCurve = false;
+	Params.bAnimateScale = true;
+	Params.bScaleFollowsCurve = true;
+	Params.ScaleFrom = Constants::MinShrinkTargetScale;
+	Params.ScaleTo = GetTargetScale_Activation().X;
+	Manager->Play(this, Params);
 }
 
-void ATarget::InterpPeakToEnd(const float Alpha)
+void ATarget::StopAllTimelines()
 {
-	SetTargetColor(UKismetMathLibrary::LinearColorLerp(Config.PeakColor, Config.EndColor, Alpha));
-	if (bApplyLifetimeTargetScaling)
+	if (const TSharedPtr<FTargetAnimationManager> Manager = AnimationManager.Pin())
 	{
-		SetTargetScale(FVector(UKismetMathLibrary::Lerp(GetTargetScale_Deactivation().X,
-			GetTargetScale_Deactivation().X * Config.LifetimeTargetScaleMultiplier,
-			(PeakToEndTimeline.GetPlaybackPosition() * (Config.TargetMaxLifeSpan - Config.SpawnBeatDelay) + Config.
-				SpawnBeatDelay) / Config.TargetMaxLifeSpan)));
+		Manager->Stop(this);
 	}
 }
 
-void ATarget::InterpShrinkQuickAndGrowSlow(const float Alpha)
+void ATarget::OnAnimationFinished(const ETargetAnimation Animation)
 {
-	SetTargetScale(FVector(UKismetMathLibrary::Lerp(Constants::MinShrinkTargetScale, GetTargetScale_Activation().X, Alpha)));
-	const FLinearColor Color = UKismetMathLibrary::LinearColorLerp(ColorWhenDamageTaken, Config.InactiveTargetColor,
-		ShrinkQuickAndGrowSlowTimeline.GetPlaybackPosition());
-	SetTargetColor(Color);
+	if (Animation == ETargetAnimation::StartToPeak)
+	{
+		PlayPeakToEndTimeline();
+	}
 }
 
 /* ---------------------- */
@@ -0,0 +1,215 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "Target/TargetAnimationManager.h"
+#include "Target/Target.h"
+#include "Curves/CurveFloat.h"
+
+void FBakedTargetCurve::Bake(const UCurveFloat* Curve)
+{
+	Samples.Reset();
+	EndTime = 0.f;
+	if (!Curve) return;
+
+	float MinTime = 0.f;
+	Curve->GetTimeRange(MinTime, EndTime);
+	EndTime = FMath::Max(EndTime, 0.f);
+
+	Samples.SetNumUninitialized(NumSamples);
+	for (int i = 0; i < NumSamples; i++)
+	{
+		Samples[i] = Curve->GetFloatValue(EndTime * i / (NumSamples - 1));
+	}
+}
+
+float FBakedTargetCurve::Evaluate(const float Time) const
+{
+	if (Samples.IsEmpty()) return 0.f;
+	if (EndTime <= 0.f) return Samples.Last();
+
+	const float Position = FMath::Clamp(Time / EndTime, 0.f, 1.f) * (Samples.Num() - 1);
+	const int32 Index = FMath::Min(FMath::FloorToInt32(Position), Samples.Num() - 2);
+	return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - Index);
+}
+
+void FTargetAnimationManager::Play(ATarget* InTarget, const FTargetAnimationParams& Params)
+{
+	if (!InTarget) return;
+
+	if (!bCurvesBaked)
+	{
+		BakeCurves(InTarget);
+	}
+	if (!Curves[static_cast<int32>(Params.Animation)].IsValid())
+	{
+		Stop(InTarget);
+		return;
+	}
+
+	int32 Index;
+	if (const int32* Found = TargetIndices.Find(InTarget))
+	{
+		Index = *Found;
+	}
+	else
+	{
+		Index = Targets.Add(InTarget);
+		TargetIndices.Add(InTarget, Index);
+		Animations.AddDefaulted();
+		Positions.AddDefaulted();
+		EndTimes.AddDefaulted();
+		PlayRates.AddDefaulted();
+		Alphas.AddDefaulted();
+		ColorsFrom.AddDefaulted();
+		ColorsTo.AddDefaulted();
+		Colors.AddDefaulted();
+		ScalesFrom.AddDefaulted();
+		ScalesTo.AddDefaulted();
+		ScaleAlphaOffsets.AddDefaulted();
+		ScaleAlphaMultipliers.AddDefaulted();
+		Scales.AddDefaulted();
+		ColorFollowsCurve.AddDefaulted();
+		ScaleFollowsCurve.AddDefaulted();
+		AnimateScale.AddDefaulted();
+	}
+
+	Animations[Index] = Params.Animation;
+	Positions[Index] = 0.f;
+	EndTimes[Index] = Curves[static_cast<int32>(Params.Animation)].EndTime;
+	PlayRates[Index] = Params.PlayRate;
+	ColorsFrom[Index] = Params.ColorFrom;
+	ColorsTo[Index] = Params.ColorTo;
+	ScalesFrom[Index] = Params.ScaleFrom;
+	ScalesTo[Index] = Params.ScaleTo;
+	ScaleAlphaOffsets[Index] = Params.ScaleAlphaOffset;
+	ScaleAlphaMultipliers[Index] = Params.ScaleAlphaMultiplier;
+	ColorFollowsCurve[Index] = Params.bColorFollowsCurve;
+	ScaleFollowsCurve[Index] = Params.bScaleFollowsCurve;
+	AnimateScale[Index] = Params.bAnimateScale;
+}
+
+void FTargetAnimationManager::Stop(const ATarget* InTarget)
+{
+	if (const int32* Found = TargetIndices.Find(InTarget))
+	{
+		RemoveAtSwap(*Found);
+	}
+}
+
+bool FTargetAnimationManager::IsPlaying(const ATarget* InTarget, const ETargetAnimation InAnimation) const
+{
+	const int32* Found = TargetIndices.Find(InTarget);
+	return Found && Animations[*Found] == InAnimation;
+}
+
+void FTargetAnimationManager::Tick(const float DeltaTime)
+{
+	const int32 NumAnimating = Targets.Num();
+	if (NumAnimating == 0) return;
+
+	// Advance playback positions, stopping at the end of the curve like FTimeline
+	for (int i = 0; i < NumAnimating; i++)
+	{
+		Positions[i] = FMath::Min(Positions[i] + DeltaTime * PlayRates[i], EndTimes[i]);
+	}
+
+	for (int i = 0; i < NumAnimating; i++)
+	{
+		Alphas[i] = Curves[static_cast<int32>(Animations[i])].Evaluate(Positions[i]);
+	}
+
+	for (int i = 0; i < NumAnimating; i++)
+	{
+		const float ColorAlpha = ColorFollowsCurve[i] ? Alphas[i] : Positions[i];
+		Colors[i] = ColorsFrom[i] + (ColorsTo[i] - ColorsFrom[i]) * ColorAlpha;
+	}
+
+	for (int i = 0; i < NumAnimating; i++)
+	{
+		const float ScaleAlpha = ScaleAlphaOffsets[i] + ScaleAlphaMultipliers[i] *
+			(ScaleFollowsCurve[i] ? Alphas[i] : Positions[i]);
+		Scales[i] = FMath::Lerp(ScalesFrom[i], ScalesTo[i], ScaleAlpha);
+	}
+
+	for (int i = 0; i < NumAnimating; i++)
+	{
+		Targets[i]->SetTargetColor(Colors[i]);
+		if (AnimateScale[i])
+		{
+			Targets[i]->SetTargetScale(FVector(Scales[i]));
+		}
+	}
+
+	// Remove finished animations before notifying, since targets can start another animation when notified
+	TArray<TPair<ATarget*, ETargetAnimation>, TInlineAllocator<8>> Finished;
+	for (int i = NumAnimating - 1; i >= 0; i--)
+	{
+		if (Positions[i] >= EndTimes[i])
+		{
+			Finished.Emplace(Targets[i], Animations[i]);
+			RemoveAtSwap(i);
+		}
+	}
+	for (const TPair<ATarget*, ETargetAnimation>& Pair : Finished)
+	{
+		Pair.Key->OnAnimationFinished(Pair.Value);
+	}
+}
+
+void FTargetAnimationManager::Clear()
+{
+	TargetIndices.Empty();
+	Targets.Empty();
+	Animations.Empty();
+	Positions.Empty();
+	EndTimes.Empty();
+	PlayRates.Empty();
+	Alphas.Empty();
+	ColorsFrom.Empty();
+	ColorsTo.Empty();
+	Colors.Empty();
+	ScalesFrom.Empty();
+	ScalesTo.Empty();
+	ScaleAlphaOffsets.Empty();
+	ScaleAlphaMultipliers.Empty();
+	Scales.Empty();
+	ColorFollowsCurve.Empty();
+	ScaleFollowsCurve.Empty();
+	AnimateScale.Empty();
+}
+
+void FTargetAnimationManager::BakeCurves(const ATarget* InTarget)
+{
+	Curves[static_cast<int32>(ETargetAnimation::StartToPeak)].Bake(InTarget->StartToPeakCurve);
+	Curves[static_cast<int32>(ETargetAnimation::PeakToEnd)].Bake(InTarget->PeakToEndCurve);
+	Curves[static_cast<int32>(ETargetAnimation::ShrinkQuickAndGrowSlow)].Bake(InTarget->ShrinkQuickAndGrowSlowCurve);
+	bCurvesBaked = true;
+}
+
+void FTargetAnimationManager::RemoveAtSwap(const int32 Index)
+{
+	const int32 LastIndex = Targets.Num() - 1;
+	TargetIndices.Remove(Targets[Index]);
+	if (Index != LastIndex)
+	{
+		TargetIndices[Targets[LastIndex]] = Index;
+	}
+
+	Targets.RemoveAtSwap(Index, 1, false);
+	Animations.RemoveAtSwap(Index, 1, false);
+	Positions.RemoveAtSwap(Index, 1, false);
+	EndTimes.RemoveAtSwap(Index, 1, false);
+	PlayRates.RemoveAtSwap(Index, 1, false);
+	Alphas.RemoveAtSwap(Index, 1, false);
+	ColorsFrom.RemoveAtSwap(Index, 1, false);
+	ColorsTo.RemoveAtSwap(Index, 1, false);
+	Colors.RemoveAtSwap(Index, 1, false);
+	ScalesFrom.RemoveAtSwap(Index, 1, false);
+	ScalesTo.RemoveAtSwap(Index, 1, false);
+	ScaleAlphaOffsets.RemoveAtSwap(Index, 1, false);
+	ScaleAlphaMultipliers.RemoveAtSwap(Index, 1, false);
+	Scales.RemoveAtSwap(Index, 1, false);
+	ColorFollowsCurve.RemoveAtSwap(Index, 1, false);
+	ScaleFollowsCurve.RemoveAtSwap(Index, 1, false);
+	AnimateScale.RemoveAtSwap(Index, 1, false);
+}
@@ -6,16 +6,79 @@
 #include "BSGameMode.h"
 #include "GlobalConstants.h"
 #include "Target/Target.h"
+#include "Target/TargetAnimationManager.h"
+#include "Target/BeatLatencyRecorder.h"
 #include "Components/BoxComponent.h"
 #include "Engine/CompositeCurveTable.h"
 #include "Kismet/DataTableFunctionLibrary.h"
 #include "Target/ReinforcementLearningComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Target/SpawnAreaManagerComponent.h"
+#include "EngineUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 
 FVector (&RandBoxPoint)(const FVector Center, const FVector Extents) = UKismetMathLibrary::RandomPointInBoundingBox;
 DEFINE_LOG_CATEGORY(LogTargetManager);
 
+DECLARE_STATS_GROUP(TEXT("BeatShot TargetManager"), STATGROUP_BSTargetManager, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("OnAudioAnalyzerBeat"), STAT_OnAudioAnalyzerBeat, STATGROUP_BSTargetManager);
+DECLARE_CYCLE_STAT(TEXT("HandleRuntimeSpawning"), STAT_HandleRuntimeSpawning, STATGROUP_BSTargetManager);
+DECLARE_CYCLE_STAT(TEXT("GetTargetSpawnParams"), STAT_GetTargetSpawnParams, STATGROUP_BSTargetManager);
+DECLARE_CYCLE_STAT(TEXT("SpawnTargets"), STAT_SpawnTargets, STATGROUP_BSTargetManager);
+DECLARE_CYCLE_STAT(TEXT("HandleTargetActivation"), STAT_HandleTargetActivation, STATGROUP_BSTargetManager);
+DECLARE_CYCLE_STAT(TEXT("DrawDebug"), STAT_TargetManagerDrawDebug, STATGROUP_BSTargetManager);
+
+#if !UE_BUILD_SHIPPING
+/** Adds the wall time of the enclosing scope to a field of the beat being recorded by BeatLatencyRecorder */
+#define BS_BEAT_LATENCY_SCOPE(Field) \
+const FBeatLatencyScope ANONYMOUS_VARIABLE(BeatLatencyScope_)(BeatLatencyRecorder->Current().Field)
+
+/** Sets a field of the beat being recorded by BeatLatencyRecorder */
+#define BS_BEAT_LATENCY_SET(Field, Value) BeatLatencyRecorder->Current().Field = (Value)
+
+namespace BeatLatencyCVars
+{
+	static TAutoConsoleVariable CVarCsvOnGameModeEnd(TEXT("bs_beatlatency.csvongameend"), true,
+		TEXT("Write the per-beat latency of the TargetManager to Saved/Profiling/BeatLatency when a game mode ends."),
+		ECVF_Default);
+
+	/** Calls Function on every TargetManager in World */
+	static void ForEachTargetManager(const UWorld* World, const TFunctionRef<void(const ATargetManager*)> Function)
+	{
+		if (!World) return;
+		for (TActorIterator<ATargetManager> It(World); It; ++It)
+		{
+			Function(*It);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdDump(TEXT("bs_beatlatency.dump"),
+		TEXT("Logs the average and maximum per-beat latency of the TargetManager. Optional arg: number of beats."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, const UWorld* World)
+		{
+			const int32 NumBeats = Args.IsEmpty() ? 0 : FCString::Atoi(*Args[0]);
+			ForEachTargetManager(World, [NumBeats](const ATargetManager* TargetManager)
+			{
+				TargetManager->LogBeatLatencySummary(NumBeats);
+			});
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdCsv(TEXT("bs_beatlatency.csv"),
+		TEXT("Writes the per-beat latency of the TargetManager to Saved/Profiling/BeatLatency."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, const UWorld* World)
+		{
+			ForEachTargetManager(World, [](const ATargetManager* TargetManager)
+			{
+				TargetManager->WriteBeatLatencyCsv();
+			});
+		}));
+}
+#else
+#define BS_BEAT_LATENCY_SCOPE(Field)
+#define BS_BEAT_LATENCY_SET(Field, Value)
+#endif
+
 using namespace Constants;
 using namespace BSCommon;
 
@@ -51,30 +114,17 @@ ATargetManager::ATargetManager()
 	DynamicLookUpValue_TargetScale = 0;
 	DynamicLookUpValue_SpawnAreaScale = 0;
 	ManagedTargets = TMap<FGuid, ATarget*>();
+	TargetAnimationManager = MakeShared<FTargetAnimationManager>();
 	TotalPossibleDamage = 0.f;
 	bLastSpawnedTargetDirectionHorizontal = false;
 	bLastActivatedTargetDirectionHorizontal = false;
 
 	#if !UE_BUILD_SHIPPING
+	BeatLatencyRecorder = MakeShared<FBeatLatencyRecorder>();
 	bShowDebug_AnyMovingTargetDirectionMode = false;
 	#endif
 }
 
-void ATargetManager::BeginPlay()
-{
-	Super::BeginPlay();
-
-	TargetSpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	TargetSpawnInfo.Owner = this;
-	TargetSpawnInfo.CustomPreSpawnInitalization = [this] (AActor* SpawnedActor)
-	{
-		if (ATarget* Target = Cast<ATarget>(SpawnedActor))
-		{
-			Target->Init(BSConfig->TargetConfig);
-		}
-	};
-}
-
 void ATargetManager::Destroyed()
 {
 	SetShouldSpawn(false);
@@ -85,6 +135,7 @@ void ATargetManager::Destroyed()
 void ATargetManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+	TargetAnimationManager->Tick(DeltaTime);
 	if (ShouldSpawn && TrackingTargetIsDamageable())
 	{
 		UpdateTotalPossibleDamage();
@@ -133,7 +184,11 @@ void ATargetManager::Init(const TSharedPtr<FBSConfig>& InConfig, const FCommonSc
 	// Init RLC
 	if (BSConfig->IsCompatibleWithReinforcementLearning())
 	{
-		const FRLAgentParams Params(BSConfig->AIConfig, InCommonScoreInfo, SpawnAreaManager->GetSpawnAreaSize());
+		FRLAgentParams Params(BSConfig->AIConfig, InCommonScoreInfo, SpawnAreaManager->GetSpawnAreaSize());
+		if (!GIsAutomationTesting)
+		{
+			Params.ExperienceLogPath = FRLExperienceLog::GetFilePath(BSConfig->DefiningConfig);
+		}
 		RLComponent->Init(Params);
 
 		// Bind the SpawnAreaManager to the RLComponent if it should request activation locations
@@ -161,6 +216,9 @@ void ATargetManager::Init(const TSharedPtr<FBSConfig>& InConfig, const FCommonSc
 	
 	RandomNumToActivateStream.Initialize(FMath::Rand());
 
+	// Pre-spawn targets so that runtime spawning does not need to spawn actors
+	InitTargetPool();
+
 	// Spawn any targets if needed
 	if (BSConfig->TargetConfig.TargetSpawningPolicy == ETargetSpawningPolicy::UpfrontOnly)
 	{
@@ -216,6 +274,10 @@ void ATargetManager::Clear()
 	
 	RLComponent->Clear();
 	SpawnAreaManager->Clear();
+
+	#if !UE_BUILD_SHIPPING
+	BeatLatencyRecorder->Reset();
+	#endif
 }
 
 void ATargetManager::SetShouldSpawn(const bool bShouldSpawn)
@@ -251,6 +313,11 @@ void ATargetManager::OnPlayerStopTrackingTarget()
 void ATargetManager::OnAudioAnalyzerBeat()
 {
 	if (!ShouldSpawn) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_OnAudioAnalyzerBeat);
+	#if !UE_BUILD_SHIPPING
+	BeatLatencyRecorder->BeginBeat(GetWorld()->GetTimeSeconds());
+	#endif
 	
 	const int32 LastSeed = RandomNumToActivateStream.GetCurrentSeed();
 	HandleRuntimeSpawning();
@@ -259,46 +326,62 @@ void ATargetManager::OnAudioAnalyzerBeat()
 	
 	#if !UE_BUILD_SHIPPING
 	DrawDebug();
+	BS_BEAT_LATENCY_SET(NumManagedTargets, ManagedTargets.Num());
+	BeatLatencyRecorder->EndBeat();
 	#endif
 }
 
-ATarget* ATargetManager::SpawnTarget(const FTargetSpawnParams& Params)
+TArray<ATarget*> ATargetManager::SpawnTargets(const TSet<FTargetSpawnParams>& SpawnParams)
 {
-	ATarget* Target = GetWorld()->SpawnActor<ATarget>(TargetToSpawn, Params.Transform(), TargetSpawnInfo);
-	
-	#if !UE_BUILD_SHIPPING
-	if (GIsAutomationTesting) Target->DispatchBeginPlay();
-	#endif
-	
-	Target->SetTargetDamageType(FindNextTargetDamageType());
-	Target->OnTargetDamageEvent.AddUObject(this, &ATargetManager::OnTargetDamageEvent);
-	AddToManagedTargets(Target, Params.SpawnAreaIndex);
+	if (SpawnParams.IsEmpty()) return TArray<ATarget*>();
 
-	if (!Target) return nullptr;
-	
-	// Handle spawn responses
-	if (BSConfig->TargetConfig.TargetSpawnResponses.Contains(ETargetSpawnResponse::AddImmunity))
+	SCOPE_CYCLE_COUNTER(STAT_SpawnTargets);
+	BS_BEAT_LATENCY_SCOPE(SpawnTargetsMs);
+
+	TArray<FTransform> Transforms;
+	Transforms.Reserve(SpawnParams.Num());
+	for (const FTargetSpawnParams& Params : SpawnParams)
 	{
-		Target->ApplyImmunityEffect();
+		Transforms.Add(Params.Transform());
 	}
-	if (BSConfig->TargetConfig.TargetSpawnResponses.Contains(ETargetSpawnResponse::ChangeVelocity))
+	TArray<ATarget*> Targets = TakeTargetsFromPool(Transforms);
+
+	// Spawn responses are the same for every target in the batch
+	const FBS_TargetConfig& Cfg = BSConfig->TargetConfig;
+	const bool bAddImmunity = Cfg.TargetSpawnResponses.Contains(ETargetSpawnResponse::AddImmunity);
+	const bool bChangeVelocity = Cfg.TargetSpawnResponses.Contains(ETargetSpawnResponse::ChangeVelocity);
+	const bool bChangeDirection = Cfg.TargetSpawnResponses.Contains(ETargetSpawnResponse::ChangeDirection);
+
+	// In case no direction change is provided
+	const bool bDirectionFromVelocity = bChangeVelocity && !bChangeDirection &&
+		Cfg.MovingTargetDirectionMode != EMovingTargetDirectionMode::None;
+
+	int32 Index = 0;
+	for (const FTargetSpawnParams& Params : SpawnParams)
 	{
-		const float SpawnVelocity = FMath::FRandRange(BSConfig->TargetConfig.MinSpawnedTargetSpeed,
-			BSConfig->TargetConfig.MaxSpawnedTargetSpeed);
-		Target->SetTargetSpeed(SpawnVelocity);
+		ATarget* Target = Targets[Index++];
+		if (!Target) continue;
 
-		// In case no direction change is provided
-		if (!BSConfig->TargetConfig.TargetSpawnResponses.Contains(ETargetSpawnResponse::ChangeDirection)
-			&& BSConfig->TargetConfig.MovingTargetDirectionMode != EMovingTargetDirectionMode::None)
+		Target->SetTargetDamageType(FindNextTargetDamageType());
+		AddToManagedTargets(Target, Params.SpawnAreaIndex);
+
+		// Handle spawn responses
+		if (bAddImmunity)
+		{
+			Target->ApplyImmunityEffect();
+		}
+		if (bChangeVelocity)
+		{
+			Target->SetTargetSpeed(FMath::FRandRange(Cfg.MinSpawnedTargetSpeed, Cfg.MaxSpawnedTargetSpeed));
+		}
+		if (bChangeDirection || bDirectionFromVelocity)
 		{
 			ChangeTargetDirection(Target, 0);
 		}
 	}
-	if (BSConfig->TargetConfig.TargetSpawnResponses.Contains(ETargetSpawnResponse::ChangeDirection))
-	{
-		ChangeTargetDirection(Target, 0);
-	}
-	return Target;
+
+	Targets.Remove(nullptr);
+	return Targets;
 }
 
 void ATargetManager::AddToManagedTargets(ATarget* SpawnTarget, const int32 SpawnAreaIndex)
@@ -307,6 +390,120 @@ void ATargetManager::AddToManagedTargets(ATarget* SpawnTarget, const int32 Spawn
 	SpawnAreaManager->FlagSpawnAreaAsManaged(SpawnAreaIndex, SpawnTarget->GetGuid());
 }
 
+TArray<ATarget*> ATargetManager::CreateTargets(const TArray<FTransform>& Transforms)
+{
+	TArray<ATarget*> Targets;
+	Targets.Reserve(Transforms.Num());
+
+	// Construct and initialize every target before running component initialization for any of them
+	for (const FTransform& Transform : Transforms)
+	{
+		ATarget* Target = GetWorld()->SpawnActorDeferred<ATarget>(TargetToSpawn, Transform, this, nullptr,
+			ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (Target)
+		{
+			Target->Init(BSConfig->TargetConfig);
+		}
+		Targets.Add(Target);
+	}
+
+	for (int i = 0; i < Targets.Num(); i++)
+	{
+		ATarget* Target = Targets[i];
+		if (!Target) continue;
+
+		Target->FinishSpawning(Transforms[i]);
+
+		#if !UE_BUILD_SHIPPING
+		if (GIsAutomationTesting) Target->DispatchBeginPlay();
+		#endif
+
+		// Only bound once, since the target keeps its delegates while it sits in the pool
+		Target->OnTargetDamageEvent.AddUObject(this, &ATargetManager::OnTargetDamageEvent);
+		Target->SetAnimationManager(TargetAnimationManager);
+	}
+	return Targets;
+}
+
+TArray<ATarget*> ATargetManager::TakeTargetsFromPool(const TArray<FTransform>& Transforms)
+{
+	TArray<ATarget*> Targets;
+	Targets.Init(nullptr, Transforms.Num());
+
+	TArray<int32> IndicesToCreate;
+	TArray<FTransform> TransformsToCreate;
+	for (int i = 0; i < Transforms.Num(); i++)
+	{
+		while (!TargetPool.IsEmpty() && !Targets[i])
+		{
+			ATarget* Target = TargetPool.Pop(false);
+			if (IsValid(Target))
+			{
+				Target->ReuseFromPool(Transforms[i]);
+				Targets[i] = Target;
+			}
+		}
+		if (!Targets[i])
+		{
+			IndicesToCreate.Add(i);
+			TransformsToCreate.Add(Transforms[i]);
+		}
+	}
+
+	if (!IndicesToCreate.IsEmpty())
+	{
+		const TArray<ATarget*> Created = CreateTargets(TransformsToCreate);
+		for (int i = 0; i < Created.Num(); i++)
+		{
+			Targets[IndicesToCreate[i]] = Created[i];
+		}
+	}
+	return Targets;
+}
+
+void ATargetManager::ReturnTargetToPool(ATarget* InTarget)
+{
+	if (!IsValid(InTarget) || InTarget->IsPooled()) return;
+	
+	InTarget->ReturnToPool();
+	TargetPool.Add(InTarget);
+}
+
+void ATargetManager::InitTargetPool()
+{
+	const int32 PoolSize = GetTargetPoolSize();
+	if (PoolSize <= TargetPool.Num()) return;
+
+	TArray<FTransform> Transforms;
+	Transforms.Init(FTransform(GetSpawnBoxOrigin()), PoolSize - TargetPool.Num());
+	TargetPool.Reserve(PoolSize);
+	for (ATarget* Target : CreateTargets(Transforms))
+	{
+		if (Target)
+		{
+			ReturnTargetToPool(Target);
+		}
+	}
+}
+
+int32 ATargetManager::GetTargetPoolSize() const
+{
+	const auto& Cfg = BSConfig->TargetConfig;
+
+	// Upfront targets are spawned once, and only need the pool if they are destroyed and respawned
+	if (Cfg.TargetSpawningPolicy != ETargetSpawningPolicy::RuntimeOnly) return 0;
+
+	if (Cfg.MaxNumTargetsAtOnce > 0)
+	{
+		return FMath::Min(Cfg.MaxNumTargetsAtOnce, MaxInitialTargetPoolSize);
+	}
+
+	// No limit on the number of targets, so allow a few beats worth of targets to be alive at once
+	const int32 NumPerBeat = FMath::Max(1, Cfg.NumRuntimeTargetsToSpawn);
+	const int32 NumActivated = FMath::Max(Cfg.MaxNumActivatedTargetsAtOnce, Cfg.MaxNumTargetsToActivateAtOnce);
+	return FMath::Min(FMath::Max(NumPerBeat * 4, NumActivated), MaxInitialTargetPoolSize);
+}
+
 bool ATargetManager::ActivateTarget(ATarget* InTarget) const
 {
 	if (!InTarget || SpawnAreaManager->GetSpawnAreaIndex(InTarget->GetGuid()) < 0)
@@ -547,15 +744,7 @@ int32 ATargetManager::HandleUpfrontSpawning()
 {
 	if (BSConfig->TargetConfig.TargetSpawningPolicy != ETargetSpawningPolicy::UpfrontOnly) return 0;
 
-	int32 NumSpawned = 0;
-	for (const FTargetSpawnParams& Params : GetTargetSpawnParams(GetNumberOfTargetsToSpawn()))
-	{
-		if (SpawnTarget(Params))
-		{
-			NumSpawned++;
-		}
-	}
-	return NumSpawned;
+	return SpawnTargets(GetTargetSpawnParams(GetNumberOfTargetsToSpawn())).Num();
 }
 
 int32 ATargetManager::HandleRuntimeSpawning()
@@ -563,6 +752,9 @@ int32 ATargetManager::HandleRuntimeSpawning()
 	const auto& Cfg = BSConfig->TargetConfig;
 	
 	if (Cfg.TargetSpawningPolicy != ETargetSpawningPolicy::RuntimeOnly) return 0;
+
+	SCOPE_CYCLE_COUNTER(STAT_HandleRuntimeSpawning);
+	BS_BEAT_LATENCY_SCOPE(RuntimeSpawningMs);
 	
 	int32 NumberToSpawn = GetNumberOfTargetsToSpawn();
 
@@ -578,20 +770,18 @@ int32 ATargetManager::HandleRuntimeSpawning()
 		NumberToSpawn = GetNumberOfTargetsToActivate(MaxAvailable, SpawnAreaManager->GetNumActivated());
 	}
 	
-	int32 NumSpawned = 0;
-	for (const FTargetSpawnParams& Params : GetTargetSpawnParams(NumberToSpawn))
+	const TSet<FTargetSpawnParams> SpawnParams = GetTargetSpawnParams(NumberToSpawn);
+	const int32 NumSpawned = SpawnTargets(SpawnParams).Num();
+	BS_BEAT_LATENCY_SET(NumToSpawn, NumberToSpawn);
+	BS_BEAT_LATENCY_SET(NumSpawnCandidates, SpawnParams.Num());
+	BS_BEAT_LATENCY_SET(NumSpawned, NumSpawned);
+
+	#if !UE_BUILD_SHIPPING
+	if (NumSpawned < SpawnParams.Num())
 	{
-		if (SpawnTarget(Params))
-		{
-			NumSpawned++;
-		}
-		else
-		{
-			#if !UE_BUILD_SHIPPING
-			UE_LOG(LogTargetManager, Warning, TEXT("Failed to spawn target."));
-			#endif
-		}
+		UE_LOG(LogTargetManager, Warning, TEXT("Failed to spawn %d target(s)."), SpawnParams.Num() - NumSpawned);
 	}
+	#endif
 
 	return NumSpawned;
 }
@@ -600,6 +790,9 @@ int32 ATargetManager::HandleTargetActivation() const
 {
 	if (ManagedTargets.IsEmpty()) return 0;
 
+	SCOPE_CYCLE_COUNTER(STAT_HandleTargetActivation);
+	BS_BEAT_LATENCY_SCOPE(TargetActivationMs);
+
 	const auto& Cfg = BSConfig->TargetConfig;
 	
 	// See if theres any Spawn Areas available to activate
@@ -644,8 +837,12 @@ int32 ATargetManager::HandleTargetActivation() const
 		NumToActivate = 1;
 	}
 
+	const TSet<FGuid> ActivatableTargets = SpawnAreaManager->GetActivatableTargets(NumToActivate);
+	BS_BEAT_LATENCY_SET(NumToActivate, NumToActivate);
+	BS_BEAT_LATENCY_SET(NumActivationCandidates, ActivatableTargets.Num());
+
 	int32 NumActivated = 0;
-	for (const FGuid& TargetGuid : SpawnAreaManager->GetActivatableTargets(NumToActivate))
+	for (const FGuid& TargetGuid : ActivatableTargets)
 	{
 		if (const auto Target = ManagedTargets.Find(TargetGuid))
 		{
@@ -667,6 +864,7 @@ int32 ATargetManager::HandleTargetActivation() const
 			#endif
 		}
 	}
+	BS_BEAT_LATENCY_SET(NumActivated, NumActivated);
 	return NumActivated;
 }
 
@@ -756,6 +954,9 @@ FVector ATargetManager::FindNextSpawnedTargetScale() const
 TSet<FTargetSpawnParams> ATargetManager::GetTargetSpawnParams(const int32 NumToSpawn) const
 {
 	if (NumToSpawn == 0) return {};
+
+	SCOPE_CYCLE_COUNTER(STAT_GetTargetSpawnParams);
+	BS_BEAT_LATENCY_SCOPE(GetTargetSpawnParamsMs);
 	
 	// Change the BoxExtent of the SpawnBox if dynamic
 	if (BSConfig->TargetConfig.BoundsScalingPolicy == EBoundsScalingPolicy::Dynamic)
@@ -850,7 +1051,7 @@ void ATargetManager::OnTargetDamageEvent(FTargetDamageEvent& Event)
 	if (Event.bWillDestroy)
 	{
 		RemoveFromManagedTargets(Event.Guid);
-		Event.Target->Destroy();
+		ReturnTargetToPool(Event.Target);
 	}
 	
 	// TODO Immediately spawn targets if ...?
@@ -1343,8 +1544,8 @@ float ATargetManager::GetMaxTargetDiameter(const FBS_TargetConfig& InTargetCfg)
 
 void ATargetManager::DestroyTargets()
 {
-	if (ManagedTargets.IsEmpty()) return;
-	
+	TargetAnimationManager->Clear();
+
 	for (const auto Pair : ManagedTargets.Array())
 	{
 		if (Pair.Value)
@@ -1353,6 +1554,15 @@ void ATargetManager::DestroyTargets()
 		}
 	}
 	ManagedTargets.Empty();
+
+	for (ATarget* Target : TargetPool)
+	{
+		if (IsValid(Target))
+		{
+			Target->Destroy();
+		}
+	}
+	TargetPool.Empty();
 }
 
 void ATargetManager::GetMovingTargetLocations(FMovingTargetLocations& MovingTargetLocations) const
@@ -1375,6 +1585,13 @@ void ATargetManager::UpdatePlayerSettings(const FPlayerSettings_Game& InPlayerSe
 			Pair.Value->UpdatePlayerSettings(InPlayerSettings);
 		}
 	}
+	for (ATarget* Target : TargetPool)
+	{
+		if (IsValid(Target))
+		{
+			Target->UpdatePlayerSettings(InPlayerSettings);
+		}
+	}
 }
 
 /* --------------------- */
@@ -1391,8 +1608,8 @@ void ATargetManager::UpdateCommonScoreInfoQTable(FCommonScoreInfo& InCommonScore
 	if (RLComponent->GetRLMode() != EReinforcementLearningMode::None)
 	{
 		RLComponent->ClearCachedTargetPairs();
-		InCommonScoreInfo.UpdateQTable(RLComponent->GetTArray_FromNdArray_QTable(), RLComponent->GetNumQTableRows(),
-			RLComponent->GetNumQTableColumns(), RLComponent->GetTArray_FromNdArray_TrainingSamples(),
+		InCommonScoreInfo.UpdateQTable(RLComponent->GetTArray_QTable(), RLComponent->GetNumQTableRows(),
+			RLComponent->GetNumQTableColumns(), RLComponent->GetTArray_TrainingSamples(),
 			RLComponent->GetTotalTrainingSamples());
 	}
 }
@@ -1401,6 +1618,9 @@ void ATargetManager::UpdateCommonScoreInfoQTable(FCommonScoreInfo& InCommonScore
 
 void ATargetManager::DrawDebug() const
 {
+	SCOPE_CYCLE_COUNTER(STAT_TargetManagerDrawDebug);
+	BS_BEAT_LATENCY_SCOPE(DrawDebugMs);
+
 	FlushPersistentDebugLines(GetWorld());
 	if (bShowDebug_AnyMovingTargetDirectionMode)
 	{
@@ -1414,4 +1634,61 @@ void ATargetManager::DrawDebug() const
 	SpawnAreaManager->DrawDebug();
 }
 
+void ATargetManager::LogBeatLatencySummary(const int32 NumBeats) const
+{
+	UE_LOG(LogTargetManager, Display, TEXT("%s"), *BeatLatencyRecorder->GetSummary(NumBeats));
+}
+
+bool ATargetManager::WriteBeatLatencyCsv() const
+{
+	if (!BSConfig || BeatLatencyRecorder->Num() == 0) return false;
+
+	const FBS_DefiningConfig& Def = BSConfig->DefiningConfig;
+	const FBS_TargetConfig& Cfg = BSConfig->TargetConfig;
+	const FString GameModeName = Def.GameModeType == EGameModeType::Custom
+		? Def.CustomGameModeName
+		: UEnum::GetDisplayValueAsText(Def.BaseGameMode).ToString();
+
+	// Settings that change how much work each beat does, so that hitches can be attributed to them
+	FString Csv;
+	Csv += FString::Printf(TEXT("# GameMode=%s Difficulty=%s\n"), *GameModeName,
+		*UEnum::GetDisplayValueAsText(Def.Difficulty).ToString());
+	Csv += FString::Printf(TEXT("# TargetSpawningPolicy=%s TargetDistributionPolicy=%s BoundsScalingPolicy=%s "
+		"TargetActivationSelectionPolicy=%s ReinforcementLearningMode=%s\n"),
+		*UEnum::GetDisplayValueAsText(Cfg.TargetSpawningPolicy).ToString(),
+		*UEnum::GetDisplayValueAsText(Cfg.TargetDistributionPolicy).ToString(),
+		*UEnum::GetDisplayValueAsText(Cfg.BoundsScalingPolicy).ToString(),
+		*UEnum::GetDisplayValueAsText(Cfg.TargetActivationSelectionPolicy).ToString(),
+		*UEnum::GetDisplayValueAsText(BSConfig->AIConfig.ReinforcementLearningMode).ToString());
+	Csv += FString::Printf(TEXT("# NumRuntimeTargetsToSpawn=%d NumUpfrontTargetsToSpawn=%d MaxNumTargetsAtOnce=%d "
+		"MaxNumActivatedTargetsAtOnce=%d bAllowSpawnWithoutActivation=%d SpawnAreaDimensions=%d,%d,%d\n"),
+		Cfg.NumRuntimeTargetsToSpawn, Cfg.NumUpfrontTargetsToSpawn, Cfg.MaxNumTargetsAtOnce,
+		Cfg.MaxNumActivatedTargetsAtOnce, Cfg.bAllowSpawnWithoutActivation, SpawnAreaDimensions.X,
+		SpawnAreaDimensions.Y, SpawnAreaDimensions.Z);
+	Csv += BeatLatencyRecorder->ToCsv();
+
+	const FString FileName = FString::Printf(TEXT("%s_%s.csv"), *FPaths::MakeValidFileName(GameModeName),
+		*FDateTime::Now().ToString());
+	const FString CsvPath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("BeatLatency"), FileName);
+	if (!FFileHelper::SaveStringToFile(Csv, *CsvPath))
+	{
+		UE_LOG(LogTargetManager, Warning, TEXT("Failed to write beat latency to %s"), *CsvPath);
+		return false;
+	}
+	UE_LOG(LogTargetManager, Display, TEXT("Wrote beat latency for %d beats to %s"), BeatLatencyRecorder->Num(),
+		*CsvPath);
+	return true;
+}
+
+void ATargetManager::HandleBeatLatencyOnGameModeEnd() const
+{
+	if (GIsAutomationTesting || BeatLatencyRecorder->Num() == 0) return;
+
+	LogBeatLatencySummary();
+	if (BeatLatencyCVars::CVarCsvOnGameModeEnd.GetValueOnGameThread())
+	{
+		WriteBeatLatencyCsv();
+	}
+}
+
 #endif
\ No newline at end of file
@@ -8,7 +8,8 @@
 
 ATargetManagerPreview::ATargetManagerPreview()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	// Targets do not tick, so the TargetManager must tick to play their color and scale animations
+	PrimaryActorTick.bCanEverTick = true;
 }
 
 void ATargetManagerPreview::InitBoxBoundsWidget(
@@ -24,24 +25,26 @@ void ATargetManagerPreview::SetSimulatePlayerDestroyingTargets(const bool bInSim
 	DestroyChance = InDestroyChance;
 }
 
-ATarget* ATargetManagerPreview::SpawnTarget(const FTargetSpawnParams& Params)
+TArray<ATarget*> ATargetManagerPreview::SpawnTargets(const TSet<FTargetSpawnParams>& SpawnParams)
 {
-	ATarget* Target = Super::SpawnTarget(Params);
-	if (Target)
+	TArray<ATarget*> Targets = Super::SpawnTargets(SpawnParams);
+	if (Targets.IsEmpty()) return Targets;
+	
+	const float Height = StaticExtents.Z
+		+ (BSConfig->TargetConfig.FloorDistance - ClampedOverflowAmount) * 0.5f
+		+ GameModePreviewWidget->GetSpacerOffset() * 0.5f;
+	for (ATarget* Target : Targets)
 	{
 		if (ATargetPreview* TargetPreview = Cast<ATargetPreview>(Target))
 		{
 			if (UTargetWidget* TargetWidget =  GameModePreviewWidget->ConstructTargetWidget())
 			{
-				const float Height = StaticExtents.Z
-					+ (BSConfig->TargetConfig.FloorDistance - ClampedOverflowAmount) * 0.5f
-					+ GameModePreviewWidget->GetSpacerOffset() * 0.5f;
 				TargetPreview->InitTargetWidget(TargetWidget, TargetPreview->GetActorLocation(), Height);
 				TargetPreview->SetSimulatePlayerDestroying(bSimulatePlayerDestroyingTargets, DestroyChance);
 			}
 		}
 	}
-	return Target;
+	return Targets;
 }
 
 void ATargetManagerPreview::UpdateSpawnVolume(const float Factor) const
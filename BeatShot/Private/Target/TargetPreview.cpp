@@ -38,6 +38,19 @@ void ATargetPreview::Destroyed()
 	Super::Destroyed();
 }
 
+void ATargetPreview::ReturnToPool()
+{
+	GetWorldTimerManager().ClearTimer(SimulatePlayerDestroyingTimer);
+	Super::ReturnToPool();
+
+	// A new widget is constructed by the TargetManagerPreview when the target is reused
+	if (TargetWidget)
+	{
+		TargetWidget->RemoveFromParent();
+		TargetWidget = nullptr;
+	}
+}
+
 void ATargetPreview::InitTargetWidget(const TObjectPtr<UTargetWidget> InTargetWidget, const FVector& InStartLocation,
 	const float BoundsHeight)
 {
@@ -108,7 +108,7 @@ public:
 	void HideInteractInfo();
 
 	/** Shows the RLAgent widget, creating it if it does not exist. Binds the provided delegate to the
-	 *  widget's UpdatePanel function. */
+	 *  widget's UpdateCells function. */
 	void ShowRLAgentWidget(FOnQTableUpdate& OnQTableUpdate, const int32 Rows, const int32 Columns,
 		const TArray<float>& QTable);
 	/** Hides and destroys the RLAgent widget, if it exists. */
@@ -0,0 +1,120 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Tournament tree over a fixed number of values where every node stores the index of the largest value beneath it.
+ *  Changing one value is O(log N), reading the maximum is O(1), and indices can be visited in descending order of
+ *  value without sorting. Ties are broken towards the lower index. Used by the ReinforcementLearningComponent to keep
+ *  the ordering of each QTable row and of the QTable row sums up to date as single values change. */
+class BEATSHOT_API FArgMaxTree
+{
+public:
+	FArgMaxTree() : NumValues(0), NumLeaves(0)
+	{}
+
+	/** Builds the tree from InValues.
+	 *
+	 *  @param InValues the initial values, the tree will have the same number of values
+	 */
+	void Init(TConstArrayView<float> InValues);
+
+	/** Removes all values. */
+	void Reset();
+
+	/** Sets the value at Index and updates its ancestors.
+	 *
+	 *  @param Index the index of the value to change
+	 *  @param Value the new value
+	 */
+	void Update(const int32 Index, const float Value);
+
+	/** Returns the number of values in the tree */
+	int32 Num() const { return NumValues; }
+
+	/** Returns the value at Index */
+	float GetValue(const int32 Index) const { return Values[Index]; }
+
+	/** Returns all values */
+	TConstArrayView<float> GetValues() const { return Values; }
+
+	/** Returns the index of the largest value, or INDEX_NONE if empty */
+	int32 GetArgMax() const { return NumValues > 0 ? Nodes[1] : INDEX_NONE; }
+
+	/** Appends every index whose value equals the largest value to Out, in ascending order of index.
+	 *
+	 *  @param Out the array to append to
+	 */
+	void GetMaxIndices(TArray<int32>& Out) const;
+
+	/** Visits indices in descending order of value and returns the first that satisfies Predicate.
+	 *
+	 *  @param Predicate callable taking an index and returning whether it can be used
+	 *  @return the index of the largest value satisfying Predicate, or INDEX_NONE if none do
+	 */
+	template <typename PredicateType>
+	int32 FindBestIndex(PredicateType Predicate) const;
+
+private:
+	/** Returns whichever of the two indices has the larger value, treating INDEX_NONE as padding */
+	FORCEINLINE int32 GetBetter(const int32 A, const int32 B) const
+	{
+		if (A == INDEX_NONE) return B;
+		if (B == INDEX_NONE) return A;
+		return Values[B] > Values[A] ? B : A;
+	}
+
+	/** Heap ordering that puts the node with the largest value first */
+	FORCEINLINE bool IsNodeBefore(const int32 NodeA, const int32 NodeB) const
+	{
+		const int32 A = Nodes[NodeA];
+		const int32 B = Nodes[NodeB];
+		return Values[A] > Values[B] || (Values[A] == Values[B] && A < B);
+	}
+
+	/** Number of values */
+	int32 NumValues;
+
+	/** Number of leaves, NumValues rounded up to a power of two */
+	int32 NumLeaves;
+
+	/** The values, indexed the same as the input */
+	TArray<float> Values;
+
+	/** Index of the largest value beneath each node. Node 1 is the root, leaves start at NumLeaves */
+	TArray<int32> Nodes;
+};
+
+template <typename PredicateType>
+int32 FArgMaxTree::FindBestIndex(PredicateType Predicate) const
+{
+	if (NumValues == 0) return INDEX_NONE;
+
+	const auto NodeOrder = [this](const int32 A, const int32 B) { return IsNodeBefore(A, B); };
+
+	// Best-first search: the frontier heap always pops the node holding the largest remaining value
+	TArray<int32, TInlineAllocator<64>> Frontier;
+	Frontier.Add(1);
+
+	while (Frontier.Num() > 0)
+	{
+		int32 Node;
+		Frontier.HeapPop(Node, NodeOrder);
+
+		const int32 Index = Nodes[Node];
+		if (Index == INDEX_NONE) continue;
+
+		if (Node >= NumLeaves)
+		{
+			if (Predicate(Index)) return Index;
+			continue;
+		}
+
+		for (const int32 Child : {Node * 2, Node * 2 + 1})
+		{
+			if (Nodes[Child] != INDEX_NONE) Frontier.HeapPush(Child, NodeOrder);
+		}
+	}
+	return INDEX_NONE;
+}
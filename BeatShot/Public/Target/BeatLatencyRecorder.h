@@ -0,0 +1,130 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Timings and candidate set sizes for a single beat handled by ATargetManager::OnAudioAnalyzerBeat */
+struct FBeatLatencyRecord
+{
+	/** Number of beats recorded before this one */
+	int32 BeatIndex = 0;
+
+	/** World time when the beat started */
+	double WorldTime = 0.0;
+
+	/** Wall time of the entire beat, in milliseconds */
+	double TotalMs = 0.0;
+
+	/** Wall time of HandleRuntimeSpawning, including GetTargetSpawnParams and SpawnTargets */
+	double RuntimeSpawningMs = 0.0;
+
+	/** Wall time of GetTargetSpawnParams */
+	double GetTargetSpawnParamsMs = 0.0;
+
+	/** Wall time of SpawnTargets */
+	double SpawnTargetsMs = 0.0;
+
+	/** Wall time of HandleTargetActivation */
+	double TargetActivationMs = 0.0;
+
+	/** Wall time of DrawDebug */
+	double DrawDebugMs = 0.0;
+
+	/** Number of targets requested from GetTargetSpawnParams */
+	int32 NumToSpawn = 0;
+
+	/** Number of spawn params returned by GetTargetSpawnParams */
+	int32 NumSpawnCandidates = 0;
+
+	/** Number of targets spawned */
+	int32 NumSpawned = 0;
+
+	/** Number of targets requested from GetActivatableTargets */
+	int32 NumToActivate = 0;
+
+	/** Number of targets returned by GetActivatableTargets */
+	int32 NumActivationCandidates = 0;
+
+	/** Number of targets activated */
+	int32 NumActivated = 0;
+
+	/** Number of targets managed by the TargetManager at the end of the beat */
+	int32 NumManagedTargets = 0;
+};
+
+/** Adds the wall time between its construction and destruction to a millisecond field of a FBeatLatencyRecord */
+struct FBeatLatencyScope
+{
+	explicit FBeatLatencyScope(double& InMilliseconds) : Milliseconds(InMilliseconds),
+		StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FBeatLatencyScope()
+	{
+		Milliseconds += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	double& Milliseconds;
+	uint64 StartCycles;
+};
+
+/** Fixed size ring buffer of the most recent FBeatLatencyRecords. The record for the beat in progress is filled in
+ *  through Current() between BeginBeat and EndBeat, so the functions called during a beat do not need to pass
+ *  their timings and counts back up the call stack. */
+class BEATSHOT_API FBeatLatencyRecorder
+{
+public:
+	explicit FBeatLatencyRecorder(const int32 InCapacity = DefaultCapacity);
+
+	/** Resets the current record and starts timing a new beat */
+	void BeginBeat(const double WorldTime);
+
+	/** Finishes timing the current beat and adds its record to the buffer, overwriting the oldest if full */
+	void EndBeat();
+
+	/** Returns the record for the beat in progress */
+	FBeatLatencyRecord& Current() { return CurrentRecord; }
+
+	/** Removes all records */
+	void Reset();
+
+	/** Returns the number of records in the buffer */
+	int32 Num() const { return Count; }
+
+	/** Returns the number of beats recorded since the last reset, including those no longer in the buffer */
+	int32 GetTotalRecorded() const { return TotalRecorded; }
+
+	/** Returns up to the last NumRecords records, oldest first. Returns every record if NumRecords <= 0 */
+	TArray<FBeatLatencyRecord> GetRecords(const int32 NumRecords = 0) const;
+
+	/** Returns the average and maximum of each timing and count over the last NumRecords records */
+	FString GetSummary(const int32 NumRecords = 0) const;
+
+	/** Returns every record as comma separated values with a header row, oldest first */
+	FString ToCsv() const;
+
+	/** Number of records kept when no capacity is given, which covers a typical song at a few beats per second */
+	static constexpr int32 DefaultCapacity = 2048;
+
+private:
+	/** The record for the beat in progress */
+	FBeatLatencyRecord CurrentRecord;
+
+	/** Cycles when the beat in progress started */
+	uint64 BeatStartCycles = 0;
+
+	/** Ring buffer storage, allocated up front */
+	TArray<FBeatLatencyRecord> Records;
+
+	/** Index the next record is written to */
+	int32 Head = 0;
+
+	/** Number of valid records in Records */
+	int32 Count = 0;
+
+	/** Number of beats recorded since the last reset */
+	int32 TotalRecorded = 0;
+};
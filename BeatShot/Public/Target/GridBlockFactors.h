@@ -0,0 +1,145 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GlobalConstants.h"
+#include "LargestRectangleFinder.h"
+
+/** Compile-time tables of the factors tried for each grid block size. A block can never be larger than the number of
+ *  Spawn Areas in the largest grid, so every block size is factored once at compile time, and finding the factors for
+ *  a block size is an offset into a flat array. */
+namespace GridBlockFactors
+{
+	/** The largest grid block that can be requested. Grids have one extra row and column of Spawn Areas */
+	inline constexpr int32 MaxBlockSize = (Constants::MaxValue_NumHorizontalGridTargets + 1) * (
+		Constants::MaxValue_NumVerticalGridTargets + 1);
+
+	/** Returns whether or not a number is prime.
+	 *
+	 * 	@param Number the number in question
+	 *  @return whether or not the number is prime
+	 */
+	constexpr bool IsPrime(const int32 Number)
+	{
+		if (Number <= 1) return false;
+		if (Number == 2 || Number == 3) return true;
+		if (Number % 2 == 0 || Number % 3 == 0) return false;
+
+		// All prime numbers > 3 can be expressed by 6k ± 1, where k is a positive integer
+		int32 i = 5;
+
+		while (i * i <= Number)
+		{
+			// Check divisibility from (5, sqrt(number)), or by an integer that is 2 greater
+			if (Number % i == 0 || Number % (i + 2) == 0) return false;
+			i += 6;
+		}
+
+		return true;
+	}
+
+	/** Calls Func with each unique pair of factors for a number, with the smaller factor first. */
+	template <typename FuncType>
+	constexpr void ForEachFactor(const int32 Number, FuncType&& Func)
+	{
+		for (int32 i = 1; i * i <= Number; i++)
+		{
+			if (Number % i == 0)
+			{
+				Func(FFactor(i, Number / i));
+			}
+		}
+	}
+
+	/** Calls Func with each factor tried for a block size. A prime block size can only be placed as a line, so the
+	 *  factors of one less and one greater than the block size are used instead. */
+	template <typename FuncType>
+	constexpr void ForEachBlockFactor(const int32 BlockSize, FuncType&& Func)
+	{
+		if (IsPrime(BlockSize))
+		{
+			ForEachFactor(BlockSize - 1, Func);
+			ForEachFactor(BlockSize + 1, Func);
+		}
+		else
+		{
+			ForEachFactor(BlockSize, Func);
+		}
+	}
+
+	/** Returns the number of factors tried across every block size up to MaxBlockSize. */
+	constexpr int32 CountTotalFactors()
+	{
+		int32 Total = 0;
+		for (int32 BlockSize = 0; BlockSize <= MaxBlockSize; BlockSize++)
+		{
+			ForEachBlockFactor(BlockSize, [&Total](const FFactor&) { Total++; });
+		}
+		return Total;
+	}
+
+	/** The factors for every block size stored back to back, each block size's factors sorted by FFactor::operator< */
+	struct FFactorTable
+	{
+		/** Offset into Factors for each block size, plus one extra marking the end of the last block size */
+		int32 Offsets[MaxBlockSize + 2] = {};
+
+		/** All factors, grouped by block size */
+		FFactor Factors[CountTotalFactors()] = {};
+
+		/** The most factors any single block size has */
+		int32 MaxFactorsPerBlockSize = 0;
+	};
+
+	/** Builds the factor table. Only evaluated at compile time. */
+	constexpr FFactorTable MakeFactorTable()
+	{
+		FFactorTable Table;
+		int32 Num = 0;
+		for (int32 BlockSize = 0; BlockSize <= MaxBlockSize; BlockSize++)
+		{
+			const int32 Start = Num;
+			Table.Offsets[BlockSize] = Start;
+			ForEachBlockFactor(BlockSize, [&Table, &Num](const FFactor& Factor) { Table.Factors[Num++] = Factor; });
+
+			// Each block size only has a handful of factors, so an insertion sort is plenty
+			for (int32 i = Start + 1; i < Num; i++)
+			{
+				const FFactor Factor = Table.Factors[i];
+				int32 j = i - 1;
+				while (j >= Start && Factor < Table.Factors[j])
+				{
+					Table.Factors[j + 1] = Table.Factors[j];
+					j--;
+				}
+				Table.Factors[j + 1] = Factor;
+			}
+
+			if (Num - Start > Table.MaxFactorsPerBlockSize)
+			{
+				Table.MaxFactorsPerBlockSize = Num - Start;
+			}
+		}
+		Table.Offsets[MaxBlockSize + 1] = Num;
+		return Table;
+	}
+
+	inline constexpr FFactorTable FactorTable = MakeFactorTable();
+
+	/** Returns the factors to try for a block size, sorted so that factors closest to a square come first. Empty if
+	 *  the block size is larger than any grid can hold.
+	 *
+	 *  @param BlockSize the size of block to find factors for
+	 *  @return a view into the factor table
+	 */
+	inline TConstArrayView<FFactor> GetFactors(const int32 BlockSize)
+	{
+		if (BlockSize < 0 || BlockSize > MaxBlockSize) return TConstArrayView<FFactor>();
+		return TConstArrayView<FFactor>(FactorTable.Factors + FactorTable.Offsets[BlockSize],
+			FactorTable.Offsets[BlockSize + 1] - FactorTable.Offsets[BlockSize]);
+	}
+
+	static_assert(FactorTable.MaxFactorsPerBlockSize <= FLargestRectangleFinder::MaxFactors,
+		"FLargestRectangleFinder cannot search for every factor of the largest block size.");
+}
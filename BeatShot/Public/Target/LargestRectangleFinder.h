@@ -0,0 +1,372 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpawnAreaBitSet.h"
+
+struct FIndexPair
+{
+	int32 StartIndex, EndIndex;
+	
+	FIndexPair() : StartIndex(-1), EndIndex(-1)
+	{}
+	FIndexPair(const int32 InStart, const int32 InEnd) : StartIndex(InStart), EndIndex(InEnd)
+	{}
+
+	friend FORCEINLINE uint32 GetTypeHash(const FIndexPair& Other)
+	{
+		return HashCombine(GetTypeHash(Other.StartIndex), GetTypeHash(Other.EndIndex));
+	}
+
+	FORCEINLINE bool operator==(const FIndexPair& Other) const
+	{
+		return StartIndex == Other.StartIndex && EndIndex == Other.EndIndex;
+	}
+
+	FORCEINLINE bool operator<(const FIndexPair& Other) const
+	{
+		if (EndIndex == Other.EndIndex)
+		{
+			return StartIndex < Other.StartIndex;
+		}
+		return EndIndex < Other.EndIndex;
+	}
+};
+
+struct FRectDims
+{
+	int32 Width, Height;
+	
+	FRectDims() : Width(0), Height(0)
+	{}
+	FRectDims(const int32 InWidth, const int32 InHeight) : Width(InWidth), Height(InHeight)
+	{}
+};
+
+/** A unique pair of factors for a number */
+struct FFactor
+{
+	int32 Factor1;
+	int32 Factor2;
+	int32 Distance;
+
+	constexpr FFactor(): Factor1(-1), Factor2(-1), Distance(-1)
+	{}
+
+	constexpr FFactor(const int32 F1, const int32 F2) : Factor1(F1), Factor2(F2), Distance(F1 > F2 ? F1 - F2 : F2 - F1)
+	{}
+
+	constexpr explicit FFactor(const int32 InDistance) : Factor1(-1), Factor2(-1), Distance(InDistance)
+	{}
+
+	constexpr bool IsValid() const
+	{
+		return Factor1 != -1 && Factor2 != -1;
+	}
+
+	FORCEINLINE constexpr bool operator==(const FFactor& Other) const
+	{
+		if (Factor1 == Other.Factor1 && Factor2 == Other.Factor2)
+		{
+			return true;
+		}
+		if (Factor1 == Other.Factor2 && Factor2 == Other.Factor1)
+		{
+			return true;
+		}
+		return false;
+	}
+
+	FORCEINLINE constexpr bool operator<(const FFactor& Other) const
+	{
+		if (Distance == Other.Distance)
+		{
+			if (Factor1 == Other.Factor1)
+			{
+				return Factor2 < Other.Factor2;
+			}
+			return Factor1 < Other.Factor1;
+		}
+		return Distance < Other.Distance;
+	}
+
+	friend FORCEINLINE uint32 GetTypeHash(const FFactor& Factor)
+	{
+		uint32 Hash = 0;
+
+		const int32 Min = Factor.Factor1 < Factor.Factor2 ? Factor.Factor1 : Factor.Factor2;
+		const int32 Max = Factor.Factor1 < Factor.Factor2 ? Factor.Factor2 : Factor.Factor1;
+
+		Hash = HashCombine(Hash, GetTypeHash(Min));
+		Hash = HashCombine(Hash, GetTypeHash(Max));
+
+		return Hash;
+	}
+};
+
+/** A rectangle of valid indices found by FLargestRectangleFinder. Each one spans the full width of valid indices
+ *  available at its top row, and extends down as far as all of its columns are valid. */
+struct FSubRectangle
+{
+	/** The start index (bottom left) and end index (top right) of the sub rectangle */
+	FIndexPair BoundingIndices;
+
+	/** Dimensions of the sub rectangle */
+	FRectDims Dimensions;
+
+	/** Area of the sub rectangle */
+	int32 Area;
+
+	/** Start and end row indices */
+	FIndexPair Row;
+
+	/** Start and end column indices */
+	FIndexPair Col;
+
+	FSubRectangle() : Area(0)
+	{}
+
+	FSubRectangle(const int32 InTopRow, const int32 InStartCol, const int32 InWidth, const int32 InHeight,
+		const int32 InNumCols) : Dimensions(InWidth, InHeight), Area(InWidth * InHeight),
+		Row(InTopRow - InHeight + 1, InTopRow), Col(InStartCol, InStartCol + InWidth - 1)
+	{
+		BoundingIndices = FIndexPair(Row.StartIndex * InNumCols + Col.StartIndex,
+			Row.EndIndex * InNumCols + Col.EndIndex);
+	}
+
+	/** Returns whether or not the rectangle has area greater than 1 and the EndIndex is greater than StartIndex */
+	bool IsValid() const
+	{
+		return Area > 0 && BoundingIndices.EndIndex > BoundingIndices.StartIndex;
+	}
+
+	/** Returns whether or not a block with the factor's dimensions fits inside the rectangle in either orientation. */
+	FORCEINLINE bool Fits(const FFactor& Factor) const
+	{
+		return (Dimensions.Width >= Factor.Factor1 && Dimensions.Height >= Factor.Factor2) || (Dimensions.Width >=
+			Factor.Factor2 && Dimensions.Height >= Factor.Factor1);
+	}
+
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("Index: [%d, %d] Size: %dx%d"), BoundingIndices.StartIndex,
+			BoundingIndices.EndIndex, Dimensions.Width, Dimensions.Height);
+	}
+	
+	FORCEINLINE bool operator==(const FSubRectangle& Other) const
+	{
+		return BoundingIndices == Other.BoundingIndices;
+	}
+	
+	FORCEINLINE bool operator<(const FSubRectangle& Other) const
+	{
+		return BoundingIndices < Other.BoundingIndices;
+	}
+	
+	friend FORCEINLINE uint32 GetTypeHash(const FSubRectangle& Other)
+	{
+		return GetTypeHash(Other.BoundingIndices);
+	}
+};
+
+/** Contains info about the rectangle chosen for a GridBlock. */
+struct FRectCandidate
+{
+	/** The factor for this candidate */
+	FFactor Factor;
+	
+	/** (ChosenStartRowIndex, ChosenEndRowIndex) */
+	FIndexPair ChosenRow;
+
+	/** (ChosenStartColIndex, ChosenEndColIndex) */
+	FIndexPair ChosenCol;
+
+	/** Chosen sub rectangle */
+	FSubRectangle ChosenSubRectangle;
+
+	/** The number of rows in the largest rectangle found */
+	int32 NumRowsAvailable;
+
+	/** The number of cols in the largest rectangle found */
+	int32 NumColsAvailable;
+
+	/** The true size of the block. Set to min(Area, BlockSize) */
+	int32 ActualBlockSize;
+
+	/** The size of the block used to set the Chosen Start/End Row/Col Indices */
+	int32 ChosenBlockSize;
+
+	FRectCandidate(): NumRowsAvailable(0), NumColsAvailable(0), ActualBlockSize(0), ChosenBlockSize(0)
+	{}
+
+	explicit FRectCandidate(const FFactor& InFactor) : Factor(InFactor), NumRowsAvailable(-1), NumColsAvailable(-1),
+		ActualBlockSize(-1), ChosenBlockSize(-1)
+	{}
+	
+	/** Sets the value of ChosenSubRectangle. Updates NumRowsAvailable, NumColsAvailable, ActualBlockSize, 
+	 *  and initializes the ChosenRow, ChosenCol to SubRectangle.Row, SubRectangle.Col. */
+	void SetChosenSubRectangle(const FSubRectangle& SubRectangle, const int32 InBlockSize)
+	{
+		ChosenSubRectangle = SubRectangle;
+		
+		NumRowsAvailable = SubRectangle.Row.EndIndex - SubRectangle.Row.StartIndex + 1;
+		NumColsAvailable = SubRectangle.Col.EndIndex - SubRectangle.Col.StartIndex + 1;
+		ActualBlockSize = FMath::Min(InBlockSize, SubRectangle.Area);
+
+		ChosenRow = SubRectangle.Row;
+		ChosenCol = SubRectangle.Col;
+	}
+	
+	/** Returns true if the first factor is less than number of rows available and the second factor is less than the
+     *  number of columns available. */
+	bool FirstFactorComboFits() const
+	{
+		const bool bF1FitsRows = Factor.Factor1 <= NumRowsAvailable;
+		const bool bF2FitsCols = Factor.Factor2 <= NumColsAvailable;
+		return bF1FitsRows && bF2FitsCols;
+	}
+
+	/** Returns true if the first factor is less than number of columns available and the second factor is less than the
+	 *  number of rows available. */
+	bool SecondFactorComboFits() const
+	{
+		const bool bF1FitsCols = Factor.Factor1 <= NumColsAvailable;
+		const bool bF2FitsRows = Factor.Factor2 <= NumRowsAvailable;
+		return bF2FitsRows && bF1FitsCols;
+	}
+
+	/** Returns true if both factors fit. */
+	bool AllFactorsFit() const
+	{
+		return FirstFactorComboFits() && SecondFactorComboFits();
+	}
+
+	/** Returns true if the ChosenSubRectangle is valid. */
+	bool HasChosenSubRectangle() const
+	{
+		return ChosenSubRectangle.IsValid();
+	}
+
+	/** Returns a human-readable string of the rectangle. */
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("Candidate [%d, %d]"), Factor.Factor1,Factor.Factor2);
+	}
+};
+
+/** Finds the maximal rectangles of valid indices in a grid of Spawn Areas, and groups them by the factors that fit
+ *  inside them. Each row is processed with a histogram of column heights and a stack, so a search is O(NumRows *
+ *  NumCols) plus one bit per factor per rectangle. All scratch storage is owned by the finder and only grows, so once
+ *  it has seen a grid of a given size, searching again does not allocate. */
+class BEATSHOT_API FLargestRectangleFinder
+{
+public:
+	/** The maximum number of factors that can be searched for at once, since each rectangle stores its fitting
+	 *  factors as a 64-bit mask */
+	static constexpr int32 MaxFactors = 64;
+
+	FLargestRectangleFinder() : NumRows(0), NumCols(0), bHasAdjacentIndices(false)
+	{}
+
+	/** Sizes the scratch storage for a grid with NumRows and NumCols. Must be called before FindRectangles.
+	 *
+	 *  @param InNumRows total number of Spawn Area rows
+	 *  @param InNumCols total number of Spawn Area columns
+	 */
+	void Init(const int32 InNumRows, const int32 InNumCols);
+
+	/** Finds all maximal rectangles of valid indices and records which of the factors fit inside each of them.
+	 *  Clears any adjacent indices from a previous search.
+	 *
+	 *  @param Validity a bit set of valid Spawn Area indices, with NumRows * NumCols bits
+	 *  @param InFactors the factors to group rectangles by, in the order that candidates should be preferred
+	 */
+	void FindRectangles(const FSpawnAreaBitSet& Validity, TConstArrayView<FFactor> InFactors);
+
+	/** Builds a summed-area table from the adjacent indices so that ChooseRectangleCandidate can test whether a block
+	 *  touches an adjacent index in constant time.
+	 *
+	 *  @param Adjacent a bit set of indices adjacent to recent grid blocks
+	 */
+	void SetAdjacentIndices(const FSpawnAreaBitSet& Adjacent);
+
+	/** Chooses a rectangle candidate from the last search. Factors are visited in the order they were passed to
+	 *  FindRectangles. If bordering, the first rectangle (in random order) that has start index candidates is chosen,
+	 *  and the candidates can be retrieved with GetStartIndexCandidates. Otherwise, or if no rectangle borders an
+	 *  adjacent index, a random rectangle of the first factor that fits anywhere is chosen.
+	 *
+	 *  @param bBordering whether or not to prefer rectangles with start index candidates
+	 *  @param BlockSize number of targets to spawn
+	 *  @param Stream the random stream used to choose between rectangles
+	 *  @return the chosen rectangle candidate, which has no chosen sub rectangle if none were found
+	 */
+	FRectCandidate ChooseRectangleCandidate(const bool bBordering, const int32 BlockSize,
+		const FRandomStream& Stream);
+
+	/** Returns the (row, col) start positions found for the most recently chosen candidate, where a block with the
+	 *  candidate's factors fits inside the rectangle and contains at least one adjacent index. */
+	TConstArrayView<FIndexPair> GetStartIndexCandidates() const { return StartIndexCandidates; }
+
+	/** Returns the number of factors used in the last search. */
+	int32 GetNumFactors() const { return Factors.Num(); }
+
+	/** Returns the factor at FactorIndex. */
+	const FFactor& GetFactor(const int32 FactorIndex) const { return Factors[FactorIndex]; }
+
+	/** Returns the indices of the rectangles that the factor at FactorIndex fits inside. */
+	TConstArrayView<int32> GetCandidates(const int32 FactorIndex) const
+	{
+		return TConstArrayView<int32>(CandidateIndices.GetData() + CandidateOffsets[FactorIndex],
+			CandidateOffsets[FactorIndex + 1] - CandidateOffsets[FactorIndex]);
+	}
+
+	/** Returns the number of rectangles found in the last search. */
+	int32 GetNumRectangles() const { return Rectangles.Num(); }
+
+	/** Returns the rectangle at RectIndex. */
+	const FSubRectangle& GetRectangle(const int32 RectIndex) const { return Rectangles[RectIndex]; }
+
+private:
+	/** Adds a rectangle popped off the stack and records which factors fit inside of it. */
+	void AddRectangle(const int32 TopRow, const int32 StartCol, const int32 Width, const int32 Height);
+
+	/** Returns whether or not the block with bottom left (Row, Col) contains at least one adjacent index. */
+	bool BlockContainsAdjacent(const int32 Row, const int32 Col, const int32 BlockRows, const int32 BlockCols) const;
+
+	/** Fills StartIndexCandidates for a rectangle and factor, and returns the number found. */
+	int32 UpdateStartIndexCandidates(const FSubRectangle& Rectangle, const FFactor& Factor);
+
+	int32 NumRows;
+	int32 NumCols;
+
+	/** Whether or not SetAdjacentIndices has been called since the last search */
+	bool bHasAdjacentIndices;
+
+	/** Number of consecutive valid indices ending at the current row, one per column */
+	TArray<int32> Heights;
+
+	/** Fixed capacity stack of (start column, height), with StackNum elements in use */
+	TArray<FIntPoint> Stack;
+
+	/** The factors used in the last search */
+	TArray<FFactor> Factors;
+
+	/** All maximal rectangles found in the last search */
+	TArray<FSubRectangle> Rectangles;
+
+	/** One bit per factor for each rectangle in Rectangles, set if the factor fits inside it */
+	TArray<uint64> FitMasks;
+
+	/** Offset into CandidateIndices for each factor, plus one extra marking the end of the last factor */
+	TArray<int32> CandidateOffsets;
+
+	/** Rectangle indices grouped by factor */
+	TArray<int32> CandidateIndices;
+
+	/** Summed-area table of adjacent indices with (NumRows + 1) * (NumCols + 1) elements */
+	TArray<int32> AdjacentSums;
+
+	/** Start positions found for the most recently chosen candidate */
+	TArray<FIndexPair> StartIndexCandidates;
+};
@@ -3,114 +3,66 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "SaveGamePlayerScore.h"
-#include "NumCpp.hpp"
+#include "Containers/StaticArray.h"
 
-/** Converts an NdArray of floats to a TArray of floats */
+/** Treats the input as a row-major matrix with NumRows rows and NumCols columns, flips it upside down, and returns it
+ *  in the same column-major layout as TQTable::ToScoreInfoArray.
+ *
+ *  @param In NumRows * NumCols element array, typically a per-column reduction of the QTable
+ *  @param NumRows Number of rows in the input matrix
+ *  @param NumCols Number of columns in the input matrix
+ */
 template <typename T>
-static TArray<T> GetTArrayFromNdArray(const nc::NdArray<T>& InArray)
+static TArray<T> GetFlippedUpDownTArray(TConstArrayView<T> In, const int32 NumRows, const int32 NumCols)
 {
-	const int32 RowSize = InArray.numRows();
-	const int32 ColSize = InArray.numCols();
+	check(In.Num() == NumRows * NumCols);
 
 	TArray<T> Out;
-	Out.Init(0.f, InArray.size());
+	Out.SetNumUninitialized(NumRows * NumCols);
 
-	for (int j = 0; j < ColSize; j++)
+	for (int32 j = 0; j < NumCols; j++)
 	{
-		for (int i = 0; i < RowSize; i++)
+		for (int32 i = 0; i < NumRows; i++)
 		{
-			Out[RowSize * j + i] = InArray(i, j);
-		}
-	}
-	return Out;
-}
-
-/** Converts a TArray of floats to an NdArray of floats */
-template <typename T>
-static nc::NdArray<T> GetNdArrayFromTArray(const TArray<T>& InTArray, const int32 NumRows, const int32 NumCols)
-{
-	nc::NdArray<T> Out = nc::zeros<T>(NumRows, NumCols);
-
-	for (int j = 0; j < NumCols; j++)
-	{
-		for (int i = 0; i < NumRows; i++)
-		{
-			Out(i, j) = InTArray[NumRows * j + i];
+			Out[NumRows * j + i] = In[(NumRows - 1 - i) * NumCols + j];
 		}
 	}
 	return Out;
 }
 
 /** Returns a flattened array of 5 values containing which indices should take in additional values in their average */
-static nc::NdArray<int> Get5X5OverflowArray(const int32 Overflow)
+static TStaticArray<int32, 5> Get5X5OverflowArray(const int32 Overflow)
 {
-	return nc::NdArray<int>({
-		Overflow == 2 || Overflow == 3 || Overflow == 4 ? 1 : 0, Overflow == 4 ? 1 : 0,
-		Overflow == 1 || Overflow == 3 ? 1 : 0, Overflow == 4 ? 1 : 0,
-		Overflow == 2 || Overflow == 3 || Overflow == 4 ? 1 : 0
-	});
+	TStaticArray<int32, 5> Out;
+	Out[0] = Overflow == 2 || Overflow == 3 || Overflow == 4 ? 1 : 0;
+	Out[1] = Overflow == 4 ? 1 : 0;
+	Out[2] = Overflow == 1 || Overflow == 3 ? 1 : 0;
+	Out[3] = Overflow == 4 ? 1 : 0;
+	Out[4] = Overflow == 2 || Overflow == 3 || Overflow == 4 ? 1 : 0;
+	return Out;
 }
 
-/** Returns a 5x5 NdArray, averaging each value from the input array using the smallest amount of surrounding values
- *  as possible. Does not re-use any values from the input array.
+/** Returns an array of Size values containing which indices should take in an additional value when Overflow values
+ *  are left over. The extra values are placed in symmetric pairs from the outside in, and in the middle if Overflow is
+ *  odd. Matches Get5X5OverflowArray when Size is 5.
  *
- *  @param In Any sized rectangular matrix having NumRows rows and NumCols columns
- *  @param NumRows Number of rows in the input matrix
- *  @param NumCols Number of columns in the input matrix
- *  @param bAverage If true, values are averaged, otherwise raw sum
+ *  @param Overflow The number of left over values, less than Size
+ *  @param Size The number of indices to distribute the left over values between
  */
-template <typename T>
-nc::NdArray<T> GetAveraged5X5NdArray(const TArray<T>& In, const int32 NumRows, const int32 NumCols, const bool bAverage)
+static TArray<int32> GetOverflowArray(const int32 Overflow, const int32 Size)
 {
-	// Define the output size of the array (m x n)
-	constexpr int SmallM = 5;
-	constexpr int SmallN = 5;
-
-	nc::NdArray<T> Out = nc::zeros<T>(nc::Shape(SmallM, SmallN));;
+	check(Overflow >= 0 && Overflow < FMath::Max(Size, 1));
 
-	// Define the minimum number of elements that are averaged from input array
-	const int MFloor = FMath::Floor(NumRows / SmallM);
-	const int NFloor = FMath::Floor(NumCols / SmallN);
-
-	// Define which columns/rows will avg extra values if not divisible by 5
-	nc::NdArray<int> MPad = Get5X5OverflowArray(NumRows % SmallM);
-	nc::NdArray<int> NPad = Get5X5OverflowArray(NumCols % SmallN);
-
-	int MPadSum = 0;
-	for (int i = 0; i < SmallM; ++i)
+	TArray<int32> Out;
+	Out.Init(0, Size);
+	for (int32 Pair = 0; Pair < Overflow / 2; Pair++)
 	{
-		int NPadSum = 0;
-		for (int j = 0; j < SmallN; ++j)
-		{
-			T Sum = 0;
-			int Count = 0;
-
-			const int StartM = i * MFloor + MPadSum;
-			const int EndM = StartM + MFloor + MPad(0, i) - 1;
-
-			const int StartN = j * NFloor + NPadSum;
-			const int EndN = StartN + NFloor + NPad(0, j) - 1;
-
-			for (int x = StartM; x <= EndM; ++x)
-			{
-				for (int y = StartN; y <= EndN; ++y)
-				{
-					T Value = In[x * NumCols + y];
-
-					if (Value > 0.f)
-					{
-						Sum += Value;
-						Count += 1;
-					}
-				}
-			}
-			if (Count > 0)
-			{
-				Out(i, j) = static_cast<T>(bAverage ? static_cast<float>(Sum) / Count : Sum);
-			}
-			NPadSum += NPad(0, j);
-		}
-		MPadSum += MPad(0, i);
+		Out[Pair] = 1;
+		Out[Size - 1 - Pair] = 1;
+	}
+	if (Overflow % 2 == 1)
+	{
+		Out[Size / 2] = 1;
 	}
 	return Out;
 }
@@ -138,8 +90,8 @@ TArray<T> GetAveraged5X5TArray(const TArray<T>& In, const int32 NumRows, const i
 	const int NFloor = FMath::Floor(NumCols / SmallN);
 
 	// Define which columns/rows will avg extra values if not divisible by 5
-	nc::NdArray<int> MPad = Get5X5OverflowArray(NumRows % SmallM);
-	nc::NdArray<int> NPad = Get5X5OverflowArray(NumCols % SmallN);
+	const TStaticArray<int32, 5> MPad = Get5X5OverflowArray(NumRows % SmallM);
+	const TStaticArray<int32, 5> NPad = Get5X5OverflowArray(NumCols % SmallN);
 
 	int MPadSum = 0;
 	for (int i = 0; i < SmallM; ++i)
@@ -151,10 +103,10 @@ TArray<T> GetAveraged5X5TArray(const TArray<T>& In, const int32 NumRows, const i
 			int Count = 0;
 
 			const int StartM = i * MFloor + MPadSum;
-			const int EndM = StartM + MFloor + MPad(0, i) - 1;
+			const int EndM = StartM + MFloor + MPad[i] - 1;
 
 			const int StartN = j * NFloor + NPadSum;
-			const int EndN = StartN + NFloor + NPad(0, j) - 1;
+			const int EndN = StartN + NFloor + NPad[j] - 1;
 
 			for (int x = StartM; x <= EndM; ++x)
 			{
@@ -173,9 +125,9 @@ TArray<T> GetAveraged5X5TArray(const TArray<T>& In, const int32 NumRows, const i
 			{
 				Out[i * SmallN + j] = static_cast<T>(bAverage ? static_cast<float>(Sum) / Count : Sum);
 			}
-			NPadSum += NPad(0, j);
+			NPadSum += NPad[j];
 		}
-		MPadSum += MPad(0, i);
+		MPadSum += MPad[i];
 	}
 	return Out;
 }
@@ -205,8 +157,8 @@ inline FAccuracyData GetAveragedAccuracyData(const TArray<int32>& InTotalSpawns,
 	const int NFloor = FMath::Floor(NumCols / SmallN);
 
 	// Define which columns/rows will sum extra values if not divisible by 5
-	nc::NdArray<int> MPad = Get5X5OverflowArray(NumRows % SmallM);
-	nc::NdArray<int> NPad = Get5X5OverflowArray(NumCols % SmallN);
+	const TStaticArray<int32, 5> MPad = Get5X5OverflowArray(NumRows % SmallM);
+	const TStaticArray<int32, 5> NPad = Get5X5OverflowArray(NumCols % SmallN);
 
 	int MPadSum = 0;
 	for (int i = 0; i < SmallM; ++i)
@@ -221,10 +173,10 @@ inline FAccuracyData GetAveragedAccuracyData(const TArray<int32>& InTotalSpawns,
 			auto TotalHitsCount = 0;
 
 			const int StartM = i * MFloor + MPadSum;
-			const int EndM = StartM + MFloor + MPad(0, i) - 1;
+			const int EndM = StartM + MFloor + MPad[i] - 1;
 
 			const int StartN = j * NFloor + NPadSum;
-			const int EndN = StartN + NFloor + NPad(0, j) - 1;
+			const int EndN = StartN + NFloor + NPad[j] - 1;
 
 			for (int x = StartM; x <= EndM; ++x)
 			{
@@ -253,50 +205,52 @@ inline FAccuracyData GetAveragedAccuracyData(const TArray<int32>& InTotalSpawns,
 			{
 				OutData.AccuracyRows[i].TotalHits[j] = static_cast<int64>(TotalHitsSum);
 			}
-			NPadSum += NPad(0, j);
+			NPadSum += NPad[j];
 		}
-		MPadSum += MPad(0, i);
+		MPadSum += MPad[i];
 	}
 	return OutData;
 }
 
 /**
- *	Returns a 25 element map that maps all indices of the input matrix to a 5X5 matrix. Each map element is an index of
- *  the 5X5 matrix which contains an array of indices that it represents. \n\n No two indices of the larger are
- *  represented more than once.
+ *	Returns a NumOutRows * NumOutCols element map that maps all indices of the input matrix to a smaller matrix. Each map
+ *  element is an index of the smaller matrix which contains an array of indices that it represents. \n\n No two
+ *  indices of the larger are represented more than once.
  *  
  *  @param NumRows Number of rows in original matrix
  *  @param NumCols Number of columns in original matrix
+ *  @param NumOutRows Number of rows in the smaller matrix, no greater than NumRows
+ *  @param NumOutCols Number of columns in the smaller matrix, no greater than NumCols
  */
-inline TMap<int32, FGenericIndexMapping> MapMatrixTo5X5(const int32 NumRows, const int32 NumCols)
+inline TMap<int32, FGenericIndexMapping> MapMatrixToSmallerMatrix(const int32 NumRows, const int32 NumCols,
+	const int32 NumOutRows, const int32 NumOutCols)
 {
-	// Define the output size of the array (m x n)
-	constexpr int OutM = 5;
-	constexpr int OutN = 5;
+	check(NumOutRows > 0 && NumOutRows <= NumRows && NumOutCols > 0 && NumOutCols <= NumCols);
 
 	TMap<int32, FGenericIndexMapping> IndexMappings = TMap<int32, FGenericIndexMapping>();
+	IndexMappings.Reserve(NumOutRows * NumOutCols);
 
 	// Define the minimum number of elements that are combined from input array
-	const int MFloor = FMath::Floor(NumRows / OutM);
-	const int NFloor = FMath::Floor(NumCols / OutN);
+	const int MFloor = NumRows / NumOutRows;
+	const int NFloor = NumCols / NumOutCols;
 
-	// Define which columns/rows will get extra values if not divisible by 5
-	nc::NdArray<int> MPad = Get5X5OverflowArray(NumRows % OutM);
-	nc::NdArray<int> NPad = Get5X5OverflowArray(NumCols % OutN);
+	// Define which columns/rows will get extra values if not evenly divisible
+	const TArray<int32> MPad = GetOverflowArray(NumRows % NumOutRows, NumOutRows);
+	const TArray<int32> NPad = GetOverflowArray(NumCols % NumOutCols, NumOutCols);
 
 	int MPadSum = 0;
-	for (int i = 0; i < OutM; ++i)
+	for (int i = 0; i < NumOutRows; ++i)
 	{
 		int NPadSum = 0;
-		for (int j = 0; j < OutN; ++j)
+		for (int j = 0; j < NumOutCols; ++j)
 		{
 			FGenericIndexMapping MappingInst;
 
 			const int StartM = i * MFloor + MPadSum;
-			const int EndM = StartM + MFloor + MPad(0, i) - 1;
+			const int EndM = StartM + MFloor + MPad[i] - 1;
 
 			const int StartN = j * NFloor + NPadSum;
-			const int EndN = StartN + NFloor + NPad(0, j) - 1;
+			const int EndN = StartN + NFloor + NPad[j] - 1;
 
 			for (int x = StartM; x <= EndM; ++x)
 			{
@@ -307,21 +261,12 @@ inline TMap<int32, FGenericIndexMapping> MapMatrixTo5X5(const int32 NumRows, con
 				}
 			}
 
-			MappingInst.Index = i * OutN + j;
+			MappingInst.Index = i * NumOutCols + j;
 			IndexMappings.Add(MappingInst.Index, MappingInst);
 
-			NPadSum += NPad(0, j);
-		}
-		MPadSum += MPad(0, i);
-	}
-
-	TArray<int32> UniqueIndices = TArray<int32>();
-	for (const TPair<int32, FGenericIndexMapping>& IndexMapping : IndexMappings)
-	{
-		for (const int32 Value : IndexMapping.Value.MappedIndices)
-		{
-			UniqueIndices.AddUnique(Value);
+			NPadSum += NPad[j];
 		}
+		MPadSum += MPad[i];
 	}
 	
 	return IndexMappings;
@@ -0,0 +1,333 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include <type_traits>
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+
+/** A dense, row-major matrix used for the QTable and its training samples. Each row is padded to a multiple of
+ *  VectorWidth elements and the storage is 16-byte aligned, so that float row and column reductions can be performed
+ *  with vector registers directly on the stored values. Padding elements are always kept zeroed. None of the
+ *  reductions allocate; results are either returned by value or written to a caller-provided view. */
+template <typename ElementType>
+class TQTable
+{
+	static_assert(std::is_arithmetic_v<ElementType>, "TQTable only supports arithmetic element types.");
+
+	/** Whether or not the reductions use vector registers */
+	static constexpr bool bVectorized = std::is_same_v<ElementType, float>;
+
+public:
+	/** Number of elements in a single vector register, and the multiple each row is padded to */
+	static constexpr int32 VectorWidth = 4;
+
+	TQTable() : NumRows(0), NumCols(0), Stride(0)
+	{}
+
+	TQTable(const int32 InNumRows, const int32 InNumCols)
+	{
+		Init(InNumRows, InNumCols);
+	}
+
+	/** Resizes the table to InNumRows x InNumCols and sets every element to zero. */
+	void Init(const int32 InNumRows, const int32 InNumCols)
+	{
+		NumRows = FMath::Max(0, InNumRows);
+		NumCols = FMath::Max(0, InNumCols);
+		Stride = Align(NumCols, VectorWidth);
+		Data.SetNumUninitialized(NumRows * Stride);
+		Reset();
+	}
+
+	/** Sets every element to zero without changing the size. */
+	void Reset()
+	{
+		FMemory::Memzero(Data.GetData(), Data.Num() * sizeof(ElementType));
+	}
+
+	/** Returns the number of rows. */
+	int32 GetNumRows() const { return NumRows; }
+
+	/** Returns the number of columns, or the length of a row. */
+	int32 GetNumCols() const { return NumCols; }
+
+	/** Returns the number of elements, excluding padding. */
+	int32 Num() const { return NumRows * NumCols; }
+
+	/** Returns true if the table has no elements. */
+	bool IsEmpty() const { return Num() == 0; }
+
+	/** Returns whether or not RowIndex and ColIndex are in range. */
+	bool IsValidIndex(const int32 RowIndex, const int32 ColIndex) const
+	{
+		return RowIndex >= 0 && RowIndex < NumRows && ColIndex >= 0 && ColIndex < NumCols;
+	}
+
+	FORCEINLINE ElementType& operator()(const int32 RowIndex, const int32 ColIndex)
+	{
+		checkSlow(IsValidIndex(RowIndex, ColIndex));
+		return Data[RowIndex * Stride + ColIndex];
+	}
+
+	FORCEINLINE const ElementType& operator()(const int32 RowIndex, const int32 ColIndex) const
+	{
+		checkSlow(IsValidIndex(RowIndex, ColIndex));
+		return Data[RowIndex * Stride + ColIndex];
+	}
+
+	/** Returns a view of a single row, or an empty view if RowIndex is out of range. */
+	TArrayView<ElementType> GetRow(const int32 RowIndex)
+	{
+		if (RowIndex < 0 || RowIndex >= NumRows) return TArrayView<ElementType>();
+		return TArrayView<ElementType>(Data.GetData() + RowIndex * Stride, NumCols);
+	}
+
+	/** Returns a read-only view of a single row, or an empty view if RowIndex is out of range. */
+	TConstArrayView<ElementType> GetRow(const int32 RowIndex) const
+	{
+		if (RowIndex < 0 || RowIndex >= NumRows) return TConstArrayView<ElementType>();
+		return TConstArrayView<ElementType>(Data.GetData() + RowIndex * Stride, NumCols);
+	}
+
+	/** Replaces every NaN with Replacement. Does nothing for integral element types. */
+	void ReplaceNaN(const ElementType Replacement)
+	{
+		if constexpr (bVectorized)
+		{
+			// NaN is the only value that does not compare equal to itself
+			const VectorRegister4Float ReplacementVector = VectorSetFloat1(Replacement);
+			for (int32 Index = 0; Index < Data.Num(); Index += VectorWidth)
+			{
+				const VectorRegister4Float Value = VectorLoadAligned(Data.GetData() + Index);
+				VectorStoreAligned(VectorSelect(VectorCompareNE(Value, Value), ReplacementVector, Value),
+					Data.GetData() + Index);
+			}
+		}
+	}
+
+	/** Returns the sum of a single row. */
+	ElementType RowSum(const int32 RowIndex) const
+	{
+		return ReduceRow<FSumOp>(RowIndex, 0);
+	}
+
+	/** Returns the mean of a single row, or zero if the table has no columns. */
+	float RowMean(const int32 RowIndex) const
+	{
+		return NumCols > 0 ? static_cast<float>(RowSum(RowIndex)) / NumCols : 0.f;
+	}
+
+	/** Returns the maximum of a single row. */
+	ElementType RowMax(const int32 RowIndex) const
+	{
+		check(NumCols > 0);
+		return ReduceRow<FMaxOp>(RowIndex, (*this)(RowIndex, 0));
+	}
+
+	/** Returns the lowest column index holding the maximum of a single row, or INDEX_NONE if the table has no
+	 *  columns. */
+	int32 RowArgMax(const int32 RowIndex) const
+	{
+		if (NumCols == 0) return INDEX_NONE;
+		const ElementType Max = RowMax(RowIndex);
+		const TConstArrayView<ElementType> Row = GetRow(RowIndex);
+		for (int32 ColIndex = 0; ColIndex < NumCols; ColIndex++)
+		{
+			if (Row[ColIndex] == Max) return ColIndex;
+		}
+		return INDEX_NONE;
+	}
+
+	/** Writes the sum of each column to Out, which must have GetNumCols elements. */
+	void ColumnSums(TArrayView<ElementType> Out) const
+	{
+		ReduceColumns<FSumOp>(Out);
+	}
+
+	/** Writes the mean of each column to Out, which must have GetNumCols elements. */
+	void ColumnMeans(TArrayView<float> Out) const
+	{
+		check(Out.Num() == NumCols);
+		if constexpr (bVectorized)
+		{
+			ReduceColumns<FSumOp>(Out);
+			const float Scale = NumRows > 0 ? 1.f / NumRows : 0.f;
+			for (float& Value : Out)
+			{
+				Value *= Scale;
+			}
+		}
+		else
+		{
+			for (int32 ColIndex = 0; ColIndex < NumCols; ColIndex++)
+			{
+				double Sum = 0.0;
+				for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex++)
+				{
+					Sum += (*this)(RowIndex, ColIndex);
+				}
+				Out[ColIndex] = NumRows > 0 ? static_cast<float>(Sum / NumRows) : 0.f;
+			}
+		}
+	}
+
+	/** Writes the maximum of each column to Out, which must have GetNumCols elements. */
+	void ColumnMaxes(TArrayView<ElementType> Out) const
+	{
+		ReduceColumns<FMaxOp>(Out);
+	}
+
+	/** Returns a copy in the column-major layout used by FCommonScoreInfo::QTable and
+	 *  FCommonScoreInfo::TrainingSamples. */
+	TArray<ElementType> ToScoreInfoArray() const
+	{
+		TArray<ElementType> Out;
+		Out.SetNumUninitialized(Num());
+		for (int32 ColIndex = 0; ColIndex < NumCols; ColIndex++)
+		{
+			for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex++)
+			{
+				Out[NumRows * ColIndex + RowIndex] = (*this)(RowIndex, ColIndex);
+			}
+		}
+		return Out;
+	}
+
+	/** Copies values from the column-major layout used by FCommonScoreInfo::QTable and
+	 *  FCommonScoreInfo::TrainingSamples, resizing the table to InNumRows x InNumCols.
+	 *
+	 *  @return false and leaves the table unchanged if In does not have InNumRows * InNumCols elements
+	 */
+	bool InitFromScoreInfoArray(const TArray<ElementType>& In, const int32 InNumRows, const int32 InNumCols)
+	{
+		if (InNumRows < 0 || InNumCols < 0 || In.Num() != InNumRows * InNumCols) return false;
+
+		Init(InNumRows, InNumCols);
+		for (int32 ColIndex = 0; ColIndex < NumCols; ColIndex++)
+		{
+			for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex++)
+			{
+				(*this)(RowIndex, ColIndex) = In[NumRows * ColIndex + RowIndex];
+			}
+		}
+		return true;
+	}
+
+private:
+	struct FSumOp
+	{
+		static FORCEINLINE ElementType Apply(const ElementType A, const ElementType B) { return A + B; }
+
+		static FORCEINLINE VectorRegister4Float Apply(const VectorRegister4Float& A, const VectorRegister4Float& B)
+		{
+			return VectorAdd(A, B);
+		}
+	};
+
+	struct FMaxOp
+	{
+		static FORCEINLINE ElementType Apply(const ElementType A, const ElementType B) { return FMath::Max(A, B); }
+
+		static FORCEINLINE VectorRegister4Float Apply(const VectorRegister4Float& A, const VectorRegister4Float& B)
+		{
+			return VectorMax(A, B);
+		}
+	};
+
+	/** Reduces a single row with OpType, starting from Initial. Whole vectors are reduced lane-wise first, then the
+	 *  lanes and any remaining columns are reduced one at a time, so padding never contributes. */
+	template <typename OpType>
+	ElementType ReduceRow(const int32 RowIndex, const ElementType Initial) const
+	{
+		check(RowIndex >= 0 && RowIndex < NumRows);
+		const ElementType* Row = Data.GetData() + RowIndex * Stride;
+		const int32 NumWholeVectors = NumCols / VectorWidth;
+
+		ElementType Result = Initial;
+		int32 ColIndex = 0;
+		if constexpr (bVectorized)
+		{
+			if (NumWholeVectors > 0)
+			{
+				VectorRegister4Float Accumulator = VectorLoadAligned(Row);
+				for (ColIndex = VectorWidth; ColIndex < NumWholeVectors * VectorWidth; ColIndex += VectorWidth)
+				{
+					Accumulator = OpType::Apply(Accumulator, VectorLoadAligned(Row + ColIndex));
+				}
+				alignas(16) float Lanes[VectorWidth];
+				VectorStoreAligned(Accumulator, Lanes);
+				for (const float Lane : Lanes)
+				{
+					Result = OpType::Apply(Result, Lane);
+				}
+			}
+		}
+		for (; ColIndex < NumCols; ColIndex++)
+		{
+			Result = OpType::Apply(Result, Row[ColIndex]);
+		}
+		return Result;
+	}
+
+	/** Reduces every column with OpType into Out. Columns are processed VectorWidth at a time, accumulating down the
+	 *  rows in a single register. */
+	template <typename OpType, typename OutType>
+	void ReduceColumns(TArrayView<OutType> Out) const
+	{
+		check(Out.Num() == NumCols);
+		if (NumRows == 0)
+		{
+			for (OutType& Value : Out)
+			{
+				Value = 0;
+			}
+			return;
+		}
+
+		if constexpr (bVectorized)
+		{
+			for (int32 ColIndex = 0; ColIndex < NumCols; ColIndex += VectorWidth)
+			{
+				VectorRegister4Float Accumulator = VectorLoadAligned(Data.GetData() + ColIndex);
+				for (int32 RowIndex = 1; RowIndex < NumRows; RowIndex++)
+				{
+					Accumulator = OpType::Apply(Accumulator, VectorLoadAligned(Data.GetData() + RowIndex * Stride +
+						ColIndex));
+				}
+				alignas(16) float Lanes[VectorWidth];
+				VectorStoreAligned(Accumulator, Lanes);
+				const int32 NumLanes = FMath::Min(VectorWidth, NumCols - ColIndex);
+				for (int32 Lane = 0; Lane < NumLanes; Lane++)
+				{
+					Out[ColIndex + Lane] = Lanes[Lane];
+				}
+			}
+		}
+		else
+		{
+			for (int32 ColIndex = 0; ColIndex < NumCols; ColIndex++)
+			{
+				ElementType Result = (*this)(0, ColIndex);
+				for (int32 RowIndex = 1; RowIndex < NumRows; RowIndex++)
+				{
+					Result = OpType::Apply(Result, (*this)(RowIndex, ColIndex));
+				}
+				Out[ColIndex] = static_cast<OutType>(Result);
+			}
+		}
+	}
+
+	/** Row-major elements, each row padded to Stride elements */
+	TArray<ElementType, TAlignedHeapAllocator<16>> Data;
+
+	/** Number of rows */
+	int32 NumRows;
+
+	/** Number of columns, excluding padding */
+	int32 NumCols;
+
+	/** Number of elements between the start of consecutive rows */
+	int32 Stride;
+};
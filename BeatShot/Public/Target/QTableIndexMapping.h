@@ -0,0 +1,65 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpawnAreaBitSet.h"
+
+struct FQTableIndexMapping;
+
+typedef TSharedRef<const FQTableIndexMapping, ESPMode::ThreadSafe> FQTableIndexMappingRef;
+
+/** Groups a grid of Spawn Areas into a smaller grid, where each cell is one state and one action of the QTable.
+ *  Mappings are immutable and shared, and are only generated once for each Spawn Area grid size and resolution. */
+struct BEATSHOT_API FQTableIndexMapping
+{
+	/** Returns the shared mapping for a Spawn Area grid, generating and caching it if it does not exist yet.
+	 *
+	 *  @param NumSpawnAreaRows Number of rows (vertical) in the Spawn Area grid
+	 *  @param NumSpawnAreaCols Number of columns (horizontal) in the Spawn Area grid
+	 *  @param Resolution The number of rows and columns of the QTable grid, or zero to use the Spawn Area grid
+	 *  up to Constants::MaxQTableResolution
+	 */
+	static FQTableIndexMappingRef Get(const int32 NumSpawnAreaRows, const int32 NumSpawnAreaCols,
+		const int32 Resolution);
+
+	/** Returns the number of rows and columns of the QTable grid for a Spawn Area grid, each clamped to the Spawn
+	 *  Area grid and to Constants::MaxQTableResolution.
+	 *
+	 *  @param NumSpawnAreaRows Number of rows (vertical) in the Spawn Area grid
+	 *  @param NumSpawnAreaCols Number of columns (horizontal) in the Spawn Area grid
+	 *  @param Resolution The number of rows and columns of the QTable grid, or zero to use the Spawn Area grid
+	 *  up to Constants::MaxQTableResolution
+	 */
+	static FIntPoint GetGridSize(const int32 NumSpawnAreaRows, const int32 NumSpawnAreaCols, const int32 Resolution);
+
+	FQTableIndexMapping() : NumRows(0), NumCols(0)
+	{}
+
+	/** Returns the number of QTable grid cells, which is the number of QTable rows and columns */
+	int32 Num() const { return NumRows * NumCols; }
+
+	/** Returns the QTable index for a SpawnArea index, or INDEX_NONE if out of range */
+	int32 GetQTableIndex(const int32 SpawnAreaIndex) const
+	{
+		return SpawnAreaToQTableIndex.IsValidIndex(SpawnAreaIndex) ? SpawnAreaToQTableIndex[SpawnAreaIndex] : INDEX_NONE;
+	}
+
+	/** Returns the mask of SpawnArea indices represented by a QTable index */
+	const FSpawnAreaBitSet& GetSpawnAreaMask(const int32 QTableIndex) const
+	{
+		return QTableToSpawnAreaMasks[QTableIndex];
+	}
+
+	/** Number of rows in the QTable grid */
+	int32 NumRows;
+
+	/** Number of columns in the QTable grid */
+	int32 NumCols;
+
+	/** The QTable index of each SpawnArea index */
+	TArray<int32> SpawnAreaToQTableIndex;
+
+	/** The SpawnArea indices represented by each QTable index */
+	TArray<FSpawnAreaBitSet> QTableToSpawnAreaMasks;
+};
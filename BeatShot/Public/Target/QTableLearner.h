@@ -0,0 +1,232 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "ArgMaxTree.h"
+#include "QTable.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+
+class FEvent;
+class FRunnableThread;
+
+/** The parameters for a single QTable update */
+struct FQTableUpdateParams
+{
+	/** The SpawnArea index of the target spawned before the second, only used for logging */
+	int32 SpawnAreaIndex_First;
+
+	/** The SpawnArea index of the target spawned after the first, only used for logging */
+	int32 SpawnAreaIndex_Second;
+
+	/** The reward for spawning a target at the first SpawnArea and then at the second */
+	float Reward;
+
+	/** The QTable row index for the first target */
+	int32 StateIndex;
+
+	/** The QTable column index for the second target */
+	int32 ActionIndex;
+
+	/** The QTable row index of the second target */
+	int32 StateIndex_2;
+
+	/** The QTable column index for the index of maximum reward, starting from State_Index_2 */
+	int32 ActionIndex_2;
+
+	FQTableUpdateParams() : SpawnAreaIndex_First(INDEX_NONE), SpawnAreaIndex_Second(INDEX_NONE), Reward(0.f),
+		StateIndex(INDEX_NONE), ActionIndex(INDEX_NONE), StateIndex_2(INDEX_NONE), ActionIndex_2(INDEX_NONE)
+	{
+	}
+
+	FQTableUpdateParams(const int32 InSpawnAreaIndex_First, const int32 InSpawnAreaIndex_Second, const float InReward,
+		const int32 InStateIndex, const int32 InActionIndex) : SpawnAreaIndex_First(InSpawnAreaIndex_First),
+		SpawnAreaIndex_Second(InSpawnAreaIndex_Second), Reward(InReward), StateIndex(InStateIndex),
+		ActionIndex(InActionIndex), StateIndex_2(INDEX_NONE), ActionIndex_2(INDEX_NONE)
+	{
+	}
+};
+
+/** The QTable, how many times each entry has been trained, and the orderings used to find the best action. The
+ *  learner owns the only mutable instance, and publishes read-only copies of it as snapshots. */
+struct BEATSHOT_API FQTableState
+{
+	FQTableState() : Version(0), TotalTrainingSamples(0)
+	{
+	}
+
+	/** Rebuilds RowArgMaxTrees, RowSums, and RowSumArgMaxTree from the QTable */
+	void InitOrdering();
+
+	/** Sets a single QTable value and updates the orderings for its row and the row sums in O(log N) */
+	void SetValue(const int32 RowIndex, const int32 ColIndex, const float Value);
+
+	/** Returns a read-only view of a single QTable row, or an empty view if RowIndex is out of range */
+	TConstArrayView<float> GetRow(const int32 RowIndex) const;
+
+	/** Incremented each time the learner publishes updates */
+	uint64 Version;
+
+	/** Expected reward from starting at SpawnArea RowIndex and spawning a target at ColumnIndex */
+	TQTable<float> QTable;
+
+	/** A 2D array that holds the number of updates at each QTable index */
+	TQTable<int32> TrainingSamples;
+
+	/** One tree per QTable row, ordering the columns of that row by value */
+	TArray<FArgMaxTree> RowArgMaxTrees;
+
+	/** Sum of each QTable row, accumulated in double precision so that repeated updates do not drift */
+	TArray<double> RowSums;
+
+	/** Orders the QTable rows by RowSums */
+	FArgMaxTree RowSumArgMaxTree;
+
+	/** The number of samples trained with, including previous sessions */
+	int64 TotalTrainingSamples;
+};
+
+/** A versioned, read-only view of the learner's QTable state */
+typedef TSharedPtr<const FQTableState, ESPMode::ThreadSafe> FQTableSnapshot;
+
+/** Applies Q-learning updates off the game thread. The game thread is the only producer of updates, which are passed
+ *  through a single-producer single-consumer queue and applied by a worker thread. A copy of the state is published
+ *  as a new snapshot at most once every MinPublishInterval seconds, or immediately when flushed, which the game thread
+ *  reads to choose actions without ever waiting on the worker. Without a worker, either because Start was never
+ *  called or because the platform does not support multithreading, updates are applied on the calling thread and the
+ *  snapshot is the state itself, since nothing else can change it while it is read. */
+class BEATSHOT_API FQTableLearner final : public FRunnable
+{
+public:
+	/** Maximum number of updates applied before checking whether a snapshot is due */
+	static constexpr int32 MaxBatchSize = 64;
+
+	/** Minimum number of seconds between snapshots published by the worker, so that a burst of rewards does not copy
+	 *  the entire state once per batch */
+	static constexpr double MinPublishInterval = 0.1;
+
+	/** Maximum number of eligibility traces kept for Q(Lambda) updates */
+	static constexpr int32 MaxTraceLength = 16;
+
+	/** Eligibility below which a trace is dropped */
+	static constexpr float MinTraceEligibility = 0.01f;
+
+	/** @param InState The initial state, including orderings
+	 *  @param InAlpha Learning rate
+	 *  @param InGamma Discount factor
+	 *  @param InLambda Trace decay, where zero applies one step updates and anything greater applies Q(Lambda) updates
+	 *  @param InRandomSeed Seed used to break ties between maximum actions
+	 */
+	FQTableLearner(FQTableState&& InState, const float InAlpha, const float InGamma, const float InLambda,
+		const int32 InRandomSeed);
+	virtual ~FQTableLearner() override;
+
+	/** Starts the worker thread. Must be called before any updates are enqueued, if at all. */
+	void Start();
+
+	/** Queues an update to be applied by the worker. Must only be called from the game thread. */
+	void Enqueue(const FQTableUpdateParams& Params);
+
+	/** Blocks until every queued update has been applied and published, publishing immediately if needed. */
+	void Flush();
+
+	/** Returns the most recently published snapshot. */
+	FQTableSnapshot GetSnapshot() const;
+
+	#if !UE_BUILD_SHIPPING
+	/** Whether or not to print QTable updates to log */
+	bool bPrintDebug_QTableUpdate;
+	#endif
+
+	// ~Begin FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// ~End FRunnable
+
+private:
+	/** Applies queued updates in batches, publishing once a snapshot is due. Returns the number applied. */
+	int32 ProcessPendingUpdates();
+
+	/** Returns whether or not unpublished updates should be published now */
+	bool IsPublishDue() const;
+
+	/** Applies a single update to State */
+	void ApplyUpdate(FQTableUpdateParams& Params);
+
+	/** Applies the temporal difference error of an update to every traced QTable entry, then decays the traces */
+	void ApplyTracedUpdate(const FQTableUpdateParams& Params, const float TDError);
+
+	/** Publishes every applied update, copying State to a new snapshot if there is a worker */
+	void PublishSnapshot();
+
+	/** The only mutable instance of the QTable state, owned by the worker once started */
+	TSharedRef<FQTableState, ESPMode::ThreadSafe> State;
+
+	/** Learning rate */
+	float Alpha;
+
+	/** Discount factor */
+	float Gamma;
+
+	/** Trace decay, zero if applying one step updates */
+	float Lambda;
+
+	/** A QTable entry that receives a share of future updates */
+	struct FEligibilityTrace
+	{
+		int32 StateIndex;
+		int32 ActionIndex;
+		float Eligibility;
+	};
+
+	/** Recently updated QTable entries along the current chain of target pairs, oldest first */
+	TArray<FEligibilityTrace, TInlineAllocator<MaxTraceLength + 1>> Traces;
+
+	/** The ActionIndex of the last update, used to tell if the next update continues the chain */
+	int32 LastActionIndex;
+
+	/** Used to break ties between maximum actions */
+	FRandomStream RandomStream;
+
+	/** Reused to hold the actions tied for the maximum */
+	TArray<int32> MaxIndexCandidates;
+
+	/** Updates waiting to be applied */
+	TQueue<FQTableUpdateParams, EQueueMode::Spsc> PendingUpdates;
+
+	/** Number of updates enqueued, only written by the game thread */
+	std::atomic<uint64> NumEnqueued;
+
+	/** Number of updates applied and published, only written by the worker */
+	std::atomic<uint64> NumApplied;
+
+	/** Number of updates applied since the last publish, only accessed by the worker */
+	uint64 NumUnpublished;
+
+	/** Time in seconds of the last publish, only accessed by the worker */
+	double LastPublishTime;
+
+	/** Set by Flush to publish as soon as every pending update is applied */
+	std::atomic<bool> bFlushRequested;
+
+	/** Whether or not updates are applied by a worker, set before the worker is created */
+	bool bHasWorker;
+
+	/** Set when the worker should exit */
+	std::atomic<bool> bStopping;
+
+	/** Wakes the worker when updates are enqueued */
+	FEvent* WorkEvent;
+
+	/** The worker thread, or nullptr if updates are applied on the calling thread */
+	FRunnableThread* Thread;
+
+	/** Guards Snapshot */
+	mutable FCriticalSection SnapshotLock;
+
+	/** The most recently published snapshot */
+	FQTableSnapshot Snapshot;
+};
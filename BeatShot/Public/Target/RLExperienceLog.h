@@ -0,0 +1,97 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBS_DefiningConfig;
+
+/** A transition between two consecutively activated targets, and whether or not the player hit the second one */
+struct FRLExperience
+{
+	/** The SpawnArea index of the first target */
+	int32 PreviousSpawnAreaIndex;
+
+	/** The SpawnArea index of the second target */
+	int32 SpawnAreaIndex;
+
+	/** Whether or not the player hit the second target */
+	bool bHit;
+
+	FRLExperience() : PreviousSpawnAreaIndex(INDEX_NONE), SpawnAreaIndex(INDEX_NONE), bHit(false)
+	{
+	}
+
+	FRLExperience(const int32 InPreviousSpawnAreaIndex, const int32 InSpawnAreaIndex, const bool bInHit) :
+		PreviousSpawnAreaIndex(InPreviousSpawnAreaIndex), SpawnAreaIndex(InSpawnAreaIndex), bHit(bInHit)
+	{
+	}
+};
+
+/** An append-only log of every transition the reinforcement learning agent is rewarded for, one file per game mode,
+ *  so that a QTable can be rebuilt or retrained with different hyperparameters later. Transitions are buffered on
+ *  the calling thread and appended to disk on a background thread in blocks:
+ *
+ *  Magic (uint32), Version (uint8), NumCols, NumRows, NumExperiences, NumBytes (varints), then each experience as
+ *  two varints: ZigZag(Previous - LastIndex) << 1 | bHit, and ZigZag(Current - Previous), where LastIndex is the
+ *  Current of the previous experience in the block, or zero.
+ *
+ *  Consecutive transitions usually share a target, so most experiences take two or three bytes. */
+class BEATSHOT_API FRLExperienceLog
+{
+public:
+	/** Creates the directory of the file if needed
+	 *  @param InFilePath The file to append to
+	 *  @param InSpawnAreaSize (0, NumHorizontal, NumVertical) total spawn areas, written to each block */
+	FRLExperienceLog(const FString& InFilePath, const FIntVector3& InSpawnAreaSize);
+
+	/** Flushes anything still buffered and waits for it to be written, so that the last block is not lost when the
+	 *  session or application ends */
+	~FRLExperienceLog();
+
+	FRLExperienceLog(const FRLExperienceLog&) = delete;
+	FRLExperienceLog& operator=(const FRLExperienceLog&) = delete;
+
+	/** Returns the path of the log for a game mode */
+	static FString GetFilePath(const FBS_DefiningConfig& DefiningConfig);
+
+	/** Encodes a single transition, flushing if enough have been buffered */
+	void Add(const int32 PreviousSpawnAreaIndex, const int32 SpawnAreaIndex, const bool bHit);
+
+	/** Hands everything buffered to the background writer as a single block */
+	void Flush();
+
+	/** Blocks until every flushed block has been written to disk */
+	void WaitForWrites() const;
+
+	/** Reads every experience in a log that was recorded with the same Spawn Area grid as the most recent block.
+	 *  A truncated final block, e.g. from a crash, is ignored.
+	 *
+	 *  @param FilePath The log to read
+	 *  @param OutExperiences Experiences are appended to this array
+	 *  @param OutSpawnAreaSize (0, NumHorizontal, NumVertical) total spawn areas of the returned experiences
+	 *  @return true if at least one experience was read
+	 */
+	static bool Read(const FString& FilePath, TArray<FRLExperience>& OutExperiences, FIntVector3& OutSpawnAreaSize);
+
+	/** Number of payload bytes to buffer before flushing */
+	static constexpr int32 FlushThreshold = 4096;
+
+private:
+	struct FWriter;
+
+	/** Shared with background write tasks so that pending writes outlive the log */
+	TSharedRef<FWriter, ESPMode::ThreadSafe> Writer;
+
+	/** Encoded experiences not yet flushed */
+	TArray<uint8> Payload;
+
+	/** Number of experiences in Payload */
+	int32 NumInPayload;
+
+	/** The SpawnArea index of the last experience added to Payload */
+	int32 LastSpawnAreaIndex;
+
+	/** (0, NumHorizontal, NumVertical) total spawn areas */
+	FIntVector3 SpawnAreaSize;
+};
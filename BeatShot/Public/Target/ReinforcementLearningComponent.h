@@ -4,9 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "BSGameModeDataAsset.h"
-#include "MatrixFunctions.h"
-#include "NumCpp.hpp"
+#include "SaveGamePlayerScore.h"
+#include "QTableIndexMapping.h"
+#include "QTableLearner.h"
+#include "RLExperienceLog.h"
+#include "SpawnAreaBitSet.h"
 #include "Components/ActorComponent.h"
+#include "Containers/Ticker.h"
 #include "ReinforcementLearningComponent.generated.h"
 
 class UCompositeCurveTable;
@@ -54,73 +58,8 @@ public:
 	float GetReward() const { return Reward; }
 };
 
-/** A struct representing the parameters for the QTable Update function */
-USTRUCT()
-struct FQTableUpdateParams
-{
-	GENERATED_BODY()
-
-	/** The pair of targets that were activated */
-	FTargetPair TargetPair;
-
-	/** The QTable row index for the first target */
-	int32 StateIndex;
-
-	/** The QTable column index for the second target */
-	int32 ActionIndex;
-
-	/** The QTable row index of the second target */
-	int32 StateIndex_2;
-
-	/** The QTable column index for the index of maximum reward, starting from State_Index_2 */
-	int32 ActionIndex_2;
-
-	FQTableUpdateParams() : TargetPair(FTargetPair()), StateIndex(-1), ActionIndex(-1),
-		StateIndex_2(-1), ActionIndex_2(-1)
-	{
-	}
-
-	explicit FQTableUpdateParams(const FTargetPair& InTargetPair) : TargetPair(InTargetPair), StateIndex(-1),
-		ActionIndex(-1), StateIndex_2(-1), ActionIndex_2(-1)
-	{
-	}
-};
-
-/** SpawnArea index to QTable Index Pair */
-USTRUCT()
-struct FSpawnAreaQTableIndexPair
-{
-	GENERATED_BODY()
-
-	int32 QTableIndex;
-	int32 SpawnAreaIndex;
-
-	FSpawnAreaQTableIndexPair() : QTableIndex(INDEX_NONE), SpawnAreaIndex(INDEX_NONE)
-	{
-	}
-	
-	FSpawnAreaQTableIndexPair(const int32 InSpawnAreaIndex, const int32 InQTableIndex) :
-		QTableIndex(InQTableIndex),
-		SpawnAreaIndex(InSpawnAreaIndex)
-	{
-	}
-
-	FORCEINLINE bool operator ==(const FSpawnAreaQTableIndexPair& Other) const
-	{
-		if (Other.QTableIndex == QTableIndex && Other.SpawnAreaIndex == SpawnAreaIndex)
-		{
-			return true;
-		}
-		return false;
-	}
-
-	friend FORCEINLINE uint32 GetTypeHash(const FSpawnAreaQTableIndexPair& Struct)
-	{
-		return HashCombine(GetTypeHash(Struct.QTableIndex), Struct.SpawnAreaIndex);
-	}
-};
-
-DECLARE_MULTICAST_DELEGATE_OneParam(FOnQTableUpdate, const TArray<float>& UpdatedQTable);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnQTableUpdate, const TArray<int32>& ChangedIndices,
+	const TArray<float>& ChangedValues);
 
 /** A struct to pass the component upon Initialization */
 USTRUCT()
@@ -132,13 +71,25 @@ struct FRLAgentParams
 	FCommonScoreInfo ScoreInfo;
 	FIntVector3 SpawnAreaSize;
 
-	FRLAgentParams() : AIConfig(FBS_AIConfig()), ScoreInfo(FCommonScoreInfo()), SpawnAreaSize(FIntVector3())
+	/** Whether or not QTable updates are applied on a worker thread. Callers that already run many agents in
+	 *  parallel can disable this to apply updates on the calling thread instead */
+	bool bUseWorkerThread;
+
+	/** If not empty, every rewarded target pair is appended to an FRLExperienceLog at this path */
+	FString ExperienceLogPath;
+
+	/** If set, seeds every random choice made by the agent and its learner so that a run can be reproduced.
+	 *  Otherwise a new seed is generated */
+	TOptional<int32> RandomSeed;
+
+	FRLAgentParams() : AIConfig(FBS_AIConfig()), ScoreInfo(FCommonScoreInfo()), SpawnAreaSize(FIntVector3()),
+		bUseWorkerThread(true)
 	{
 	}
 
 	FRLAgentParams(const FBS_AIConfig& InAIConfig, const FCommonScoreInfo& InScoreInfo,
 		const FIntVector3& InSpawnAreaSize) : AIConfig(InAIConfig), ScoreInfo(InScoreInfo),
-		SpawnAreaSize(InSpawnAreaSize)
+		SpawnAreaSize(InSpawnAreaSize), bUseWorkerThread(true)
 	{
 	}
 };
@@ -170,26 +121,27 @@ public:
 	void AddToActiveTargetPairs(const int32 SpawnAreaIndex_First, const int32 SpawnAreaIndex_Second);
 
 	/** Updates a TargetPair's reward based on if hit or not. SpawnAreaIndex corresponds to TargetPair.Second.
-	 *  Removes from ActiveTargetPairs and adds to TargetPairs queue */
+	 *  Removes from ActiveTargetPairs and queues the reward for the learner to apply off the game thread */
 	void SetActiveTargetPairReward(const int32 SpawnAreaIndex, const bool bHit);
 
-	/** Updates the QTable until TargetPairs queue is empty */
+	/** Blocks until the learner has applied every queued reward, so that the QTable getters are up to date */
 	void ClearCachedTargetPairs();
 
 	/** Returns the SpawnCounter index of the next target to spawn, based on the Epsilon value */
-	int32 ChooseNextActionIndex(const int32 PreviousSpawnAreaIndex, const TArray<int32>& SpawnAreaIndices) const;
+	int32 ChooseNextActionIndex(const int32 PreviousSpawnAreaIndex, const FSpawnAreaBitSet& ValidSpawnAreas) const;
 
 private:
-	/** Returns a random SpawnArea index from the provided SpawnAreaIndices */
-	static int32 ChooseRandomActionIndex(const TArray<int32>& SpawnAreaIndices);
+	/** Returns a random SpawnArea index from the provided ValidSpawnAreas */
+	int32 ChooseRandomActionIndex(const FSpawnAreaBitSet& ValidSpawnAreas) const;
 
-	/** Returns the SpawnArea index that leads to the greatest reward. Calls GetIndices_MaximizeFirst or
-	 *  GetIndices_MaximizeSecond depending on the input previous index and iterates through the indices
-	 *  until it finds a corresponding SpawnArea index from the input array. */
-	int32 ChooseBestActionIndex(const int32 PreviousSpawnAreaIndex, const TArray<int32>& SpawnAreaIndices) const;
+	/** Returns the SpawnArea index that leads to the greatest reward. Uses the row sums if there is no previous index,
+	 *  otherwise the row of the previous index. QTable indices that tie for the maximum are tried in random order,
+	 *  then the remaining QTable indices are visited in descending order until the mask of one intersects
+	 *  ValidSpawnAreas. Returns a random SpawnArea index from that intersection. */
+	int32 ChooseBestActionIndex(const int32 PreviousSpawnAreaIndex, const FSpawnAreaBitSet& ValidSpawnAreas) const;
 
-	/** Updates the QTable from the QTableUpdateParams */
-	virtual void UpdateQTable(FQTableUpdateParams& UpdateParams);
+	/** Returns the latest QTable snapshot published by the learner. The reference is valid until the next call */
+	const FQTableState& GetQTableState() const;
 
 public:
 	/** Returns the number of rows or height */
@@ -198,29 +150,39 @@ public:
 	/** Returns the number of columns or width */
 	int32 GetNumQTableColumns() const { return N; }
 
-	/** Returns the number of training samples the component has trained with this session */
-	int64 GetTotalTrainingSamples() const { return TotalTrainingSamples; }
+	/** Returns the number of rows in the grid that SpawnAreas are grouped into, where each cell is a QTable index */
+	int32 GetNumQTableGridRows() const { return IndexMapping ? IndexMapping->NumRows : 0; }
+
+	/** Returns the number of columns in the grid that SpawnAreas are grouped into, where each cell is a QTable index */
+	int32 GetNumQTableGridColumns() const { return IndexMapping ? IndexMapping->NumCols : 0; }
+
+	/** Returns the number of training samples the component has trained with, as of the latest snapshot */
+	int64 GetTotalTrainingSamples() const { return GetQTableState().TotalTrainingSamples; }
 
 	/** The mode that the RLC is operating in */
 	EReinforcementLearningMode GetRLMode() const { return ReinforcementLearningMode; }
 
-	/** Returns a copy of the QTable */
-	nc::NdArray<float> GetQTable() const { return QTable; }
+	/** Returns a read-only reference to the QTable of the latest snapshot */
+	const TQTable<float>& GetQTable() const { return GetQTableState().QTable; }
+
+	/** Returns a read-only view of a single QTable row of the latest snapshot, or an empty view if RowIndex is out of
+	 *  range */
+	TConstArrayView<float> GetQTableRow(const int32 RowIndex) const { return GetQTableState().GetRow(RowIndex); }
 
 	/** Returns the number of columns (Row Length) for the full QTable */
-	int32 GetQTableRowLength() const { return GetQTable().numCols(); }
+	int32 GetQTableRowLength() const { return GetQTable().GetNumCols(); }
 
-	/** Returns a TArray version of the full QTable */
-	TArray<float> GetTArray_FromNdArray_QTable() const { return GetTArrayFromNdArray<float>(GetQTable()); }
+	/** Returns a TArray version of the full QTable, in the layout used by FCommonScoreInfo */
+	TArray<float> GetTArray_QTable() const { return GetQTable().ToScoreInfoArray(); }
 
-	/** Returns a TArray version of the full TrainingSamples */
-	TArray<int32> GetTArray_FromNdArray_TrainingSamples() const { return GetTArrayFromNdArray<int32>(TrainingSamples); }
+	/** Returns a TArray version of the full TrainingSamples, in the layout used by FCommonScoreInfo */
+	TArray<int32> GetTArray_TrainingSamples() const { return GetQTableState().TrainingSamples.ToScoreInfoArray(); }
 
 	/** Returns a TArray version of the averaged flipped QTable, used to update widget */
-	TArray<float> GetTArray_FromNdArray_QTableAvg() const;
+	TArray<float> GetTArray_QTableAvg() const;
 
 	/** Returns a TArray version of the maximum flipped QTable, used to update widget */
-	TArray<float> GetTArray_FromNdArray_QTableMax() const;
+	TArray<float> GetTArray_QTableMax() const;
 
 private:
 	/** Returns an array of Second Location Indices where the each index represents a column that leads to the greatest reward */
@@ -232,9 +194,6 @@ private:
 	/** Converts a SpawnAreaIndex to a QTableIndex */
 	int32 GetIndex_FromSpawnArea_ToQTable(const int32 SpawnAreaIndex) const;
 
-	/** Returns all SpawnCounter indices corresponding to the QTableIndex */
-	TArray<int32> GetSpawnAreaIndexRange(const int32 QTableIndex) const;
-
 	/** Returns the first TargetPair with the matching CurrentIndex */
 	FTargetPair* FindTargetPairByCurrentIndex(const int32 InCurrentIndex);
 
@@ -244,14 +203,13 @@ private:
 	/** Defines how to use the hyper-parameters Alpha, Gamma, and Epsilon */
 	EReinforcementLearningHyperParameterMode HyperParameterMode;
 
-	/** A 2D array where the row and column have size equal to the number of possible spawn points.
-	 *  An element in the array represents the expected reward from starting at spawn location RowIndex
-	 *  and spawning a target at ColumnIndex. Its a scaled down version of the SpawnArea where each
-	 *  each point in Q-Table represents multiple points in a square area inside the SpawnArea */
-	nc::NdArray<float> QTable;
+	/** Owns the QTable, where an element represents the expected reward from starting at spawn location RowIndex
+	 *  and spawning a target at ColumnIndex. Its a scaled down version of the SpawnArea where each point in Q-Table
+	 *  represents multiple points in a square area inside the SpawnArea. Applies rewards off the game thread */
+	TSharedPtr<FQTableLearner> Learner;
 
-	/** A 2D array that holds the number of updates at each QTable index */
-	nc::NdArray<int32> TrainingSamples;
+	/** The snapshot returned by the last call to GetQTableState, kept alive for the references handed out */
+	mutable FQTableSnapshot CachedSnapshot;
 
 	/** Learning rate, or how much to update the Q-Table rewards when a reward is received */
 	float Alpha;
@@ -263,20 +221,20 @@ private:
 	 *  while a value of zero will result in only choosing the max Q-value (exploitation) */
 	float Epsilon;
 
+	/** Used for every random choice made when choosing actions, seeded in Init */
+	FRandomStream RandomStream;
+
 	/** Number of rows of the QTable */
 	int32 M;
 
 	/** Number of columns of the QTable */
 	int32 N;
 
-	/** An array of structs where each element represents a unique SpawnArea index and QTable index */
-	TArray<FSpawnAreaQTableIndexPair> SpawnAreaToQTableIndexMap;
+	/** Groups SpawnAreas into QTable indices, shared between all components using the same grid and resolution */
+	TSharedPtr<const FQTableIndexMapping, ESPMode::ThreadSafe> IndexMapping;
 
-	/** A map where each key is a QTable row/column that maps to multiple SpawnArea indices */
-	TMap<int32, FGenericIndexMapping> QTableToSpawnAreaIndexMap;
-
-	/** An FIFO queue of (PreviousLocation, NextLocation) that represent destroyed or timed out targets */
-	TQueue<FTargetPair> TargetPairs;
+	/** Records every rewarded target pair to disk, if enabled in FRLAgentParams */
+	TUniquePtr<FRLExperienceLog> ExperienceLog;
 
 	/** An array of (PreviousLocation, NextLocation), where NextLocation has not been destroyed or expired.
 	 *  Added directly after being spawned or activated, removed and added to TargetPairs queue upon being destroyed */
@@ -285,14 +243,14 @@ private:
 	FNumberFormattingOptions IntegerFormatting;
 	FNumberFormattingOptions FloatFormatting;
 
-	/** The number of samples collected starting from when the component was activated */
-	int64 TotalTrainingSamples;
-
 	#if !UE_BUILD_SHIPPING
 	
 public:
-	/** Broadcasts OnQTableUpdate delegate */
-	void UpdateQTableWidget() const;
+	/** Broadcasts the widget cells that changed since the last broadcast through OnQTableUpdate */
+	void UpdateQTableWidget();
+
+	/** Seconds between OnQTableUpdate broadcasts. Updates in between are coalesced into a single broadcast */
+	static constexpr float QTableWidgetUpdateInterval = 0.25f;
 
 	/** Prints the Q-Table to Unreal console */
 	void PrintRewards() const;
@@ -300,8 +258,8 @@ public:
 	/** Prints the MaxIndices and MaxValues corresponding to the choices the component currently has */
 	void PrintMaxAverageIndices() const;
 
-	void PrintGetMaxIndex(const int32 PreviousIndex, const float MaxValue, const nc::NdArray<float>& PreviousRow,
-		const nc::NdArray<unsigned>& ReverseSortedIndices) const;
+	void PrintGetMaxIndex(const int32 PreviousIndex, const float MaxValue, TConstArrayView<float> PreviousRow,
+		const TArray<int32>& MaxIndices) const;
 	
 	/** Delegate that broadcasts when the QTable is updated. Used to broadcast to widgets */
 	FOnQTableUpdate OnQTableUpdate;
@@ -309,6 +267,24 @@ public:
 	/** Whether to broadcast the average or max QTable when broadcasting OnQTableUpdate */
 	bool bBroadcastAverageOnQTableUpdate;
 
+private:
+	/** Calls UpdateQTableWidget if the learner has published a snapshot since the last call */
+	bool TickQTableWidget(float DeltaTime);
+
+	/** Stops calling TickQTableWidget */
+	void RemoveQTableWidgetTicker();
+
+	/** Calls TickQTableWidget every QTableWidgetUpdateInterval */
+	FTSTicker::FDelegateHandle QTableWidgetTickerHandle;
+
+	/** The version of the snapshot last broadcast by UpdateQTableWidget */
+	uint64 LastWidgetSnapshotVersion;
+
+	/** The widget values last broadcast by UpdateQTableWidget */
+	TArray<float> LastWidgetValues;
+
+public:
+
 	/** Whether or not to print QTable initialization to log */
 	bool bPrintDebug_QTableInit;
 
@@ -0,0 +1,329 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** A dense set of Spawn Area indices, stored as one bit per index. All set algebra is performed word-wise on the
+ *  underlying 64-bit words, so combining flags never hashes or allocates per element. Bits beyond NumBits in the last
+ *  word are always kept cleared. */
+struct FSpawnAreaBitSet
+{
+	/** Number of bits in a single word */
+	static constexpr int32 BitsPerWord = 64;
+
+	FSpawnAreaBitSet() : NumBits(0)
+	{}
+
+	explicit FSpawnAreaBitSet(const int32 InNumBits, const bool bValue = false)
+	{
+		Init(InNumBits, bValue);
+	}
+
+	/** Resizes the set to hold InNumBits indices and sets every bit to bValue. */
+	void Init(const int32 InNumBits, const bool bValue = false)
+	{
+		NumBits = FMath::Max(0, InNumBits);
+		Words.Init(bValue ? ~0ull : 0ull, NumWords(NumBits));
+		ClearSlack();
+	}
+
+	/** Clears all bits without changing the number of bits. */
+	void Reset()
+	{
+		FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+	}
+
+	/** Clears all bits and releases the memory. */
+	void Empty()
+	{
+		Words.Empty();
+		NumBits = 0;
+	}
+
+	/** Returns the number of indices this set can hold. */
+	int32 GetMaxIndex() const { return NumBits; }
+
+	/** Returns whether or not the index is in range and set. */
+	FORCEINLINE bool Contains(const int32 Index) const
+	{
+		return Index >= 0 && Index < NumBits && (Words[Index >> 6] & (1ull << (Index & 63))) != 0;
+	}
+
+	/** Sets the bit for Index. */
+	FORCEINLINE void Add(const int32 Index)
+	{
+		check(Index >= 0 && Index < NumBits);
+		Words[Index >> 6] |= 1ull << (Index & 63);
+	}
+
+	/** Clears the bit for Index. Returns 1 if the bit was previously set, otherwise 0. */
+	FORCEINLINE int32 Remove(const int32 Index)
+	{
+		if (!Contains(Index)) return 0;
+		Words[Index >> 6] &= ~(1ull << (Index & 63));
+		return 1;
+	}
+
+	/** Sets or clears every bit from Start up to, but not including, Start + Count. */
+	void SetRange(const int32 Start, const int32 Count, const bool bValue)
+	{
+		check(Start >= 0 && Count >= 0 && Start + Count <= NumBits);
+		const int32 End = Start + Count;
+		int32 Index = Start;
+		while (Index < End)
+		{
+			const int32 Bit = Index & 63;
+			const int32 NumInWord = FMath::Min(BitsPerWord - Bit, End - Index);
+			const uint64 Mask = (NumInWord == BitsPerWord ? ~0ull : (1ull << NumInWord) - 1) << Bit;
+			if (bValue)
+			{
+				Words[Index >> 6] |= Mask;
+			}
+			else
+			{
+				Words[Index >> 6] &= ~Mask;
+			}
+			Index += NumInWord;
+		}
+	}
+
+	/** Returns the number of set bits. */
+	int32 Num() const
+	{
+		int32 Count = 0;
+		for (const uint64 Word : Words)
+		{
+			Count += FPlatformMath::CountBits(Word);
+		}
+		return Count;
+	}
+
+	/** Returns true if no bits are set. */
+	bool IsEmpty() const
+	{
+		for (const uint64 Word : Words)
+		{
+			if (Word) return false;
+		}
+		return true;
+	}
+
+	/** Returns the index of the Nth set bit (zero-based), or INDEX_NONE if there are not enough set bits. */
+	int32 FindNthSetBit(int32 N) const
+	{
+		for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+		{
+			uint64 Word = Words[WordIndex];
+			const int32 WordCount = FPlatformMath::CountBits(Word);
+			if (N >= WordCount)
+			{
+				N -= WordCount;
+				continue;
+			}
+			while (N-- > 0)
+			{
+				Word &= Word - 1;
+			}
+			return WordIndex * BitsPerWord + static_cast<int32>(FPlatformMath::CountTrailingZeros64(Word));
+		}
+		return INDEX_NONE;
+	}
+
+	/** Returns a uniformly random set index using the provided stream, or INDEX_NONE if empty. */
+	int32 GetRandomIndex(const FRandomStream& Stream) const
+	{
+		const int32 Count = Num();
+		return Count > 0 ? FindNthSetBit(Stream.RandRange(0, Count - 1)) : INDEX_NONE;
+	}
+
+	/** Returns the number of indices set in both this set and Other, without building the intersection. */
+	int32 CountIntersection(const FSpawnAreaBitSet& Other) const
+	{
+		check(Other.NumBits == NumBits);
+		int32 Count = 0;
+		for (int32 i = 0; i < Words.Num(); ++i)
+		{
+			Count += FPlatformMath::CountBits(Words[i] & Other.Words[i]);
+		}
+		return Count;
+	}
+
+	/** Returns the index of the Nth (zero-based) index set in both this set and Other, or INDEX_NONE if there are
+	 *  not enough. */
+	int32 FindNthSetBitInIntersection(const FSpawnAreaBitSet& Other, int32 N) const
+	{
+		check(Other.NumBits == NumBits);
+		for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+		{
+			uint64 Word = Words[WordIndex] & Other.Words[WordIndex];
+			const int32 WordCount = FPlatformMath::CountBits(Word);
+			if (N >= WordCount)
+			{
+				N -= WordCount;
+				continue;
+			}
+			while (N-- > 0)
+			{
+				Word &= Word - 1;
+			}
+			return WordIndex * BitsPerWord + static_cast<int32>(FPlatformMath::CountTrailingZeros64(Word));
+		}
+		return INDEX_NONE;
+	}
+
+	/** Bitwise OR with Other. */
+	void UnionWith(const FSpawnAreaBitSet& Other)
+	{
+		check(Other.NumBits == NumBits);
+		for (int32 i = 0; i < Words.Num(); ++i) Words[i] |= Other.Words[i];
+	}
+
+	/** Bitwise AND with Other. */
+	void IntersectWith(const FSpawnAreaBitSet& Other)
+	{
+		check(Other.NumBits == NumBits);
+		for (int32 i = 0; i < Words.Num(); ++i) Words[i] &= Other.Words[i];
+	}
+
+	/** Bitwise AND NOT with Other (removes every index contained in Other). */
+	void DifferenceWith(const FSpawnAreaBitSet& Other)
+	{
+		check(Other.NumBits == NumBits);
+		for (int32 i = 0; i < Words.Num(); ++i) Words[i] &= ~Other.Words[i];
+	}
+
+	/** Bitwise XOR with Other. */
+	void SymmetricDifferenceWith(const FSpawnAreaBitSet& Other)
+	{
+		check(Other.NumBits == NumBits);
+		for (int32 i = 0; i < Words.Num(); ++i) Words[i] ^= Other.Words[i];
+	}
+
+	/** Flips every bit in range. */
+	void Invert()
+	{
+		for (uint64& Word : Words) Word = ~Word;
+		ClearSlack();
+	}
+
+	/** Returns this set union Other. */
+	FSpawnAreaBitSet Union(const FSpawnAreaBitSet& Other) const
+	{
+		FSpawnAreaBitSet Out(*this);
+		Out.UnionWith(Other);
+		return Out;
+	}
+
+	/** Returns this set intersect Other. */
+	FSpawnAreaBitSet Intersect(const FSpawnAreaBitSet& Other) const
+	{
+		FSpawnAreaBitSet Out(*this);
+		Out.IntersectWith(Other);
+		return Out;
+	}
+
+	/** Returns this set difference Other. */
+	FSpawnAreaBitSet Difference(const FSpawnAreaBitSet& Other) const
+	{
+		FSpawnAreaBitSet Out(*this);
+		Out.DifferenceWith(Other);
+		return Out;
+	}
+
+	/** Returns every set index in ascending order. */
+	TArray<int32> Array() const
+	{
+		TArray<int32> Out;
+		Out.Reserve(Num());
+		for (const int32 Index : *this)
+		{
+			Out.Add(Index);
+		}
+		return Out;
+	}
+
+	/** Returns the raw words. */
+	const TArray<uint64>& GetWords() const { return Words; }
+
+	/** Iterates the set indices in ascending order. */
+	class FConstIterator
+	{
+	public:
+		FConstIterator(const FSpawnAreaBitSet& InBitSet, const int32 InWordIndex) : BitSet(InBitSet),
+			WordIndex(InWordIndex), CurrentWord(0)
+		{
+			if (WordIndex < BitSet.Words.Num())
+			{
+				CurrentWord = BitSet.Words[WordIndex];
+				SkipEmptyWords();
+			}
+		}
+
+		FORCEINLINE int32 operator*() const
+		{
+			return WordIndex * BitsPerWord + static_cast<int32>(FPlatformMath::CountTrailingZeros64(CurrentWord));
+		}
+
+		FORCEINLINE FConstIterator& operator++()
+		{
+			CurrentWord &= CurrentWord - 1;
+			SkipEmptyWords();
+			return *this;
+		}
+
+		FORCEINLINE bool operator!=(const FConstIterator& Other) const
+		{
+			return WordIndex != Other.WordIndex || CurrentWord != Other.CurrentWord;
+		}
+
+	private:
+		void SkipEmptyWords()
+		{
+			while (!CurrentWord && ++WordIndex < BitSet.Words.Num())
+			{
+				CurrentWord = BitSet.Words[WordIndex];
+			}
+			if (!CurrentWord) WordIndex = BitSet.Words.Num();
+		}
+
+		const FSpawnAreaBitSet& BitSet;
+		int32 WordIndex;
+		uint64 CurrentWord;
+	};
+
+	FConstIterator begin() const { return FConstIterator(*this, 0); }
+	FConstIterator end() const { return FConstIterator(*this, Words.Num()); }
+
+	FORCEINLINE bool operator==(const FSpawnAreaBitSet& Other) const
+	{
+		return NumBits == Other.NumBits && Words == Other.Words;
+	}
+
+	FORCEINLINE bool operator!=(const FSpawnAreaBitSet& Other) const
+	{
+		return !(*this == Other);
+	}
+
+private:
+	static constexpr int32 NumWords(const int32 InNumBits)
+	{
+		return (InNumBits + BitsPerWord - 1) / BitsPerWord;
+	}
+
+	/** Clears any bits in the last word that are past NumBits. */
+	void ClearSlack()
+	{
+		const int32 Remainder = NumBits & 63;
+		if (Remainder && Words.Num() > 0)
+		{
+			Words.Last() &= (1ull << Remainder) - 1;
+		}
+	}
+
+	/** One bit per Spawn Area index */
+	TArray<uint64> Words;
+
+	/** Number of valid bits */
+	int32 NumBits;
+};
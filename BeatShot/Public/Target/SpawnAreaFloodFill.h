@@ -0,0 +1,83 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpawnAreaBitSet.h"
+
+/** Depth-first flood fill over a grid of Spawn Areas, used to find groups of Spawn Areas that all border at least one
+ *  other. Visited flags are stamped with a generation number so that starting a search never clears an array, the
+ *  stack has a fixed capacity, and the neighbors of every index are precomputed in Init, so nothing is allocated after
+ *  Init. All random choices are made with the stream passed in, so a search is deterministic for a given seed. */
+class BEATSHOT_API FSpawnAreaFloodFill
+{
+public:
+	/** Number of neighbors an index can have, including diagonals */
+	static constexpr int32 NumNeighbors = 8;
+
+	FSpawnAreaFloodFill() : NumRows(0), NumCols(0), Generation(0)
+	{}
+
+	/** Sizes the buffers and precomputes the neighbors for a grid with NumRows and NumCols.
+	 *
+	 *  @param InNumRows total number of Spawn Area rows
+	 *  @param InNumCols total number of Spawn Area columns
+	 */
+	void Init(const int32 InNumRows, const int32 InNumCols);
+
+	/** Finds up to NumToFind valid indices that all border at least one other, starting from a random start index. If
+	 *  the group around a start index is too small, other start indices are tried and the largest group is kept.
+	 *  Start indices are the valid indices bordering exactly one of BorderBlocks, or any valid index if there are none.
+	 *
+	 *  @param Valid a bit set of valid Spawn Area indices to search
+	 *  @param BorderBlocks recent grid blocks that the start index should border, may be empty
+	 *  @param NumToFind the maximum number of indices to find
+	 *  @param Stream the random stream used for all random choices
+	 *  @return a view of the indices found, valid until the next search
+	 */
+	TConstArrayView<int32> FindPath(const FSpawnAreaBitSet& Valid, TConstArrayView<FSpawnAreaBitSet> BorderBlocks,
+		const int32 NumToFind, const FRandomStream& Stream);
+
+private:
+	/** Fills StartCandidates with the valid indices bordering exactly one of BorderBlocks, or every valid index. */
+	void UpdateStartCandidates(const FSpawnAreaBitSet& Valid, TConstArrayView<FSpawnAreaBitSet> BorderBlocks);
+
+	/** Returns whether or not the index has been visited in the current search. */
+	FORCEINLINE bool IsVisited(const int32 Index) const
+	{
+		return VisitedGenerations[Index] == Generation;
+	}
+
+	int32 NumRows;
+	int32 NumCols;
+
+	/** Incremented for each search. An index is visited if its entry in VisitedGenerations matches */
+	uint32 Generation;
+
+	/** Index offset to each neighbor */
+	int32 NeighborOffsets[NumNeighbors];
+
+	/** One bit per neighbor for each index, set if that neighbor is inside the grid */
+	TArray<uint8> NeighborMasks;
+
+	/** The generation each index was last visited in */
+	TArray<uint32> VisitedGenerations;
+
+	/** Fixed capacity stack. Each index pushes at most NumNeighbors others, and is only expanded once */
+	TArray<int32> Stack;
+
+	/** Indices visited from the current start index */
+	TArray<int32> Path;
+
+	/** The largest group of indices found in the current search */
+	TArray<int32> BestPath;
+
+	/** Indices a search can start from */
+	TArray<int32> StartCandidates;
+
+	/** Indices bordering exactly one of the border blocks */
+	FSpawnAreaBitSet Bordering;
+
+	/** Indices bordering the border block currently being processed */
+	FSpawnAreaBitSet Dilated;
+};
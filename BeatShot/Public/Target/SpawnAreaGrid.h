@@ -0,0 +1,308 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TargetCommon.h"
+#include "SpawnAreaBitSet.h"
+
+/** Rows of a disk centered on a Spawn Area's bottom left vertex, measured in Spawn Areas. The row at offset
+ *  (i - HalfHeight) covers the columns from -HalfWidths[i] to HalfWidths[i]. */
+struct FSpawnAreaDiskMask
+{
+	/** Number of rows above and below the center row, or INDEX_NONE if the mask has not been built */
+	int32 HalfHeight = INDEX_NONE;
+
+	/** Number of columns to the left and right of the center column, for each row */
+	TArray<int32> HalfWidths;
+
+	/** Number of columns to the left and right of the center column that the bounding square of the disk spans */
+	int32 MaxHalfWidth = INDEX_NONE;
+
+	bool IsValid() const { return HalfHeight != INDEX_NONE; }
+};
+
+/** Contiguous, struct-of-arrays storage for every Spawn Area inside the total spawn area. A Spawn Area is identified
+ *  only by its index, which is filled bottom-up, left-to-right (Index = Row * NumCols + Col). Geometry and adjacency
+ *  are derived arithmetically from the index, while per-area state lives in parallel arrays. */
+struct BEATSHOT_API FSpawnAreaGrid
+{
+	FSpawnAreaGrid();
+
+	/** Allocates all parallel arrays and resets every Spawn Area to its default state.
+	 *
+	 *  @param InBottomLeft the bottom left vertex of the Spawn Area at index zero
+	 *  @param InNumCols the number of horizontal Spawn Areas
+	 *  @param InNumRows the number of vertical Spawn Areas
+	 *  @param InWidth the width of an individual Spawn Area
+	 *  @param InHeight the height of an individual Spawn Area
+	 *  @param InExtrema the minimum and maximum values of the total spawn area
+	 *  @param InMinDistanceBetweenTargets the minimum distance allowed between the edges of targets
+	 */
+	void Init(const FVector& InBottomLeft, const int32 InNumCols, const int32 InNumRows, const float InWidth,
+		const float InHeight, const FExtrema& InExtrema, const float InMinDistanceBetweenTargets);
+
+	/** Empties all parallel arrays and resets the dimensions. */
+	void Reset();
+
+	/** Returns the total number of Spawn Areas. */
+	int32 Num() const { return NumCols * NumRows; }
+
+	/** Returns the number of horizontal Spawn Areas. */
+	int32 GetNumCols() const { return NumCols; }
+
+	/** Returns the number of vertical Spawn Areas. */
+	int32 GetNumRows() const { return NumRows; }
+
+	/** Returns the width of a Spawn Area. */
+	float GetWidth() const { return Width; }
+
+	/** Returns the height of a Spawn Area. */
+	float GetHeight() const { return Height; }
+
+	/** Returns whether or not the index corresponds to a Spawn Area. */
+	FORCEINLINE bool IsValidIndex(const int32 Index) const { return Index >= 0 && Index < Num(); }
+
+	/** Returns the row of the index. */
+	FORCEINLINE int32 GetRow(const int32 Index) const { return Index / NumCols; }
+
+	/** Returns the column of the index. */
+	FORCEINLINE int32 GetCol(const int32 Index) const { return Index % NumCols; }
+
+	/** Returns the index at the row and column. */
+	FORCEINLINE int32 GetIndex(const int32 Row, const int32 Col) const { return Row * NumCols + Col; }
+
+	/** Returns the column containing the world Y coordinate, clamped to the columns whose bottom left vertex is inside
+	 *  the total spawn area extrema. */
+	FORCEINLINE int32 GetColFromY(const double Y) const
+	{
+		return FMath::Clamp(FMath::FloorToInt32((Y - BottomLeft.Y) / Width + UE_KINDA_SMALL_NUMBER), 0, MaxVertexCol);
+	}
+
+	/** Returns the row containing the world Z coordinate, clamped to the rows whose bottom left vertex is inside the
+	 *  total spawn area extrema. */
+	FORCEINLINE int32 GetRowFromZ(const double Z) const
+	{
+		return FMath::Clamp(FMath::FloorToInt32((Z - BottomLeft.Z) / Height + UE_KINDA_SMALL_NUMBER), 0, MaxVertexRow);
+	}
+
+	/** Returns the inclusive range of columns (X) and rows (Y) whose bottom left vertex is inside InExtrema, where the
+	 *  max extrema are exclusive. The range is empty (Max < Min) if no Spawn Areas are inside. */
+	FIntRect GetWindowFromExtrema(const FExtrema& InExtrema) const;
+
+	/** Returns the index of the Spawn Area containing the world location, clamped to the total spawn area extrema,
+	 *  or INDEX_NONE if the grid is empty. The X component is ignored. */
+	FORCEINLINE int32 GetIndexFromLocation(const FVector& InLocation) const
+	{
+		return Num() > 0 ? GetIndex(GetRowFromZ(InLocation.Z), GetColFromY(InLocation.Y)) : INDEX_NONE;
+	}
+
+	/** Returns the bottom left vertex of the Spawn Area, used for comparison between Spawn Areas. */
+	FORCEINLINE FVector GetBottomLeftVertex(const int32 Index) const
+	{
+		return FVector(BottomLeft.X, BottomLeft.Y + GetCol(Index) * Width, BottomLeft.Z + GetRow(Index) * Height);
+	}
+
+	/** Returns the middle location of the Spawn Area. */
+	FORCEINLINE FVector GetCenterPoint(const int32 Index) const
+	{
+		return GetBottomLeftVertex(Index) + FVector(0.f, Width * 0.5f, Height * 0.5f);
+	}
+
+	/** Returns the type of grid index based on its position in the grid. */
+	EGridIndexType GetIndexType(const int32 Index) const;
+
+	/** Returns the index adjacent to Index in the given direction, or INDEX_NONE if it would fall off the grid. */
+	int32 GetAdjacentIndex(const int32 Index, const EAdjacentDirection Direction) const;
+
+	/** Returns the indices adjacent to Index that match the provided directions. */
+	TArray<int32, TInlineAllocator<8>> GetAdjacentIndices(const int32 Index,
+		const TSet<EAdjacentDirection>& Directions = DirectionTypes::All) const;
+
+	/** Returns whether or not Other borders Index in any direction. */
+	bool IsBorderingIndex(const int32 Index, const int32 Other) const;
+
+	/** Calculates the radius that should be used to make occupied vertices. */
+	float CalcTraceRadius(const FVector& InScale) const;
+
+	/** Returns the number of half Spawn Area sides that the snapped trace radius spans for the scale. Every scale with
+	 *  the same key has the same trace radius, so it is used to look up disk masks. */
+	int32 GetDiskMaskKey(const FVector& InScale) const;
+
+	/** Returns the disk mask of Spawn Areas whose bottom left vertex is inside the trace radius for the key. Masks
+	 *  are built on first use and cached until the grid is reinitialized. */
+	const FSpawnAreaDiskMask& GetDiskMask(const int32 Key) const;
+
+	/** Finds every Spawn Area covered by the occupied vertices of the Spawn Areas in InOccupying, using the larger of
+	 *  each Spawn Area's target scale and InMinScale. Uses the coverage counts maintained as flags change, only
+	 *  temporarily stamping or unstamping the Spawn Areas that differ from them.
+	 *
+	 *  @param InOccupying the Spawn Areas to consider as occupying space
+	 *  @param InMinScale the minimum scale to use for each Spawn Area in InOccupying
+	 *  @param bIncludeManaged whether or not InOccupying is based on managed Spawn Areas, or only activated and
+	 *  recent Spawn Areas
+	 *  @param OutCovered the covered Spawn Areas
+	 */
+	void FindCoveredSpawnAreas(const FSpawnAreaBitSet& InOccupying, const FVector& InMinScale,
+		const bool bIncludeManaged, FSpawnAreaBitSet& OutCovered);
+
+	/** Adds vectors that are inside the sphere if bOccupied is true, otherwise adds vectors outside the sphere but
+	 *  inside its bounding square. Translates and clips the cached disk mask for the scale instead of testing each
+	 *  vertex against the sphere. */
+	TSet<FVector> MakeVerticesBase(const int32 Index, const FVector& InScale, const bool bOccupied) const;
+
+	/** Finds and returns the vertices that overlap with the Spawn Area by tracing a circle around the Spawn Area based
+	 *  on the target scale, minimum distance between targets, minimum overlap radius, and size of the Spawn Area. */
+	TSet<FVector> MakeOccupiedVertices(const int32 Index, const FVector& InScale) const;
+
+	/** Returns the vertices that the Spawn Area did not occupy in space after tracing a sphere based on target scale
+	 *  and other factors. Only used for debug purposes. */
+	TSet<FVector> MakeUnoccupiedVertices(const int32 Index, const FVector& InScale) const;
+
+	/** Returns a random offset between (0, 0, 0) and (0, Width, Height), drawn from Stream. */
+	FVector GenerateRandomOffset(const FRandomStream& Stream) const;
+
+	/** Sets the chosen point to the bottom left vertex plus InOffset. */
+	void SetChosenPoint(const int32 Index, const FVector& InOffset);
+
+	/** Sets the target scale, restamping the Spawn Area's coverage if the trace radius changes. */
+	void SetTargetScale(const int32 Index, const FVector& InScale);
+
+	/** Flags the Spawn Area as corresponding to a target being managed by TargetManager. */
+	void SetIsManaged(const int32 Index, const bool bManaged);
+
+	/** Sets the activated state and the persistently activated state for the Spawn Area. */
+	void SetIsActivated(const int32 Index, const bool bActivated, const bool bAllow = false);
+
+	/** Flags the Spawn Area as recent, and records the time it was set as recent. */
+	void SetIsRecent(const int32 Index, const bool bRecent);
+
+	/** Increments the total amount of spawns, including handling special case where it has not spawned there yet. */
+	void IncrementTotalSpawns(const int32 Index);
+
+	/** Increments the total amount of hits. */
+	void IncrementTotalHits(const int32 Index);
+
+	/** Increments the total amount of tracking damage possible, including handling special case where it has not
+	 *  been possible to deal damage there yet. */
+	void IncrementTotalTrackingDamagePossible(const int32 Index);
+
+	/** Increments the total amount of tracking damage. */
+	void IncrementTotalTrackingDamage(const int32 Index);
+
+	/* -------------------------- */
+	/* -- Per Spawn Area state -- */
+	/* -------------------------- */
+
+	/** Guid associated with a managed target */
+	TArray<FGuid> Guids;
+
+	/** The point chosen after a successful spawn or activation. Will be inside the Spawn Area */
+	TArray<FVector> ChosenPoints;
+
+	/** The scale associated with the target if the Spawn Area is currently representing one. Use SetTargetScale to
+	 *  modify */
+	TArray<FVector> TargetScales;
+
+	/** The time that the Spawn Area was flagged as recent, DBL_MAX if not recent */
+	TArray<double> TimesSetRecent;
+
+	/** The total number of target spawns, INDEX_NONE if never spawned */
+	TArray<int32> TotalSpawns;
+
+	/** The total number of target hits by player */
+	TArray<int32> TotalHits;
+
+	/** The total amount of tracking damage that was possible, INDEX_NONE if never possible */
+	TArray<int32> TotalTrackingDamagePossible;
+
+	/** The total amount of tracking damage that was dealt */
+	TArray<int32> TotalTrackingDamage;
+
+	/** Spawn Areas that correspond to a target being managed by TargetManager */
+	FSpawnAreaBitSet Managed;
+
+	/** Spawn Areas that have a target active */
+	FSpawnAreaBitSet Activated;
+
+	/** Spawn Areas that recently had a target occupy their space */
+	FSpawnAreaBitSet Recent;
+
+	/** Spawn Areas that can be reactivated while activated */
+	FSpawnAreaBitSet AllowActivationWhileActivated;
+
+	#if !UE_BUILD_SHIPPING
+	/** The scale last used to generate debug occupied vertices */
+	TArray<FVector> LastOccupiedVerticesTargetScales;
+
+	/** The occupied vertices last generated for debug drawing */
+	TArray<TSet<FVector>> DebugOccupiedVertices;
+
+	/** Sets the value of DebugOccupiedVertices, LastOccupiedVerticesTargetScales, and returns the
+	 *  DebugOccupiedVertices. */
+	const TSet<FVector>& SetMakeDebugOccupiedVertices(const int32 Index, const FVector& InScale);
+	#endif
+
+private:
+	/** Which coverage counts a Spawn Area is stamped into */
+	enum class ECoverageLayer : uint8
+	{
+		None,
+		/** Activated or recent */
+		Active,
+		/** Managed, but not activated or recent */
+		Managed
+	};
+
+	/** Returns the coverage counts for the layer. */
+	TArray<uint16>& GetCoverage(const ECoverageLayer Layer)
+	{
+		return Layer == ECoverageLayer::Managed ? ManagedCoverage : ActiveCoverage;
+	}
+
+	/** Adds or removes the disk mask for the key, centered on the Spawn Area, to the coverage counts. */
+	void StampCoverage(TArray<uint16>& Coverage, const int32 Index, const int32 Key, const bool bAdd);
+
+	/** Restamps the Spawn Area if its flags or target scale no longer match what is stamped. */
+	void UpdateCoverage(const int32 Index);
+
+	/** Number of occupied vertices of activated or recent Spawn Areas that cover each Spawn Area */
+	TArray<uint16> ActiveCoverage;
+
+	/** Number of occupied vertices of managed-only Spawn Areas that cover each Spawn Area */
+	TArray<uint16> ManagedCoverage;
+
+	/** The layer each Spawn Area is currently stamped into */
+	TArray<ECoverageLayer> StampedLayers;
+
+	/** The disk mask key each Spawn Area is currently stamped with, INDEX_NONE if not stamped */
+	TArray<int32> StampedKeys;
+
+	/** Disk masks indexed by key */
+	mutable TArray<FSpawnAreaDiskMask> DiskMasks;
+
+	/** The last column and row whose bottom left vertex lies inside the total spawn area extrema */
+	int32 MaxVertexCol;
+	int32 MaxVertexRow;
+
+	/** The bottom left vertex of the Spawn Area at index zero */
+	FVector BottomLeft;
+
+	/** The number of horizontal Spawn Areas */
+	int32 NumCols;
+
+	/** The number of vertical Spawn Areas */
+	int32 NumRows;
+
+	/** The width of a Spawn Area in Unreal units */
+	float Width;
+
+	/** The height of a Spawn Area in Unreal units */
+	float Height;
+
+	/** The minimum distance allowed between the edges of targets */
+	float MinDistanceBetweenTargets;
+
+	/** The minimum and maximum values of the total spawn area */
+	FExtrema Extrema;
+};
@@ -5,357 +5,23 @@
 #include "CoreMinimal.h"
 #include "BSGameModeDataAsset.h"
 #include "TargetCommon.h"
+#include "SpawnAreaGrid.h"
+#include "LargestRectangleFinder.h"
+#include "GridBlockFactors.h"
+#include "SpawnAreaFloodFill.h"
 #include "SpawnAreaManagerComponent.generated.h"
 
 class USpawnArea;
 struct FAccuracyData;
 
-struct FIndexPair
-{
-	int32 StartIndex, EndIndex;
-	
-	FIndexPair() : StartIndex(-1), EndIndex(-1)
-	{}
-	FIndexPair(const int32 InStart, const int32 InEnd) : StartIndex(InStart), EndIndex(InEnd)
-	{}
-
-	friend FORCEINLINE uint32 GetTypeHash(const FIndexPair& Other)
-	{
-		return HashCombine(GetTypeHash(Other.StartIndex), GetTypeHash(Other.EndIndex));
-	}
-
-	FORCEINLINE bool operator==(const FIndexPair& Other) const
-	{
-		return StartIndex == Other.StartIndex && EndIndex == Other.EndIndex;
-	}
-
-	FORCEINLINE bool operator<(const FIndexPair& Other) const
-	{
-		if (EndIndex == Other.EndIndex)
-		{
-			return StartIndex < Other.StartIndex;
-		}
-		return EndIndex < Other.EndIndex;
-	}
-};
-
-struct FRectDims
-{
-	int32 Width, Height;
-	
-	FRectDims() : Width(0), Height(0)
-	{}
-	FRectDims(const int32 InWidth, const int32 InHeight) : Width(InWidth), Height(InHeight)
-	{}
-};
-
-/** A unique pair of factors for a number */
-struct FFactor
-{
-	int32 Factor1;
-	int32 Factor2;
-	int32 Distance;
-
-	FFactor(): Factor1(-1), Factor2(-1), Distance(-1)
-	{}
-
-	FFactor(const int32 F1, const int32 F2) : Factor1(F1), Factor2(F2), Distance(abs(F1 - F2))
-	{}
-
-	explicit FFactor(const int32 InDistance) : Factor1(-1), Factor2(-1), Distance(InDistance)
-	{}
-
-	bool IsValid() const
-	{
-		return Factor1 != -1 && Factor2 != -1;
-	}
-
-	FORCEINLINE bool operator==(const FFactor& Other) const
-	{
-		if (Factor1 == Other.Factor1 && Factor2 == Other.Factor2)
-		{
-			return true;
-		}
-		if (Factor1 == Other.Factor2 && Factor2 == Other.Factor1)
-		{
-			return true;
-		}
-		return false;
-	}
-
-	FORCEINLINE bool operator<(const FFactor& Other) const
-	{
-		if (Distance == Other.Distance)
-		{
-			if (Factor1 == Other.Factor1)
-			{
-				return Factor2 < Other.Factor2;
-			}
-			return Factor1 < Other.Factor1;
-		}
-		return Distance < Other.Distance;
-	}
-
-	friend FORCEINLINE uint32 GetTypeHash(const FFactor& Factor)
-	{
-		uint32 Hash = 0;
-
-		const int32 Min = Factor.Factor1 < Factor.Factor2 ? Factor.Factor1 : Factor.Factor2;
-		const int32 Max = Factor.Factor1 < Factor.Factor2 ? Factor.Factor2 : Factor.Factor1;
-
-		Hash = HashCombine(Hash, GetTypeHash(Min));
-		Hash = HashCombine(Hash, GetTypeHash(Max));
-
-		return Hash;
-	}
-};
-
-/** A rectangle with a unique start and end index found within FindLargestRectangle. */
-struct FSubRectangle
-{
-	/** Number of columns in the total spawn area */
-	inline static int32 NumCols = 0;
-
-	/** Index of the element in IndexValidity */
-	int32 Index;
-
-	/** Column index */
-	int32 ColIndex;
-
-	/** The start index (bottom left) and end index (top right) of the sub rectangle */
-	FIndexPair BoundingIndices;
-
-	/** Dimensions of the sub rectangle */
-	FRectDims Dimensions;
-
-	/** Area of the sub rectangle */
-	int32 Area;
-
-	/** Start and end row indices */
-	FIndexPair Row;
-
-	/** Start and end column indices */
-	FIndexPair Col;
-
-	/** Indices that are included within the Index of this rectangle */
-	TSet<int32> AdjacentIndices;
-
-	/** Indices that have been validated as being potential start index candidates */
-	TArray<FIndexPair> StartIndexCandidates;
-	
-	FSubRectangle() : Index(-1), ColIndex(-1), Area(0)
-	{}
-
-	FSubRectangle(const int32 InIndex, const int32 InColIndex, const int32 InHeight) : Index(InIndex),
-		ColIndex(InColIndex), Dimensions(0, InHeight), Area(0)
-	{}
-
-	/** Updates the width, StartEndIndex, Dimensions, Area, Row, and Col. */
-	void UpdateDimensions(const int32 InNewWidth)
-	{
-		Dimensions.Width = InNewWidth;
-		BoundingIndices.StartIndex = Index - NumCols * (Dimensions.Height - 1);
-		BoundingIndices.EndIndex = Index + (Dimensions.Width - 1);
-		Area = Dimensions.Width * Dimensions.Height;
-		Row = FIndexPair(BoundingIndices.StartIndex / NumCols, BoundingIndices.EndIndex / NumCols);
-		Col = FIndexPair(BoundingIndices.StartIndex % NumCols, BoundingIndices.EndIndex % NumCols);
-	}
-
-	/** Returns whether or not the rectangle has area greater than 1 and the EndIndex is greater than StartIndex */
-	bool IsValid() const
-	{
-		return Area > 0 && BoundingIndices.EndIndex > BoundingIndices.StartIndex;
-	}
-
-	FString ToString() const
-	{
-		return FString::Printf(TEXT("Index: [%d, %d] Size: %dx%d"), BoundingIndices.StartIndex,
-			BoundingIndices.EndIndex, Dimensions.Width, Dimensions.Height);
-	}
-	
-	FORCEINLINE bool operator==(const FSubRectangle& Other) const
-	{
-		return BoundingIndices == Other.BoundingIndices;
-	}
-	
-	FORCEINLINE bool operator<(const FSubRectangle& Other) const
-	{
-		return BoundingIndices < Other.BoundingIndices;
-	}
-	
-	friend FORCEINLINE uint32 GetTypeHash(const FSubRectangle& Other)
-	{
-		return GetTypeHash(Other.BoundingIndices);
-	}
-
-	static void SetNumCols(const int32 InNumCols) { NumCols = InNumCols; }
-};
-
-/** KeyFuncs for a set of FSubRectangles. Uses FIndexPair as set key. */
-struct FFSubRectangleKeyFuncs : BaseKeyFuncs<FSubRectangle, FIndexPair, false>
-{
-	/** Compares two keys for equality */
-	static FORCEINLINE bool Matches(const FIndexPair& A, const FIndexPair& B)
-	{
-		return A == B;
-	}
-	/** Calculates a hash index for a key. */
-	static FORCEINLINE uint32 GetKeyHash(const FIndexPair& Key)
-	{
-		return GetTypeHash(Key);
-	}
-	/** Extracts the key from an element. */
-	static FORCEINLINE const FIndexPair& GetSetKey(const FSubRectangle& Element)
-	{
-		return Element.BoundingIndices;
-	}
-};
-
-/** Contains info about a candidate for a GridBlock largest rectangle. */
-struct FRectCandidate
-{
-	/** The factor for this candidate */
-	FFactor Factor;
-	
-	/** (ChosenStartRowIndex, ChosenEndRowIndex) */
-	FIndexPair ChosenRow;
-
-	/** (ChosenStartColIndex, ChosenEndColIndex) */
-	FIndexPair ChosenCol;
-	
-	/** Sub rectangles within this rectangle candidate */
-	TSet<FSubRectangle, FFSubRectangleKeyFuncs> SubRectangles;
-
-	/** Chosen sub rectangle */
-	FSubRectangle ChosenSubRectangle;
-
-	/** The number of rows in the largest rectangle found */
-	int32 NumRowsAvailable;
-
-	/** The number of cols in the largest rectangle found */
-	int32 NumColsAvailable;
-
-	/** The true size of the block. Set to min(Area, BlockSize) */
-	int32 ActualBlockSize;
-
-	/** The size of the block used to set the Chosen Start/End Row/Col Indices */
-	int32 ChosenBlockSize;
-
-	FRectCandidate(): NumRowsAvailable(0), NumColsAvailable(0), ActualBlockSize(0), ChosenBlockSize(0)
-	{}
-
-	explicit FRectCandidate(const FFactor& InFactor) : Factor(InFactor), NumRowsAvailable(-1), NumColsAvailable(-1),
-		ActualBlockSize(-1), ChosenBlockSize(-1)
-	{}
-
-	~FRectCandidate() = default;
-	
-	/** Updates the candidate with new dimensions and indices. */
-	void UpdateSubRectangles(const FSubRectangle& SubRectangle)
-	{
-		SubRectangles.Add(SubRectangle);
-	}
-
-	/** Merges similar sub rectangles. */
-	void MergeSubRectangles();
-	
-	/** Sets the value of ChosenSubRectangle. Updates NumRowsAvailable, NumColsAvailable, ActualBlockSize, 
-	 *  and initializes the ChosenRow, ChosenCol to SubRectangle.Row, SubRectangle.Col. */
-	void SetChosenSubRectangle(const FSubRectangle& SubRectangle, const int32 InBlockSize)
-	{
-		ChosenSubRectangle = SubRectangle;
-		
-		NumRowsAvailable = SubRectangle.Row.EndIndex - SubRectangle.Row.StartIndex + 1;
-		NumColsAvailable = SubRectangle.Col.EndIndex - SubRectangle.Col.StartIndex + 1;
-		ActualBlockSize = FMath::Min(InBlockSize, SubRectangle.Area);
-
-		ChosenRow = SubRectangle.Row;
-		ChosenCol = SubRectangle.Col;
-	}
-	
-	/** Returns true if the first factor is less than number of rows available and the second factor is less than the
-     *  number of columns available. */
-	bool FirstFactorComboFits() const
-	{
-		const bool bF1FitsRows = Factor.Factor1 <= NumRowsAvailable;
-		const bool bF2FitsCols = Factor.Factor2 <= NumColsAvailable;
-		return bF1FitsRows && bF2FitsCols;
-	}
-
-	/** Returns true if the first factor is less than number of columns available and the second factor is less than the
-	 *  number of rows available. */
-	bool SecondFactorComboFits() const
-	{
-		const bool bF1FitsCols = Factor.Factor1 <= NumColsAvailable;
-		const bool bF2FitsRows = Factor.Factor2 <= NumRowsAvailable;
-		return bF2FitsRows && bF1FitsCols;
-	}
-
-	/** Returns true if both factors fit. */
-	bool AllFactorsFit() const
-	{
-		return FirstFactorComboFits() && SecondFactorComboFits();
-	}
-
-	/** Returns true if the ChosenSubRectangle is valid. */
-	bool HasChosenSubRectangle() const
-	{
-		return ChosenSubRectangle.IsValid();
-	}
-
-	/** Returns a human-readable string of the rectangle. */
-	FString ToString() const
-	{
-		return FString::Printf(TEXT("Candidate [%d, %d]"), Factor.Factor1,Factor.Factor2);
-	}
-	
-	FORCEINLINE bool operator<(const FRectCandidate& Other) const
-	{
-		// Sort by factor
-		return Factor < Other.Factor;
-	}
-
-	FORCEINLINE bool operator==(const FRectCandidate& Other) const
-	{
-		return Factor == Other.Factor;
-	}
-
-	friend FORCEINLINE uint32 GetTypeHash(const FRectCandidate& Factor)
-	{
-		return GetTypeHash(Factor.Factor);
-	}
-};
-
-/** KeyFuncs for a set of FRectCandidates. Uses FFactor as set key. */
-struct FLargestRectangleKeyFuncs : BaseKeyFuncs<FRectCandidate, FFactor, false>
-{
-	/** Compares two keys for equality */
-	static FORCEINLINE bool Matches(const FFactor& A, const FFactor& B)
-	{
-		return A == B;
-	}
-	/** Calculates a hash index for a key. */
-	static FORCEINLINE uint32 GetKeyHash(const FFactor& Key)
-	{
-		return GetTypeHash(Key);
-	}
-	/** Extracts the key from an element. */
-	static FORCEINLINE const FFactor& GetSetKey(const FRectCandidate& Element)
-	{
-		return Element.Factor;
-	}
-};
-
-typedef TSet<FSubRectangle, FFSubRectangleKeyFuncs> FSubRectangleSet;
-typedef TSet<FRectCandidate, FLargestRectangleKeyFuncs> FRectangleSet;
-
-/** Class responsible for creating and managing Spawn Area objects. */
+/** Class responsible for creating and managing Spawn Areas, which are stored in an FSpawnAreaGrid. */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class BEATSHOT_API USpawnAreaManagerComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
 	friend class FTargetCollisionTest;
+	friend class FSpawnSelectionBenchmark;
 	friend class ABeatShotGameModeFunctionalTest;
 public:
 	USpawnAreaManagerComponent();
@@ -376,6 +42,10 @@ public:
 	/** Resets all variables */
 	void Clear();
 
+	/** Seeds every random Spawn Area selection from now on, instead of generating a new seed each time the Spawn
+	 *  Areas are initialized, so that a run can be reproduced. Not reset by Clear. */
+	void SetRandomSeed(const int32 Seed);
+
 	/** Get the value of SpawnAreaDimensions.
 	 * 	@return (0, Height, Width) of all SpawnAreas
 	 */
@@ -406,25 +76,25 @@ public:
 	 */
 	void HandleTargetDamageEvent(const FTargetDamageEvent& DamageEvent);
 
-	/** Called when the BoxBounds of the TargetManager are changed to update CachedExtrema or CachedEdgeOnly sets.
+	/** Called when the BoxBounds of the TargetManager are changed to update CachedExtrema.
 	 * 	@param Extrema the current extrema of the total spawn area
 	 */
 	void OnExtremaChanged(const FExtrema& Extrema);
 
-	/** Get the number of elements in the CachedActivated set.
+	/** Get the number of Spawn Areas flagged as activated.
 	 * 	@return number of activated Spawn Areas
 	 */
-	int32 GetNumActivated() const { return CachedActivated.Num(); }
+	int32 GetNumActivated() const { return SpawnAreas.Activated.Num(); }
 
 	/** Get the number of Spawn Areas that are flagged as managed but not activated.
 	 * 	@return number of deactivated Spawn Areas
 	 */
 	int32 GetNumDeactivated() const { return GetDeactivatedSpawnAreas().Num(); }
 
-	/** Get the number of elements in the CachedManaged set.
+	/** Get the number of Spawn Areas flagged as managed.
 	 * 	@return number of managed Spawn Areas
 	 */
-	int32 GetNumManaged() const { return CachedManaged.Num(); }
+	int32 GetNumManaged() const { return SpawnAreas.Managed.Num(); }
 
 	/** Gathers all total hits and total spawns for the game mode session and converts them into a 5X5 matrix using
 	 *  GetAveragedAccuracyData. Calls UpdateAccuracy once the values are copied over, and returns the struct */
@@ -435,25 +105,31 @@ public:
 	 */
 	int32 GetMostRecentSpawnAreaIndex() const;
 
-	/** Get a Spawn Area's index based on TargetGuid.
+	/** Get a Spawn Area's index based on TargetGuid using the GuidMap for lookup.
 	 *  @return the index of the found Spawn Area, or -1 if invalid
 	 */
 	int32 GetSpawnAreaIndex(const FGuid& TargetGuid) const;
 
 protected:
-	/** Sets the value of MostRecentSpawnArea.
-	 * 	@param SpawnArea the Spawn Area to assign as the most recent spawn area
+	/** Sets the value of MostRecentSpawnAreaIndex.
+	 * 	@param Index the index of the Spawn Area to assign as the most recent spawn area
 	 */
-	void SetMostRecentSpawnArea(USpawnArea* SpawnArea) { MostRecentSpawnArea = SpawnArea; }
+	void SetMostRecentSpawnAreaIndex(const int32 Index) { MostRecentSpawnAreaIndex = Index; }
 
 	/** Sets the value of SpawnAreaDimensions based on the Target Distribution Policy
 	 *  and PreferredSpawnAreaDimensions. */
 	void SetSpawnAreaDimensions();
 
-	/** Initializes all static variables for Spawn Areas, Sets the TotalSpawnAreaSize, creates all Spawn Area objects,
-	 *  and adds them to the SpawnAreas set and AreaKeyMap. Initializes CachedExtrema with all Spawn Areas. */
+	/** Sets the TotalSpawnAreaSize and initializes the SpawnAreas grid. Initializes CachedExtrema with all Spawn
+	 *  Areas. */
 	void InitializeSpawnAreas();
 
+	/** Updates CachedExtrema from CachedExtremaWindow to NewWindow, only touching the rows and columns that enter or
+	 *  leave the window.
+	 *  @param NewWindow the inclusive columns (X) and rows (Y) that should be contained in CachedExtrema
+	 */
+	void UpdateCachedExtremaWindow(const FIntRect& NewWindow);
+
 	/** Use the target spawning policy to decide to consider Managed SpawnAreas as invalid choices for activation.
 	 * 	@return whether or not to consider Managed SpawnAreas as invalid choices for activation
 	 */
@@ -463,103 +139,92 @@ protected:
 	/* -- SpawnArea finders/getters -- */
 	/* ------------------------------- */
 	
-	/** Finds a SpawnArea using its index as an FSetElementId.
-	 *  @return Spawn Area found by its index
+	/** Finds the index of the SpawnArea containing InLocation, clamped to the StaticExtrema.
+	 *  @return the index of the Spawn Area found by its location, or -1 if invalid
 	 */
-	USpawnArea* GetSpawnArea(const int32 Index) const;
+	int32 GetSpawnAreaIndex(const FVector& InLocation) const;
 
-	/** Finds a SpawnArea with the matching InLocation using the AreaKeyMap for lookup.
-	 *  @return Spawn Area found by its location
+	/** Get the value of OriginSpawnAreaIndex.
+	 * 	@return the index of the SpawnArea containing the origin, or -1 if invalid
 	 */
-	USpawnArea* GetSpawnArea(const FVector& InLocation) const;
-
-	/** Finds a SpawnArea with the matching TargetGuid using the GuidMap for lookup.
-	 *  @return Spawn Area found by its TargetGuid
-	 */
-	USpawnArea* GetSpawnArea(const FGuid& TargetGuid) const;
-
-	/** Get the value of MostRecentSpawnArea.
-	 * 	@return the most recent SpawnArea that was set at the end of ATargetManager::ActivateTarget
-	 */
-	USpawnArea* GetMostRecentSpawnArea() const { return MostRecentSpawnArea; }
-
-	/** Get the value of OriginSpawnArea.
-	 * 	@return the SpawnArea containing the origin
-	 */
-	USpawnArea* GetOriginSpawnArea() const { return OriginSpawnArea; }
+	int32 GetOriginSpawnAreaIndex() const { return OriginSpawnAreaIndex; }
 
 	/** Finds the oldest SpawnArea flagged as recent using each Spawn Area's TimeSetRecent.
-	 * 	@return the oldest SpawnArea flagged as recent
+	 * 	@return the index of the oldest SpawnArea flagged as recent, or -1 if none
 	 */
-	USpawnArea* GetOldestRecentSpawnArea() const;
+	int32 GetOldestRecentSpawnAreaIndex() const;
 
 	/** Finds the oldest SpawnArea flagged as deactivated, managed, and recent.
-	 * 	@return the oldest SpawnArea flagged as deactivated and managed
+	 * 	@return the index of the oldest SpawnArea flagged as deactivated and managed, or -1 if none
 	 */
-	USpawnArea* GetOldestDeactivatedSpawnArea() const;
+	int32 GetOldestDeactivatedSpawnAreaIndex() const;
 
 	/** Find out if a SpawnArea is valid based on an index value.
 	 *
 	 *	@param InIndex the index to check
 	 * 	@return whether or not the SpawnArea is contained in SpawnAreas
 	 */
-	bool IsSpawnAreaValid(const int32 InIndex) const;
+	bool IsSpawnAreaValid(const int32 InIndex) const { return SpawnAreas.IsValidIndex(InIndex); }
 
-	/** Get the value of CachedManaged.
-	 * 	@return a set of SpawnAreas that are flagged as currently managed
+	/** Get the SpawnAreas grid.
+	 * 	@return a const reference to the grid storing all Spawn Area state
 	 */
-	TSet<USpawnArea*> GetManagedSpawnAreas() const;
+	const FSpawnAreaGrid& GetSpawnAreaGrid() const { return SpawnAreas; }
 
-	/** Get the value of CachedManaged difference CachedActivated.
-	 * 	@return a set of SpawnAreas that are flagged as currently managed and not flagged as activated
+	/** Get the Spawn Areas flagged as managed.
+	 * 	@return a bit set of Spawn Area indices that are flagged as currently managed
 	 */
-	TSet<USpawnArea*> GetDeactivatedSpawnAreas() const;
+	const FSpawnAreaBitSet& GetManagedSpawnAreas() const { return SpawnAreas.Managed; }
 
-	/** Get the value of CachedRecent.
-	 * 	@return a set of SpawnAreas that are flagged as recent
+	/** Get the value of Managed AND NOT Activated.
+	 * 	@return a bit set of Spawn Area indices that are flagged as currently managed and not flagged as activated
 	 */
-	TSet<USpawnArea*> GetRecentSpawnAreas() const;
+	FSpawnAreaBitSet GetDeactivatedSpawnAreas() const;
 
-	/** Get the value of CachedActivated.
-	 * 	@return a set of SpawnAreas that are flagged as activated
+	/** Get the Spawn Areas flagged as recent.
+	 * 	@return a bit set of Spawn Area indices that are flagged as recent
 	 */
-	TSet<USpawnArea*> GetActivatedSpawnAreas() const;
+	const FSpawnAreaBitSet& GetRecentSpawnAreas() const { return SpawnAreas.Recent; }
 
-	/** Get the value of CachedActivated union CachedRecent.
-	 *  @return a set of SpawnAreas containing only SpawnAreas flagged as activated or recent
+	/** Get the Spawn Areas flagged as activated.
+	 * 	@return a bit set of Spawn Area indices that are flagged as activated
 	 */
-	TSet<USpawnArea*> GetActivatedOrRecentSpawnAreas() const;
+	const FSpawnAreaBitSet& GetActivatedSpawnAreas() const { return SpawnAreas.Activated; }
 
-	/** Get the value of CachedManaged union CachedActivated union CachedRecent.
-	 *  @return a set of SpawnAreas containing SpawnAreas flagged as managed, activated, or recent
+	/** Get the value of Activated OR Recent.
+	 *  @return a bit set of Spawn Area indices flagged as activated or recent
 	 */
-	TSet<USpawnArea*> GetManagedActivatedOrRecentSpawnAreas() const;
+	FSpawnAreaBitSet GetActivatedOrRecentSpawnAreas() const;
 
-	/** Get the value of CachedManaged difference (CachedActivated union CachedRecent)
-	 *  @return a set of SpawnAreas containing SpawnAreas flagged as managed, not activated, and not recent
+	/** Get the value of Managed OR Activated OR Recent.
+	 *  @return a bit set of Spawn Area indices flagged as managed, activated, or recent
 	 */
-	TSet<USpawnArea*> GetManagedDeactivatedNotRecentSpawnAreas() const;
+	FSpawnAreaBitSet GetManagedActivatedOrRecentSpawnAreas() const;
 
-	/** Get the value of SpawnAreas difference CachedManaged difference CachedActivated difference CachedRecent.
-	 *  @return a set of SpawnAreas containing SpawnAreas not flagged with anything
+	/** Get the value of Managed AND NOT (Activated OR Recent).
+	 *  @return a bit set of Spawn Area indices flagged as managed, not activated, and not recent
 	 */
-	TSet<USpawnArea*> GetUnflaggedSpawnAreas() const;
+	FSpawnAreaBitSet GetManagedDeactivatedNotRecentSpawnAreas() const;
+
+	/** Get the value of NOT (Managed OR Activated OR Recent).
+	 *  @return a bit set of Spawn Area indices not flagged with anything
+	 */
+	FSpawnAreaBitSet GetUnflaggedSpawnAreas() const;
 
 	/* ------------------------ */
 	/* -- SpawnArea flagging -- */
 	/* ------------------------ */
 
 public:
-	/** Adds to Managed and Deactivated cache, adds to GuidMap, and flags the SpawnArea as being actively managed by
-	 *  TargetManager. Calls SetOccupiedVertices.
+	/** Adds to GuidMap, and flags the SpawnArea as being actively managed by TargetManager, which also makes its
+	 *  occupied vertices.
 	 *  
 	 *  @param SpawnAreaIndex the index of the Spawn Area to flag as managed
 	 *  @param TargetGuid the TargetGuid to set on the Spawn Area
 	 */
 	void FlagSpawnAreaAsManaged(const int32 SpawnAreaIndex, const FGuid TargetGuid);
 
-	/** Adds to Activated cache, removes from Deactivate cache, and flags the SpawnArea as activated and removes the
-	 *  recent flag if present.
+	/** Flags the SpawnArea as activated and removes the recent flag if present.
 	 *  
 	 *  @param TargetGuid the TargetGuid to find the Spawn Area by
 	 *  @param TargetScale the TargetScale to set on the Spawn Area
@@ -567,28 +232,27 @@ public:
 	void FlagSpawnAreaAsActivated(const FGuid TargetGuid, const FVector& TargetScale);
 
 protected:
-	/** Adds to Recent cache and flags the SpawnArea as recent. Handles recent flag removal by setting a timer,
-	 *  refreshing recent flags, or immediately removing the recent flag.
-	 *  @param SpawnArea the Spawn Area to set as recent
+	/** Flags the SpawnArea as recent. Handles recent flag removal by setting a timer, refreshing recent flags, or
+	 *  immediately removing the recent flag.
+	 *  @param Index the index of the Spawn Area to set as recent
 	 */
-	void FlagSpawnAreaAsRecent(USpawnArea* SpawnArea);
+	void FlagSpawnAreaAsRecent(const int32 Index);
 
-	/** Removes from Managed cache, removes from Deactivated cache, removes from GuidMap, and removes the Managed flag,
-	 *  meaning the target that the SpawnArea represents is not longer actively managed by TargetManager.
+	/** Removes from GuidMap and removes the Managed flag, meaning the target that the SpawnArea represents is not
+	 *  longer actively managed by TargetManager.
 	 *  @param TargetGuid the TargetGuid to find the Spawn Area by
 	 */
 	void RemoveManagedFlagFromSpawnArea(const FGuid TargetGuid);
 
-	/** Removes from Activated cache, adds to Deactivated cache, and removes the activated flag.
-	 * 	@param SpawnArea the Spawn Area to remove the activated flag from
+	/** Removes the activated flag.
+	 * 	@param Index the index of the Spawn Area to remove the activated flag from
 	 */
-	void RemoveActivatedFlagFromSpawnArea(USpawnArea* SpawnArea);
+	void RemoveActivatedFlagFromSpawnArea(const int32 Index);
 
-	/** Removes from Recent cache and removes the Recent flag, meaning the SpawnArea is not longer being considered as
-	 *  a blocked SpawnArea. SpawnAreas empty their OccupiedVertices when their Recent Flag is removed.
-	 *  @param SpawnArea the Spawn Area to remove the recent flag from
+	/** Removes the Recent flag, meaning the SpawnArea is not longer being considered as a blocked SpawnArea.
+	 *  @param Index the index of the Spawn Area to remove the recent flag from
 	 */
-	void RemoveRecentFlagFromSpawnArea(USpawnArea* SpawnArea);
+	void RemoveRecentFlagFromSpawnArea(const int32 Index);
 
 	/** Removes the oldest SpawnArea recent flags if the max number of recent targets has been exceeded */
 	void RefreshRecentFlags();
@@ -623,197 +287,104 @@ protected:
 	 *  meaning that it corresponds to a valid target. Priority is origin (setting permitting), reinforcement learning
 	 *  component (setting permitting), and lastly chooses a random index of ValidSpawnAreas.
 	 *
-	 *  @param PreviousSpawnArea the previously selected Spawn Area to activate
-	 *  @param ValidSpawnAreas a set of valid Spawn Areas to choose from
-	 *  @param SelectedSpawnAreas a set of Spawn Areas already chosen to activate
-	 *  @return the Spawn Area to activate, or nullptr if none found
+	 *  @param PreviousIndex the index of the previously selected Spawn Area to activate
+	 *  @param ValidSpawnAreas a bit set of valid Spawn Area indices to choose from
+	 *  @param SelectedSpawnAreas a bit set of Spawn Area indices already chosen to activate
+	 *  @return the index of the Spawn Area to activate, or -1 if none found
 	 */
-	USpawnArea* ChooseActivatableSpawnArea(const USpawnArea* PreviousSpawnArea,
-		const TSet<USpawnArea*>& ValidSpawnAreas, const TSet<USpawnArea*>& SelectedSpawnAreas) const;
+	int32 ChooseActivatableSpawnArea(const int32 PreviousIndex, const FSpawnAreaBitSet& ValidSpawnAreas,
+		const FSpawnAreaBitSet& SelectedSpawnAreas) const;
 
 	/** Uses a priority list to return a SpawnArea to spawn. Priority is origin (setting permitting), reinforcement
 	 *  learning component (setting permitting), and lastly chooses a random index of ValidSpawnAreas.
 	 *  
-	 *  @param PreviousSpawnArea the previously selected Spawn Area to spawn
-	 *  @param ValidSpawnAreas a set of valid Spawn Areas to choose from
-	 *  @param SelectedSpawnAreas a set of Spawn Areas already chosen to spawn
-	 *  @return the Spawn Area to spawn, or nullptr if none found
+	 *  @param PreviousIndex the index of the previously selected Spawn Area to spawn
+	 *  @param ValidSpawnAreas a bit set of valid Spawn Area indices to choose from
+	 *  @param SelectedSpawnAreas a bit set of Spawn Area indices already chosen to spawn
+	 *  @return the index of the Spawn Area to spawn, or -1 if none found
 	 */
-	USpawnArea* ChooseSpawnableSpawnArea(const USpawnArea* PreviousSpawnArea, const TSet<USpawnArea*>& ValidSpawnAreas,
-		const TSet<USpawnArea*>& SelectedSpawnAreas) const;
+	int32 ChooseSpawnableSpawnArea(const int32 PreviousIndex, const FSpawnAreaBitSet& ValidSpawnAreas,
+		const FSpawnAreaBitSet& SelectedSpawnAreas) const;
 
 	/** Performs a depth-first search of ValidSpawnAreas, returning a set of SpawnAreas that are all bordering at
-	 *  least one another.
+	 *  least one another. Starts next to exactly one recent grid block if possible.
 	 *  
-	 *  @param ValidSpawnAreas a set of valid Spawn Areas to choose from and modify
+	 *  @param ValidSpawnAreas a bit set of valid Spawn Area indices to choose from and modify
 	 *  @param NumToSpawn the maximum number of Spawn Areas to choose
 	 */
-	void FindAdjacentGridUsingDFS(TSet<USpawnArea*>& ValidSpawnAreas, const int32 NumToSpawn) const;
+	void FindAdjacentGridUsingDFS(FSpawnAreaBitSet& ValidSpawnAreas, const int32 NumToSpawn) const;
 
 	/** Finds the largest valid rectangle and populates ValidSpawnAreas based on it. \n\n
 	 *  
-	 * 	@param ValidSpawnAreas a set of valid Spawn Areas to choose from and modify
-	 *  @param IndexValidity an array of valid Spawn Area indices to choose from
+	 * 	@param ValidSpawnAreas a bit set of valid Spawn Area indices to choose from and modify
 	 *  @param BlockSize the size of block to try and create
 	 *  @param bBordering whether or not to try place the block adjacent to a recent SpawnArea
 	 */
-	void FindGridBlockUsingLargestRectangle(TSet<USpawnArea*>& ValidSpawnAreas, const TArray<int32>& IndexValidity,
-		const int32 BlockSize, const bool bBordering) const;
+	void FindGridBlockUsingLargestRectangle(FSpawnAreaBitSet& ValidSpawnAreas, const int32 BlockSize,
+		const bool bBordering) const;
 
 	/** Removes all SpawnAreas that are occupied by activated, recent targets, and possibly managed targets.
-	 *  Recalculates occupied vertices for each spawn area if necessary. Only called when finding Spawnable
+	 *  Uses the coverage counts maintained by the SpawnAreas grid, so no occupied vertices need to be recalculated
+	 *  unless NewScale is larger than an invalid Spawn Area's target scale. Only called when finding Spawnable
 	 *  Non-Grid SpawnAreas since grid-based will never have to worry about overlapping.
 	 *  
-	 * 	@param ValidSpawnAreas a set of valid Spawn Areas to modify
-	 *  @param InvalidSpawnAreas a set of Spawn Areas that are invalid or have already been chosen
+	 * 	@param ValidSpawnAreas a bit set of valid Spawn Area indices to modify
+	 *  @param InvalidSpawnAreas a bit set of Spawn Area indices that are invalid or have already been chosen
 	 *  @param NewScale the scale of the target to be spawned
 	 */
-	void RemoveOverlappingSpawnAreas(TSet<USpawnArea*>& ValidSpawnAreas, const TSet<USpawnArea*>& InvalidSpawnAreas,
+	void RemoveOverlappingSpawnAreas(FSpawnAreaBitSet& ValidSpawnAreas, const FSpawnAreaBitSet& InvalidSpawnAreas,
 		const FVector& NewScale) const;
 
-	/** Filters out any SpawnAreas that aren't bordering Current.
+	/** Filters out any SpawnAreas that aren't bordering CurrentIndex.
 	 *
-	 * 	@param ValidSpawnAreas a set of valid Spawn Areas to modify
-	 *  @param Current the Spawn Area to filter non-adjacent Spawn Areas from
+	 * 	@param ValidSpawnAreas a bit set of valid Spawn Area indices to modify
+	 *  @param CurrentIndex the index of the Spawn Area to filter non-adjacent Spawn Areas from
 	 *  @return the number of non-adjacent indices removed
 	 */
-	int32 RemoveNonAdjacentIndices(TSet<USpawnArea*>& ValidSpawnAreas, const USpawnArea* Current) const;
+	int32 RemoveNonAdjacentIndices(FSpawnAreaBitSet& ValidSpawnAreas, const int32 CurrentIndex) const;
 
 	/** Update the value of MostRecentGridBlocks.
 	 *
-	 * 	@param ValidSpawnAreas a set of valid Spawn Areas to possible insert into MostRecentGridBlocks
+	 * 	@param ValidSpawnAreas a bit set of valid Spawn Area indices to possible insert into MostRecentGridBlocks
 	 *  @param NumToSpawn the number of Spawn Areas that that were attempted to be spawned
 	 */
-	void UpdateMostRecentGridBlocks(const TSet<USpawnArea*>& ValidSpawnAreas, const int32 NumToSpawn) const;
+	void UpdateMostRecentGridBlocks(const FSpawnAreaBitSet& ValidSpawnAreas, const int32 NumToSpawn) const;
 
 	/* ------------- */
 	/* -- Utility -- */
 	/* ------------- */
 
-	/** Returns a set of OutType (Only USpawnArea* and int32 specialized) adjacent to the InSpawnAreas
-	 *  according to Directions. 
+	/** Returns a bit set of Spawn Area indices adjacent to the InSpawnAreas according to Directions. Does not include
+	 *  any indices contained in InSpawnAreas.
 	 *
-	 * 	@param InSpawnAreas a set of Spawn Areas to find adjacent Spawn Areas from
+	 * 	@param InSpawnAreas a bit set of Spawn Area indices to find adjacent Spawn Areas from
 	 *  @param Directions the directions allowed to choose from
-	 *  @return a set of type OutType adjacent to InSpawnAreas
+	 *  @return a bit set of Spawn Area indices adjacent to InSpawnAreas
 	 */
-	template<typename OutType>
-	TSet<OutType> GetAdjacentSpawnAreas(const TSet<USpawnArea*>& InSpawnAreas,
+	FSpawnAreaBitSet GetAdjacentSpawnAreas(const FSpawnAreaBitSet& InSpawnAreas,
 		const TSet<EAdjacentDirection>& Directions) const;
 	
-	/** Creates an array with size equal to the number of Spawn Areas, where each index represents whether or not the
-	 *  SpawnArea should be consider valid.
-	 *
-	 * 	@param ValidSpawnAreas a set of valid Spawn Areas to get indices from
-	 *  @param NumSpawnAreas the total number of Spawn Areas
-	 *  @return an array where each index represents whether or not the SpawnArea should be consider valid
-	 */
-	static TArray<int32> CreateIndexValidityArray(const TSet<USpawnArea*>& ValidSpawnAreas, const int32 NumSpawnAreas);
-
-	/** Finds the maximum rectangle of valid indices in the matrix. Returns a struct containing the area, start index,
-	 *  and end index that correspond to SpawnAreas.
-	 *
-	 *  @param IndexValidity an array of Spawn Area indices to filter the rectangles from
-	 *  @param Factors an array of factors to filter the rectangles from
-	 *  @param NumRows total number of Spawn Area rows
-	 *  @param NumCols total number of Spawn Area columns
-	 */
-	static FRectangleSet FindLargestValidRectangles(const TArray<int32>& IndexValidity, const TArray<FFactor>& Factors,
-		const int32 NumRows, const int32 NumCols);
-
-	/** Called for every row inside FindLargestValidRectangle. Iterates through the number of columns both forward and
-	 *  backward, updating Rectangle values if a new largest rectangle matching the factors criteria is found.
-	 *
-	 *  @param Rectangles a set of rectangle candidates to update
-	 *  @param Factors an array of factors to filter the rectangles from
-	 *  @param Heights an array of heights
-	 *  @param CurrentRow the current row in the iteration
-	 */
-	static void UpdateLargestRectangles(FRectangleSet& Rectangles, const TArray<FFactor>& Factors,
-		TArray<int32>& Heights, const int32 CurrentRow);
-
-	/** Called if the current height is greater than zero inside the other UpdateLargestRectangles function.
-	 *
-	 *  @param Rectangles a set of rectangle candidates to update
-	 *  @param Factors an array of factors to filter the rectangles from
-	 *  @param SubRectangle the rectangle info at the top of the stack
-	 */
-	static void UpdateSubRectangles(FRectangleSet& Rectangles, const TArray<FFactor>& Factors,
-		const FSubRectangle& SubRectangle);
-	
-	/** Converts the rectangle set into a sorted array. If bordering, it returns the first rectangle where StartIndex
-	 *  candidates is not empty. Otherwise, it returns the first value in the sorted array.
-	 *
-	 * 	@param Rectangles a set of valid Spawn Areas to modify
-	 *  @param bBordering whether or not to find the first rectangle where StartIndex candidates is not empty
-	 *  @param BlockSize Number of targets to spawn
-	 *  @return the chosen rectangle candidate
-	 */
-	static FRectCandidate ChooseRectangleCandidate(const FRectangleSet& Rectangles, const bool bBordering,
-		const int32 BlockSize);
-
 	/** Chooses the orientation of the rectangle based on the factors.
 	 * 
 	 *  @param Rect the rectangle to choose the orientation for
 	 *  @param Factor the factor to pull the rectangle dimensions from
+	 *  @param Stream the random stream used to choose between orientations
 	 *  @return a pair of start, end indices
 	 */
-	static FIndexPair ChooseRectangleOrientation(const FRectCandidate& Rect, const FFactor& Factor);
+	static FIndexPair ChooseRectangleOrientation(const FRectCandidate& Rect, const FFactor& Factor,
+		const FRandomStream& Stream);
 
 	/** Chooses the position of the rectangle inside the larger rectangle that was chosen.
 	 * 
 	 *  @param ChosenRectangle the rectangle to choose the position for
 	 *  @param Orientation the IndexPair return from ChooseRectangleOrientation
-	 *  @param bBordering whether or not to prefer bordering indices
+	 *  @param StartIndexCandidates (row, col) start positions bordering recent Spawn Areas, empty if not bordering
+	 *  @param Stream the random stream used to choose the position
 	 *  @return A pair of bool values where the first indicates if i corresponds to rows and the second indicates
 	 *  if incrementing or decrementing
 	 */
 	static std::pair<bool, bool> ChooseRectanglePosition(FRectCandidate& ChosenRectangle, const FIndexPair& Orientation,
-		const bool bBordering);
-
-	/** Returns a set of factors with the minimum distance between Factor1 and Factor2. */
-	static TSet<FFactor> GetPreferredRectangleDimensions(const int32 BlockSize, const int32 NumRows,
-		const int32 NumCols);
-
-	/** Updates the rectangle candidates' AdjacentIndices and StartIndexCandidates.
-	 *
-	 *  @param Rectangles the rectangles to update
-	 *  @param Adjacent a set of adjacent indices to to update the rectangles with
-	 */
-	static void UpdateRectangleCandidateAdjacentIndices(FRectangleSet& Rectangles, const TSet<int32>& Adjacent);
-
-	/** Find all unique factors for a number.
-	 *
-	 *  @param Number the number to find factors for
-	 *  @return a set of all unique factors for a number
-	 */
-	static TSet<FFactor> FindAllFactors(const int32 Number);
-
-	/** Finds the two factors for a number with the smallest difference between factors. If the number has no factors
-	 *  greater than 1, an invalid FFactor is returned.
-	 *  
-	 *  @param Number the number to find factors for
-	 *  @return the Factor with the smallest difference between factors
-	 */
-	static FFactor FindLargestFactors(const int32 Number);
-
-	/** Tries to find pairs of factors for a number that fit within the two constraints. Initially tries
-	 *  FindLargestFactors and falls back to FindAllFactors if it returned invalid. It then iterates through all
-	 *  factors that meet the constraints, and chooses the ones with the smallest difference between factors.
-	 *
-	 *  @param Number the number to find factors for
-	 *  @param Constraint1 the first constraint
-	 *  @param Constraint2 the second constraint
-	 *  @return a set of factors that best fit the given constraints
-	 */
-	static TSet<FFactor> FindBestFittingFactors(const int32 Number, const int32 Constraint1, const int32 Constraint2);
-
-	/** Returns whether or not a number is prime.
-	 *
-	 * 	@param Number the number in question
-	 *  @return whether or not the number is prime
-	 */
-	static constexpr bool IsPrime(const int32 Number);
+		TConstArrayView<FIndexPair> StartIndexCandidates, const FRandomStream& Stream);
 
 	/** Calculates the Manhattan distance between to indices given the number of columns.
 	 *
@@ -823,9 +394,6 @@ protected:
 	 *  @return the manhattan distance between the two indices
 	 */
 	static int32 CalcManhattanDist(const int32 Index1, const int32 Index2, const int32 NumCols);
-
-	/** General SpawnAreas filter function that takes in a filter function to apply. */
-	static TArray<int32> FilterIndices(TArray<USpawnArea*>& ValidSpawnAreas, bool (USpawnArea::*FilterFunc)() const);
 	
 	/** Preferred dimensions for a Spawn Area */
 	UPROPERTY(EditAnywhere, Category="SpawnArea")
@@ -894,13 +462,21 @@ public:
 	/** Draws debug boxes and/or lines based on debug bool variables. */
 	void DrawDebug() const;
 
+	/** Creates a read-only view of a Spawn Area for debugging and testing. The view is only valid until the
+	 *  SpawnAreas grid is cleared or reinitialized.
+	 *
+	 *  @param Index the index of the Spawn Area to view
+	 *  @return a transient view of the Spawn Area, or nullptr if the index is invalid
+	 */
+	USpawnArea* CreateSpawnAreaView(const int32 Index) const;
+
 protected:
 	/** Draws debug boxes using SpawnAreas. */
-	void DrawDebug_Boxes(const TSet<USpawnArea*>& InSpawnAreas, const FColor& Color, const int32 Thickness,
+	void DrawDebug_Boxes(const FSpawnAreaBitSet& InSpawnAreas, const FColor& Color, const int32 Thickness,
 		bool bPersistent) const;
 
 	/** Draws debug points for the spawn areas' occupied vertices and non-occupied vertices as well as a debug sphere. */
-	void DrawDebug_Vertices(const TSet<USpawnArea*>& InSpawnAreas, const bool bGenerateNew,
+	void DrawDebug_Vertices(const FSpawnAreaBitSet& InSpawnAreas, const bool bGenerateNew,
 		const bool bDrawSphere) const;
 
 	/** Prints the number of activated, recent, and managed targets. */
@@ -910,14 +486,14 @@ protected:
 	static void PrintDebug_SpawnArea(const USpawnArea* SpawnArea);
 
 	/** Prints debug info about SpawnArea distance. */
-	void PrintDebug_SpawnAreaDist(const USpawnArea* SpawnArea) const;
+	void PrintDebug_SpawnAreaDist(const int32 Index) const;
 
 	/** Prints debug info about rectangles found. */
-	static void PrintDebug_GridLargestRect(const FRectangleSet& Rectangles, const FRectCandidate& Chosen,
+	static void PrintDebug_GridLargestRect(const FLargestRectangleFinder& Finder, const FRectCandidate& Chosen,
 		const int32 NumCols, const FIndexPair& Orientation);
 
 	/** Prints a formatted matrix (upside down from how indexes appear in SpawnAreas so that it matches in game). */
-	static void PrintDebug_Matrix(const TArray<int32>& Matrix, const int32 NumRows, const int32 NumCols);
+	static void PrintDebug_Matrix(const FSpawnAreaBitSet& ValidSpawnAreas, const int32 NumRows, const int32 NumCols);
 	
 public:
 	/** Toggles showing debug boxes for all SpawnAreas. */
@@ -956,9 +532,8 @@ public:
 	/** Toggles printing various grid-distribution related info. */
 	bool bPrintDebug_Grid;
 
-	// ReSharper disable twice CppUE4ProbableMemoryIssuesWithUObjectsInContainer
-	mutable TSet<USpawnArea*> DebugCached_SpawnableValidSpawnAreas;
-	mutable TSet<USpawnArea*> DebugCached_NonAdjacentSpawnAreas;
+	mutable FSpawnAreaBitSet DebugCached_SpawnableValidSpawnAreas;
+	mutable FSpawnAreaBitSet DebugCached_NonAdjacentSpawnAreas;
 
 #endif
 
@@ -985,50 +560,44 @@ private:
 	/** The largest min and max extrema for the SpawnBox */
 	FExtrema StaticExtrema;
 
-	/** All SpawnArea objects inside the larger total spawn area. Set is filled bottom-up, left-to-right. Does not
-	 *  change throughout game mode */
-	UPROPERTY()
-	TSet<USpawnArea*> SpawnAreas;
-
-	/** Maps each location in the SpawnBox to a unique SpawnArea. Does not change throughout game mode */
-	UPROPERTY()
-	TMap<FAreaKey, USpawnArea*> AreaKeyMap;
+	/** State for every SpawnArea inside the larger total spawn area, stored as parallel arrays indexed bottom-up,
+	 *  left-to-right. Dimensions do not change throughout game mode. Mutable since chosen points and target scales
+	 *  are assigned while finding spawnable Spawn Areas */
+	mutable FSpawnAreaGrid SpawnAreas;
 
-	/** Maps each Target Guid to a unique SpawnArea. Added when the SpawnArea is flagged as managed, and removed
+	/** Maps each Target Guid to a unique SpawnArea index. Added when the SpawnArea is flagged as managed, and removed
 	 *  when the managed flag is removed */
-	UPROPERTY()
-	TMap<FGuid, USpawnArea*> GuidMap;
+	TMap<FGuid, int32> GuidMap;
 
-	/** A set of SpawnAreas that fall within the current BoxBounds. All are added initially, updated when the SpawnBox
-	 *  extents changes through the OnExtremaChanged function */
-	UPROPERTY()
-	TSet<USpawnArea*> CachedExtrema;
+	/** One bit per SpawnArea index that falls within the current BoxBounds. All are set initially, updated when the
+	 *  SpawnBox extents changes through the OnExtremaChanged function */
+	FSpawnAreaBitSet CachedExtrema;
 
-	/** A set of the currently managed SpawnAreas. Added when the SpawnArea is flagged as managed, and removed
-	 *  when the managed flag is removed */
-	UPROPERTY()
-	TSet<USpawnArea*> CachedManaged;
+	/** The inclusive columns (X) and rows (Y) that CachedExtrema currently contains, used to only update the strips
+	 *  of Spawn Areas entering or leaving the BoxBounds. Only valid for FullRange and HeadshotHeightOnly */
+	FIntRect CachedExtremaWindow;
 
-	/** A set of the currently activated SpawnAreas. Added when the SpawnArea is flagged as activated, and removed
-	 *  when the activated flag is removed */
-	UPROPERTY()
-	TSet<USpawnArea*> CachedActivated;
+	/** An array of the most recently spawned grid blocks */
+	mutable TArray<FSpawnAreaBitSet> RecentGridBlocks;
 
-	/** A set of the currently recent SpawnAreas. Added when flagged as recent, and removed when
-	 *  the recent flag is removed */
-	UPROPERTY()
-	TSet<USpawnArea*> CachedRecent;
+	/** Finds rectangles of valid Spawn Areas for grid blocks, reusing its buffers between calls */
+	mutable FLargestRectangleFinder RectangleFinder;
 
-	/** An array of the most recently spawned grid block sets */
-	mutable TArray<TSet<USpawnArea*>> RecentGridBlocks;
+	/** Finds groups of bordering Spawn Areas for the Bordering selection mode, reusing its buffers between calls */
+	mutable FSpawnAreaFloodFill FloodFill;
 
-	/** The most recently activated SpawnArea */
-	UPROPERTY()
-	USpawnArea* MostRecentSpawnArea;
+	/** Random stream used for every random Spawn Area selection. Seeded in InitializeSpawnAreas unless
+	 *  SetRandomSeed was called */
+	FRandomStream RandomStream;
 
-	/** The SpawnArea that contains the origin */
-	UPROPERTY()
-	USpawnArea* OriginSpawnArea;
+	/** Whether or not RandomStream was seeded by SetRandomSeed */
+	bool bHasFixedRandomSeed;
+
+	/** The index of the most recently activated SpawnArea */
+	int32 MostRecentSpawnAreaIndex;
+
+	/** The index of the SpawnArea that contains the origin */
+	int32 OriginSpawnAreaIndex;
 
 	/** Delegate used to bind a timer handle to RemoveRecentFlagFromSpawnArea() */
 	FTimerDelegate RemoveFromRecentDelegate;
@@ -1039,23 +608,3 @@ private:
 	/** Delegate used to request active target locations */
 	FRequestMovingTargetLocations RequestMovingTargetLocations;
 };
-
-/** Returns a set of Spawn Area indices adjacent to the InSpawnAreas according to Directions.
- *
- * 	@param InSpawnAreas a set of Spawn Areas to find adjacent Spawn Areas from
- *  @param Directions the directions allowed to choose from
- *  @return a set of adjacent Spawn Area indices
- */
-template <>
-TSet<int32> USpawnAreaManagerComponent::GetAdjacentSpawnAreas<int32>(const TSet<USpawnArea*>& InSpawnAreas,
-	const TSet<EAdjacentDirection>& Directions) const;
-
-/** Returns a set of Spawn Areas adjacent to the InSpawnAreas according to Directions.
- *
- * 	@param InSpawnAreas a set of Spawn Areas to find adjacent Spawn Areas from
- *  @param Directions the directions allowed to choose from
- *  @return a set of adjacent SpawnAreas
- */
-template <>
-TSet<USpawnArea*> USpawnAreaManagerComponent::GetAdjacentSpawnAreas<USpawnArea*>(const TSet<USpawnArea*>& InSpawnAreas,
-	const TSet<EAdjacentDirection>& Directions) const;
\ No newline at end of file
@@ -4,11 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
-#include "Components/TimelineComponent.h"
 #include "AbilitySystemInterface.h"
 #include "AbilitySystem/BSAbilitySystemComponent.h"
 #include "AbilitySystem/Globals/BSAttributeSetBase.h"
 #include "BSGameModeDataAsset.h"
+#include "TargetAnimationManager.h"
 #include "Target.generated.h"
 
 struct FPlayerSettings_Game;
@@ -16,7 +16,6 @@ class UProjectileMovementComponent;
 class UBSHealthComponent;
 class UBSAbilitySystemComponent;
 class UCapsuleComponent;
-class UTimelineComponent;
 class UNiagaraSystem;
 class UCurveFloat;
 class ATarget;
@@ -131,6 +130,7 @@ class BEATSHOT_API ATarget : public AActor, public IAbilitySystemInterface, publ
 	GENERATED_BODY()
 
 	friend class ATargetManager;
+	friend class FTargetAnimationManager;
 	friend class ABeatShotGameModeFunctionalTest;
 	friend class FTargetCollisionTest;
 
@@ -200,8 +200,6 @@ protected:
 	virtual void PostInitializeComponents() override;
 
 public:
-	virtual void Tick(float DeltaSeconds) override;
-
 	/** Called in TargetManager to initialize the target */
 	virtual void Init(const FBS_TargetConfig& InTargetConfig);
 
@@ -243,7 +241,7 @@ protected:
 	void ResetHealth();
 
 public:
-	/** Starts the ExpirationTimer timer and starts playing StartToPeakTimeline if Lifespan > 0 */
+	/** Starts the ExpirationTimer timer and starts playing the StartToPeak animation if Lifespan > 0 */
 	virtual bool ActivateTarget(const float Lifespan);
 
 	/** Calls StopAllTimelines, sets TargetScale_Deactivation */
@@ -253,36 +251,41 @@ public:
 	 *  if the target is out of health */
 	void CheckForHealthReset(const bool bOutOfHealth);
 
+	/** Called by TargetManager instead of destroying the target. Stops the ExpirationTimer and all timelines,
+	 *  stops movement, and hides the target with collision and ticking disabled */
+	virtual void ReturnToPool();
+
+	/** Called by TargetManager when taking the target out of the pool. Calls Init with the existing config, moves
+	 *  the target to InTransform, and resets health, immunity, and any state saved since it was spawned */
+	virtual void ReuseFromPool(const FTransform& InTransform);
+
+	/** Returns whether or not the target is currently in the TargetManager's pool */
+	bool IsPooled() const { return bIsPooled; }
+
+	/** Sets the animation manager that plays this target's color and scale animations */
+	void SetAnimationManager(const TSharedPtr<FTargetAnimationManager>& InAnimationManager)
+	{
+		AnimationManager = InAnimationManager;
+	}
+
 protected:
-	/** Play the StartToPeakTimeline, which corresponds to the StartToPeakCurve */
-	UFUNCTION()
+	/** Plays the StartToPeak animation, which corresponds to the StartToPeakCurve. Interpolates between
+	 *  StartTargetColor and PeakTargetColor, from activation up to SpawnBeatDelay seconds */
 	void PlayStartToPeakTimeline();
 
-	/** Play the PeakToEndTimeline, which corresponds to the PeakToEndCurve */
-	UFUNCTION()
+	/** Plays the PeakToEnd animation, which corresponds to the PeakToEndCurve. Interpolates between
+	 *  PeakTargetColor and EndTargetColor, from SpawnBeatDelay seconds up to TargetMaxLifeSpan seconds */
 	void PlayPeakToEndTimeline();
 
-	/** Quickly shrinks the target, then slowly takes it back to original size */
-	UFUNCTION()
+	/** Quickly shrinks the target, then slowly takes it back to original size. Interpolates both sphere scale
+	 *  and sphere color */
 	void PlayShrinkQuickAndGrowSlowTimeline();
 
-	/** Stops playing all timelines if any are playing */
+	/** Stops playing any animation */
 	void StopAllTimelines();
 
-	/** Interpolates between StartTargetColor and PeakTargetColor. This occurs between initial spawning of target,
-	 *  up to SpawnBeatDelay seconds */
-	UFUNCTION()
-	void InterpStartToPeak(const float Alpha);
-
-	/** Interpolates between PeakTargetColor and EndTargetColor. This occurs between SpawnBeatDelay seconds,
-	 *  up to TargetMaxLifeSpan seconds */
-	UFUNCTION()
-	void InterpPeakToEnd(const float Alpha);
-
-	/** Used to shrink the target quickly, and more slowly return it to it's BeatGrid size and color.
-	 *  Interpolates both sphere scale and sphere color */
-	UFUNCTION()
-	void InterpShrinkQuickAndGrowSlow(const float Alpha);
+	/** Called by the animation manager when an animation reaches the end of its curve */
+	void OnAnimationFinished(const ETargetAnimation Animation);
 
 public:
 	/** Sets the color of the Base Target */
@@ -412,15 +415,8 @@ protected:
 	UPROPERTY()
 	FTimerHandle ExpirationTimer;
 
-	FTimeline StartToPeakTimeline;
-	FTimeline PeakToEndTimeline;
-	FTimeline ShrinkQuickAndGrowSlowTimeline;
-
-	FOnTimelineFloat OnStartToPeak;
-	FOnTimelineFloat OnPeakToFade;
-	FOnTimelineFloat OnShrinkQuickAndGrowSlow;
-
-	FOnTimelineEvent OnStartToPeakFinished;
+	/** Plays color and scale animations for all targets owned by the TargetManager */
+	TWeakPtr<FTargetAnimationManager> AnimationManager;
 
 	/** The world scale of the target when spawned */
 	FVector TargetScale_Spawn;
@@ -446,10 +442,10 @@ protected:
 	/** The amount of health required to deactivate if a Deactivation Condition is Specific Health Amount */
 	float CurrentDeactivationHealthThreshold;
 
-	/** Playback rate for StartToPeak timeline */
+	/** Playback rate for StartToPeak and ShrinkQuickAndGrowSlow animations */
 	float StartToPeakTimelinePlayRate;
 
-	/** Playback rate for PeakToEnd timeline */
+	/** Playback rate for PeakToEnd animation */
 	float PeakToEndTimelinePlayRate;
 
 	/** Whether or not the last direction change was horizontally */
@@ -464,6 +460,9 @@ protected:
 	/** Whether or not the target is currently activated */
 	bool bIsCurrentlyActivated;
 
+	/** Whether or not the target is currently in the TargetManager's pool */
+	bool bIsPooled;
+
 	FActiveGameplayEffectHandle ActiveGE_TargetImmunity;
 	FActiveGameplayEffectHandle ActiveGE_HitImmunity;
 	FActiveGameplayEffectHandle ActiveGE_TrackingImmunity;
@@ -0,0 +1,149 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ATarget;
+class UCurveFloat;
+
+/** The color and scale animations a target can play */
+enum class ETargetAnimation : uint8
+{
+	/** Interpolates from StartColor to PeakColor over SpawnBeatDelay seconds */
+	StartToPeak,
+	/** Interpolates from PeakColor to EndColor over the remaining lifespan */
+	PeakToEnd,
+	/** Quickly shrinks the target, then slowly takes it back to its activation scale and the inactive color */
+	ShrinkQuickAndGrowSlow,
+	/** Number of animations, not a valid animation */
+	Count
+};
+
+/** Everything needed to animate a target, captured when the animation starts */
+struct FTargetAnimationParams
+{
+	/** The animation to play */
+	ETargetAnimation Animation;
+
+	/** Multiplied by delta time to advance the playback position */
+	float PlayRate;
+
+	/** Color at an alpha of zero */
+	FLinearColor ColorFrom;
+
+	/** Color at an alpha of one */
+	FLinearColor ColorTo;
+
+	/** Scale at an alpha of zero */
+	float ScaleFrom;
+
+	/** Scale at an alpha of one */
+	float ScaleTo;
+
+	/** Added to the scale alpha after it is multiplied by ScaleAlphaMultiplier */
+	float ScaleAlphaOffset;
+
+	/** Multiplied by the curve value or playback position to get the scale alpha */
+	float ScaleAlphaMultiplier;
+
+	/** Whether the color alpha is the curve value (true) or the playback position (false) */
+	bool bColorFollowsCurve;
+
+	/** Whether the scale alpha is the curve value (true) or the playback position (false) */
+	bool bScaleFollowsCurve;
+
+	/** Whether or not to set the scale of the target at all */
+	bool bAnimateScale;
+
+	FTargetAnimationParams() : Animation(ETargetAnimation::StartToPeak), PlayRate(1.f), ColorFrom(FLinearColor()),
+		ColorTo(FLinearColor()), ScaleFrom(1.f), ScaleTo(1.f), ScaleAlphaOffset(0.f), ScaleAlphaMultiplier(1.f),
+		bColorFollowsCurve(true), bScaleFollowsCurve(false), bAnimateScale(false)
+	{
+	}
+};
+
+/** A float curve sampled at evenly spaced times so that it can be evaluated with a single lerp */
+struct FBakedTargetCurve
+{
+	/** The evenly spaced samples, from time zero to EndTime */
+	TArray<float> Samples;
+
+	/** The time of the last key in the curve, which is also the length of the animation */
+	float EndTime = 0.f;
+
+	/** Number of samples taken from each curve */
+	static constexpr int32 NumSamples = 128;
+
+	/** Samples the curve from zero to its last key. A null curve bakes to no samples */
+	void Bake(const UCurveFloat* Curve);
+
+	/** Returns whether or not a curve was baked */
+	bool IsValid() const { return !Samples.IsEmpty(); }
+
+	/** Returns the linearly interpolated sample at Time */
+	float Evaluate(const float Time) const;
+};
+
+/** Plays the color and scale animations for every target owned by a TargetManager. The animations used to be
+ *  per-target FTimelines ticked by each target. Animation state is stored as parallel arrays so that advancing,
+ *  evaluating, and interpolating are each a single loop over all animating targets, followed by one loop that
+ *  writes the results to the targets. */
+class BEATSHOT_API FTargetAnimationManager
+{
+public:
+	/** Starts or restarts an animation for InTarget from the beginning, replacing any animation it was playing.
+	 *  Curves are baked from the first target to play an animation. Does nothing if the target has no curve
+	 *  for the animation */
+	void Play(ATarget* InTarget, const FTargetAnimationParams& Params);
+
+	/** Stops any animation InTarget is playing without applying a final value */
+	void Stop(const ATarget* InTarget);
+
+	/** Returns whether or not InTarget is playing InAnimation */
+	bool IsPlaying(const ATarget* InTarget, const ETargetAnimation InAnimation) const;
+
+	/** Advances all animations, writes color and scale to the targets, and notifies targets whose animation
+	 *  finished */
+	void Tick(const float DeltaTime);
+
+	/** Stops all animations */
+	void Clear();
+
+	/** Returns the number of targets currently animating */
+	int32 Num() const { return Targets.Num(); }
+
+private:
+	/** Bakes the animation curves assigned to InTarget */
+	void BakeCurves(const ATarget* InTarget);
+
+	/** Removes the animation at Index by swapping the last animation into its place */
+	void RemoveAtSwap(const int32 Index);
+
+	/** Baked curves, indexed by ETargetAnimation */
+	FBakedTargetCurve Curves[static_cast<int32>(ETargetAnimation::Count)];
+
+	/** Whether or not Curves has been baked */
+	bool bCurvesBaked = false;
+
+	/** Maps a target to its index in the arrays below */
+	TMap<const ATarget*, int32> TargetIndices;
+
+	TArray<ATarget*> Targets;
+	TArray<ETargetAnimation> Animations;
+	TArray<float> Positions;
+	TArray<float> EndTimes;
+	TArray<float> PlayRates;
+	TArray<float> Alphas;
+	TArray<FLinearColor> ColorsFrom;
+	TArray<FLinearColor> ColorsTo;
+	TArray<FLinearColor> Colors;
+	TArray<float> ScalesFrom;
+	TArray<float> ScalesTo;
+	TArray<float> ScaleAlphaOffsets;
+	TArray<float> ScaleAlphaMultipliers;
+	TArray<float> Scales;
+	TArray<bool> ColorFollowsCurve;
+	TArray<bool> ScaleFollowsCurve;
+	TArray<bool> AnimateScale;
+};
@@ -8,6 +8,7 @@
 enum class ETargetDamageType : uint8;
 class ATarget;
 struct FTargetDamageEvent;
+struct FSpawnAreaBitSet;
 
 /** Contains a map that maps target guid's to their current location. */
 struct FMovingTargetLocations
@@ -15,7 +16,7 @@ struct FMovingTargetLocations
 	TMap<FGuid, FVector> Map;
 };
 
-DECLARE_DELEGATE_RetVal_TwoParams(int32, FRequestRLCSpawnArea, const int32, const TArray<int32>&);
+DECLARE_DELEGATE_RetVal_TwoParams(int32, FRequestRLCSpawnArea, const int32, const FSpawnAreaBitSet&);
 DECLARE_DELEGATE_OneParam(FOnBeatTrackDirectionChanged, const FVector& Vector);
 DECLARE_DELEGATE_OneParam(FRequestMovingTargetLocations, FMovingTargetLocations&);
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnTargetActivated, const ETargetDamageType& DamageType);
@@ -99,47 +100,6 @@ struct FExtrema
 };
 
 
-/** Key used for location-based indexing */
-USTRUCT()
-struct FAreaKey
-{
-	GENERATED_BODY()
-
-	FVector Vertex_BottomLeft;
-	FVector Vertex_TopRight;
-
-	FAreaKey() = default;
-
-	FAreaKey(const FVector& InBotLeft, const FVector& InTopRight) :
-		Vertex_BottomLeft(InBotLeft),
-		Vertex_TopRight(InTopRight)
-	{
-	}
-
-	FAreaKey(const FVector& InBotLeft, const FIntVector3& InInc) : 
-		Vertex_BottomLeft(InBotLeft),
-		Vertex_TopRight(InBotLeft + FVector(0.f, InInc.Y, InInc.Z))
-	{
-	}
-
-	bool operator==(const FAreaKey& Other) const
-	{
-		return FMath::IsNearlyEqual(Vertex_BottomLeft.Y, Other.Vertex_BottomLeft.Y, 0.01f) &&
-			FMath::IsNearlyEqual(Vertex_BottomLeft.Z, Other.Vertex_BottomLeft.Z, 0.01f) &&
-			FMath::IsNearlyEqual(Vertex_TopRight.Y, Other.Vertex_TopRight.Y, 0.01f) && FMath::IsNearlyEqual(
-				Vertex_TopRight.Z, Other.Vertex_TopRight.Z, 0.01f);
-	}
-
-	friend FORCEINLINE uint32 GetTypeHash(const FAreaKey& AreaKey)
-	{
-		uint32 Hash = GetTypeHash(AreaKey.Vertex_BottomLeft.Y);
-		Hash = HashCombine(Hash, GetTypeHash(AreaKey.Vertex_BottomLeft.Z));
-		Hash = HashCombine(Hash, GetTypeHash(AreaKey.Vertex_TopRight.Y));
-		Hash = HashCombine(Hash, GetTypeHash(AreaKey.Vertex_TopRight.Z));
-		return Hash;
-	}
-};
-
 /** Parameters used to spawn ATarget actors. Needs SpawnAreaIndex so that Target Manager can tell the Spawn Area
  *  Manager the correct Spawn Area to associate with the Target's Guid. */
 struct FTargetSpawnParams
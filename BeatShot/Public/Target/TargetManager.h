@@ -11,6 +11,8 @@ struct FCommonScoreInfo;
 struct FBSConfig;
 class UCompositeCurveTable;
 class ATarget;
+class FTargetAnimationManager;
+class FBeatLatencyRecorder;
 class UBoxComponent;
 class UReinforcementLearningComponent;
 class USpawnAreaManagerComponent;
@@ -36,6 +38,7 @@ class BEATSHOT_API ATargetManager : public AActor
 	friend class ABeatShotGameModeFunctionalTest;
 	friend class FTargetManagerTestBase;
 	friend class FTargetManagerTestWithWorld;
+	friend class FRLTrainingSimulation;
 
 public:
 	ATargetManager();
@@ -56,7 +59,6 @@ public:
 	FPostTargetDamageEvent PostTargetDamageEvent;
 
 protected:
-	virtual void BeginPlay() override;
 	virtual void Destroyed() override;
 
 	/** The current 2D spawn area. */
@@ -140,13 +142,32 @@ public:
 	void OnAudioAnalyzerBeat();
 
 protected:
-	/** Generic spawn function that all game modes use to spawn a target. Initializes the target, binds to its
-	 *  delegates, sets the InSpawnArea's Guid, and adds the target to ManagedTargets */
-	virtual ATarget* SpawnTarget(const FTargetSpawnParams& Params);
+	/** Generic spawn function that all game modes use to spawn targets. Takes or creates a target for each of the
+	 *  SpawnParams, then sets damage types, adds them to ManagedTargets, and applies spawn responses in one pass.
+	 *  Returns the targets that were successfully spawned */
+	virtual TArray<ATarget*> SpawnTargets(const TSet<FTargetSpawnParams>& SpawnParams);
 
 	/** Adds a Target to the ManagedTargets array, and updates the associated SpawnArea IsManaged flag */
 	void AddToManagedTargets(ATarget* SpawnTarget, const int32 SpawnAreaIndex);
 
+	/** Spawns a new target actor for each transform and binds to their delegates. Every actor is constructed using
+	 *  deferred spawning before any of them finish spawning. Does not add them to ManagedTargets. The returned
+	 *  array matches the order of Transforms, and contains nullptr for any that failed to spawn */
+	TArray<ATarget*> CreateTargets(const TArray<FTransform>& Transforms);
+
+	/** Returns a target for each transform, taken from TargetPool when possible and created otherwise. The returned
+	 *  array matches the order of Transforms, and contains nullptr for any that failed to spawn */
+	TArray<ATarget*> TakeTargetsFromPool(const TArray<FTransform>& Transforms);
+
+	/** Hides and disables the target and adds it to TargetPool instead of destroying it */
+	void ReturnTargetToPool(ATarget* InTarget);
+
+	/** Spawns enough targets into TargetPool to cover the number of targets the game mode can have at once */
+	void InitTargetPool();
+
+	/** Returns the number of targets to pre-spawn into TargetPool based on the game mode config */
+	int32 GetTargetPoolSize() const;
+
 	/** Returns whether or not the target was activated. Executes any Target Activation Responses
 	 *  and calls ActivateTarget on InTarget */
 	bool ActivateTarget(ATarget* InTarget) const;
@@ -275,7 +296,7 @@ protected:
 	/** Returns the maximum target diameter for a game mode. */
 	static float GetMaxTargetDiameter(const FBS_TargetConfig& InTargetCfg);
 
-	/** Destroys all targets in the ManagedTargets map. */
+	/** Destroys all targets in the ManagedTargets map and in TargetPool. */
 	void DestroyTargets();
 
 	/** Returns a map containing the locations of all moving targets in ManagedTargets. */
@@ -334,6 +355,17 @@ protected:
 	UPROPERTY()
 	TMap<FGuid, ATarget*> ManagedTargets;
 
+	/** Hidden targets that are no longer managed and are waiting to be reused by SpawnTarget. Only valid for the
+	 *  config they were spawned with, so the pool is destroyed whenever the TargetManager is cleared */
+	UPROPERTY()
+	TArray<ATarget*> TargetPool;
+
+	/** Plays the color and scale animations of every target, ticked by this actor instead of each target */
+	TSharedPtr<FTargetAnimationManager> TargetAnimationManager;
+
+	/** Upper limit on the number of targets spawned into TargetPool during Init. The pool can still grow past this */
+	static constexpr int32 MaxInitialTargetPoolSize = 64;
+
 	/** The total amount of ticks while at least one tracking target was damageable */
 	double TotalPossibleDamage;
 
@@ -343,9 +375,6 @@ protected:
 	/** Whether or not the last spawned target direction change was horizontal */
 	mutable bool bLastSpawnedTargetDirectionHorizontal;
 
-	/** Spawn parameters for spawning targets */
-	FActorSpawnParameters TargetSpawnInfo;
-
 	#if !UE_BUILD_SHIPPING
 
 	/** Clears all debug persistent lines and draws debug boxes and/or lines based on debug bool variables. Calls
@@ -359,10 +388,25 @@ protected:
 	 *  set to any. */
 	mutable FAnyMovingTargetDirectionModeDebug LastAnyTargetDirectionModeSectors;
 
+	/** Records the wall time, number of targets spawned and activated, and candidate set sizes of each beat handled
+	 *  by OnAudioAnalyzerBeat. Reset when the TargetManager is cleared */
+	TSharedPtr<FBeatLatencyRecorder> BeatLatencyRecorder;
+
 	/** Toggles showing debug boxes for choosing a random target location when the moving target direction mode is
 	 *  set to any. */
 public:
 	bool bShowDebug_AnyMovingTargetDirectionMode;
+
+	/** Logs the average and maximum timings and counts of the last NumBeats beats, or all beats if NumBeats <= 0 */
+	void LogBeatLatencySummary(const int32 NumBeats = 0) const;
+
+	/** Writes every recorded beat to Saved/Profiling/BeatLatency as a CSV, preceded by comment lines containing the
+	 *  config settings that affect beat handling. Returns whether or not the file was written */
+	bool WriteBeatLatencyCsv() const;
+
+	/** Called by the game mode before clearing the TargetManager at the end of a game mode. Logs a summary and
+	 *  writes the CSV if bs_beatlatency.csvongameend is enabled */
+	void HandleBeatLatencyOnGameModeEnd() const;
 	
 	#endif
 };
@@ -30,9 +30,8 @@ public:
 	float DestroyChance = 1.f;
 
 protected:
-	/** Generic spawn function that all game modes use to spawn a target. Initializes the target, binds to its delegates,
-	 *  sets the InSpawnArea's Guid, and adds the target to ManagedTargets. */
-	virtual ATarget* SpawnTarget(const FTargetSpawnParams& Params) override;
+	/** Spawns targets using the TargetManager, then constructs a target widget for each spawned target. */
+	virtual TArray<ATarget*> SpawnTargets(const TSet<FTargetSpawnParams>& SpawnParams) override;
 	
 	/** Updates the SpawnVolume and all directional boxes to match the current SpawnBox. */
 	virtual void UpdateSpawnVolume(const float Factor) const override;
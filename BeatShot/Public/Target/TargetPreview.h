@@ -24,6 +24,9 @@ public:
 	/** Removes the target widget from parent */
 	virtual void Destroyed() override;
 
+	/** Clears SimulatePlayerDestroyingTimer and removes the target widget from parent */
+	virtual void ReturnToPool() override;
+
 	/** Sets the values of TargetWidget and its position in the viewport */
 	void InitTargetWidget(const TObjectPtr<UTargetWidget> InTargetWidget, const FVector& InStartLocation,
 		const float BoundsHeight);
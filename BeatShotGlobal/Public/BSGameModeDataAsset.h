@@ -392,6 +392,18 @@ enum class EReinforcementLearningHyperParameterMode: uint8
 ENUM_RANGE_BY_FIRST_AND_LAST(EReinforcementLearningHyperParameterMode, EReinforcementLearningHyperParameterMode::Auto,
 	EReinforcementLearningHyperParameterMode::Custom);
 
+/** Enum representing how a reward updates the Q-Table */
+UENUM(BlueprintType)
+enum class EReinforcementLearningUpdateMode : uint8
+{
+	/** Only updates the Q-Table entry for the target pair that received the reward */
+	OneStep UMETA(DisplayName="One Step"),
+	/** Also updates the entries for the chain of target pairs that led to it, scaled by Gamma * Lambda per step */
+	QLambda UMETA(DisplayName="Q(Lambda)")};
+
+ENUM_RANGE_BY_FIRST_AND_LAST(EReinforcementLearningUpdateMode, EReinforcementLearningUpdateMode::OneStep,
+	EReinforcementLearningUpdateMode::QLambda);
+
 
 /** The transition state describing the start state and end state of a transition */
 UENUM(BlueprintType)
@@ -522,6 +534,21 @@ struct FBS_AIConfig
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	EReinforcementLearningHyperParameterMode HyperParameterMode;
 
+	/** The number of rows and columns of the grid that Spawn Areas are grouped into, where each grid cell is one state
+	 *  and one action of the Q-Table. Clamped to the size of the Spawn Area grid and to MaxQTableResolution, and a
+	 *  value of zero uses the Spawn Area grid up to MaxQTableResolution */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(ClampMin=0, ClampMax=15))
+	int32 QTableResolution;
+
+	/** How a reward updates the Q-Table */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	EReinforcementLearningUpdateMode UpdateMode;
+
+	/** Trace decay for Q(Lambda) updates, or how much credit earlier target pairs receive for a reward. Zero is
+	 *  equivalent to a one step update */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(ClampMin=0, ClampMax=1))
+	float Lambda;
+
 	FBS_AIConfig()
 	{
 		bEnableReinforcementLearning = false;
@@ -530,6 +557,9 @@ struct FBS_AIConfig
 		Gamma = Constants::DefaultGamma;
 		ReinforcementLearningMode = EReinforcementLearningMode::None;
 		HyperParameterMode = EReinforcementLearningHyperParameterMode::Auto;
+		QTableResolution = Constants::DefaultQTableResolution;
+		UpdateMode = EReinforcementLearningUpdateMode::OneStep;
+		Lambda = Constants::DefaultLambda;
 	}
 
 	FORCEINLINE bool operator==(const FBS_AIConfig& Other) const
@@ -558,6 +588,18 @@ struct FBS_AIConfig
 		{
 			return false;
 		}
+		if (QTableResolution != Other.QTableResolution)
+		{
+			return false;
+		}
+		if (UpdateMode != Other.UpdateMode)
+		{
+			return false;
+		}
+		if (!FMath::IsNearlyEqual(Lambda, Other.Lambda))
+		{
+			return false;
+		}
 		return true;
 	}
 };
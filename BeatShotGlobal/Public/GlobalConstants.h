@@ -64,6 +64,13 @@ namespace Constants
 
 	inline constexpr float DirBoxPadding = 5.f;
 
+	/** The default number of rows and columns of the grid that Spawn Areas are grouped into for the Q-Table */
+	inline constexpr int32 DefaultQTableResolution = 5;
+
+	/** The largest number of rows and columns of the grid that Spawn Areas are grouped into for the Q-Table, which
+	 *  keeps the Q-Table and its snapshots small on large Spawn Area grids */
+	inline constexpr int32 MaxQTableResolution = 15;
+
 	inline constexpr int32 DefaultNumberOfQTableRows = 25;
 
 	inline constexpr int32 DefaultNumberOfQTableColumns = 25;
@@ -90,6 +97,7 @@ namespace Constants
 	inline constexpr float DefaultAlpha = 0.9f;
 	inline constexpr float DefaultEpsilon = 0.9f;
 	inline constexpr float DefaultGamma = 0.9f;
+	inline constexpr float DefaultLambda = 0.7f;
 
 	inline constexpr int32 DefaultCombatTextFrequency = 5;
 	const FLinearColor DefaultStartTargetColor = FLinearColor::White;
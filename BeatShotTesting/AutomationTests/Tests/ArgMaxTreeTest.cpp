@@ -0,0 +1,145 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Target/ArgMaxTree.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FArgMaxTreeTest, "TargetManager.ArgMaxTree.MatchesBruteForce",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+namespace ArgMaxTreeTest
+{
+	/** Returns every index in descending order of value, ties in ascending order of index */
+	TArray<int32> GetExpectedOrder(const TArray<float>& Values)
+	{
+		TArray<int32> Order;
+		for (int32 Index = 0; Index < Values.Num(); Index++)
+		{
+			Order.Add(Index);
+		}
+		Order.StableSort([&Values](const int32 A, const int32 B) { return Values[A] > Values[B]; });
+		return Order;
+	}
+
+	/** Returns every index whose value equals the largest value, in ascending order */
+	TArray<int32> GetExpectedMaxIndices(const TArray<float>& Values)
+	{
+		TArray<int32> Out;
+		if (Values.IsEmpty()) return Out;
+
+		const float MaxValue = FMath::Max(Values);
+		for (int32 Index = 0; Index < Values.Num(); Index++)
+		{
+			if (Values[Index] == MaxValue) Out.Add(Index);
+		}
+		return Out;
+	}
+}
+
+bool FArgMaxTreeTest::RunTest(const FString& Parameters)
+{
+	using namespace ArgMaxTreeTest;
+
+	// Includes a single value and sizes that are not a power of two, so the tree has padding leaves
+	const TArray<int32> Sizes = {1, 2, 3, 5, 7, 8, 17, 100, 225};
+	constexpr int32 NumUpdates = 300;
+	const FRandomStream Stream(4321);
+
+	// Drawing from a handful of values makes ties common
+	const auto RandomValue = [&Stream]() { return Stream.RandRange(-2, 2) * 0.5f; };
+
+	for (const int32 Size : Sizes)
+	{
+		TArray<float> Values;
+		for (int32 Index = 0; Index < Size; Index++)
+		{
+			Values.Add(RandomValue());
+		}
+
+		FArgMaxTree Tree;
+		Tree.Init(Values);
+		TestEqual(FString::Printf(TEXT("Size %d Num"), Size), Tree.Num(), Size);
+
+		for (int32 Update = 0; Update <= NumUpdates; Update++)
+		{
+			// Check the initial tree first, then after every update
+			if (Update > 0)
+			{
+				const int32 Index = Stream.RandRange(0, Size - 1);
+				Values[Index] = RandomValue();
+				Tree.Update(Index, Values[Index]);
+			}
+
+			const FString Context = FString::Printf(TEXT("Size %d Update %d"), Size, Update);
+			const TArray<int32> ExpectedOrder = GetExpectedOrder(Values);
+			const TArray<int32> ExpectedMaxIndices = GetExpectedMaxIndices(Values);
+
+			if (Tree.GetArgMax() != ExpectedOrder[0])
+			{
+				AddError(FString::Printf(TEXT("%s GetArgMax: expected %d, found %d"), *Context, ExpectedOrder[0],
+					Tree.GetArgMax()));
+				return false;
+			}
+
+			TArray<int32> MaxIndices;
+			Tree.GetMaxIndices(MaxIndices);
+			if (MaxIndices != ExpectedMaxIndices)
+			{
+				AddError(FString::Printf(TEXT("%s GetMaxIndices: expected [%s], found [%s]"), *Context,
+					*FString::JoinBy(ExpectedMaxIndices, TEXT(","), [](const int32 I) { return FString::FromInt(I); }),
+					*FString::JoinBy(MaxIndices, TEXT(","), [](const int32 I) { return FString::FromInt(I); })));
+				return false;
+			}
+
+			// Rejecting every index visits all of them in the order FindBestIndex considers them
+			TArray<int32> Visited;
+			const int32 None = Tree.FindBestIndex([&Visited](const int32 Index)
+			{
+				Visited.Add(Index);
+				return false;
+			});
+			TestEqual(Context + TEXT(" FindBestIndex with no match"), None, static_cast<int32>(INDEX_NONE));
+			if (Visited != ExpectedOrder)
+			{
+				AddError(FString::Printf(TEXT("%s FindBestIndex visited indices out of order"), *Context));
+				return false;
+			}
+
+			// Only accept a random subset, the result must be the best accepted index
+			TArray<bool> Accepted;
+			for (int32 Index = 0; Index < Size; Index++)
+			{
+				Accepted.Add(Stream.FRand() < 0.3f);
+			}
+			int32 ExpectedBest = INDEX_NONE;
+			for (const int32 Index : ExpectedOrder)
+			{
+				if (Accepted[Index])
+				{
+					ExpectedBest = Index;
+					break;
+				}
+			}
+			const int32 Best = Tree.FindBestIndex([&Accepted](const int32 Index) { return Accepted[Index]; });
+			if (Best != ExpectedBest)
+			{
+				AddError(FString::Printf(TEXT("%s FindBestIndex: expected %d, found %d"), *Context, ExpectedBest,
+					Best));
+				return false;
+			}
+		}
+	}
+
+	// An empty tree has no maximum
+	FArgMaxTree Empty;
+	Empty.Init(TArray<float>());
+	TArray<int32> EmptyMaxIndices;
+	Empty.GetMaxIndices(EmptyMaxIndices);
+	TestEqual(TEXT("Empty GetArgMax"), Empty.GetArgMax(), static_cast<int32>(INDEX_NONE));
+	TestTrue(TEXT("Empty GetMaxIndices"), EmptyMaxIndices.IsEmpty());
+	TestEqual(TEXT("Empty FindBestIndex"), Empty.FindBestIndex([](const int32) { return true; }),
+		static_cast<int32>(INDEX_NONE));
+
+	return true;
+}
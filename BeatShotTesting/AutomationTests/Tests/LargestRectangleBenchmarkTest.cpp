@@ -0,0 +1,283 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Target/GridBlockFactors.h"
+#include <stack>
+
+/** The TSet based rectangle search that FLargestRectangleFinder replaced, kept here as a baseline for the benchmark. */
+namespace LegacyLargestRectangle
+{
+	struct FSubRectangle
+	{
+		int32 Index;
+		int32 ColIndex;
+		FIndexPair BoundingIndices;
+		FRectDims Dimensions;
+		int32 Area;
+		FIndexPair Row;
+		FIndexPair Col;
+		TSet<int32> AdjacentIndices;
+		TArray<FIndexPair> StartIndexCandidates;
+
+		FSubRectangle(const int32 InIndex, const int32 InColIndex, const int32 InHeight) : Index(InIndex),
+			ColIndex(InColIndex), Dimensions(0, InHeight), Area(0)
+		{}
+
+		void UpdateDimensions(const int32 InNewWidth, const int32 NumCols)
+		{
+			Dimensions.Width = InNewWidth;
+			BoundingIndices.StartIndex = Index - NumCols * (Dimensions.Height - 1);
+			BoundingIndices.EndIndex = Index + (Dimensions.Width - 1);
+			Area = Dimensions.Width * Dimensions.Height;
+			Row = FIndexPair(BoundingIndices.StartIndex / NumCols, BoundingIndices.EndIndex / NumCols);
+			Col = FIndexPair(BoundingIndices.StartIndex % NumCols, BoundingIndices.EndIndex % NumCols);
+		}
+
+		bool operator<(const FSubRectangle& Other) const { return BoundingIndices < Other.BoundingIndices; }
+	};
+
+	struct FSubRectangleKeyFuncs : BaseKeyFuncs<FSubRectangle, FIndexPair, false>
+	{
+		static bool Matches(const FIndexPair& A, const FIndexPair& B) { return A == B; }
+		static uint32 GetKeyHash(const FIndexPair& Key) { return GetTypeHash(Key); }
+		static const FIndexPair& GetSetKey(const FSubRectangle& Element) { return Element.BoundingIndices; }
+	};
+
+	struct FRectCandidate
+	{
+		FFactor Factor;
+		TSet<FSubRectangle, FSubRectangleKeyFuncs> SubRectangles;
+
+		explicit FRectCandidate(const FFactor& InFactor) : Factor(InFactor)
+		{}
+
+		void MergeSubRectangles()
+		{
+			if (SubRectangles.IsEmpty()) return;
+
+			TArray<FSubRectangle> Sorted = SubRectangles.Array();
+			Sorted.Sort();
+			if (Sorted.Num() > 1)
+			{
+				TArray<FSubRectangle> Filtered;
+				FIndexPair Last = Sorted[0].BoundingIndices;
+				if (Last.EndIndex != Sorted[1].BoundingIndices.EndIndex)
+				{
+					Filtered.Add(Sorted[0]);
+				}
+				for (int32 i = 1; i < Sorted.Num(); i++)
+				{
+					const FIndexPair Current = Sorted[i].BoundingIndices;
+					if (Last.EndIndex != Current.EndIndex || Current.StartIndex != Last.StartIndex + 1)
+					{
+						Filtered.Add(Sorted[i]);
+					}
+					Last = Current;
+				}
+				if (!Filtered.IsEmpty())
+				{
+					Sorted = MoveTemp(Filtered);
+				}
+			}
+			SubRectangles = TSet<FSubRectangle, FSubRectangleKeyFuncs>(MoveTemp(Sorted));
+		}
+	};
+
+	struct FRectCandidateKeyFuncs : BaseKeyFuncs<FRectCandidate, FFactor, false>
+	{
+		static bool Matches(const FFactor& A, const FFactor& B) { return A == B; }
+		static uint32 GetKeyHash(const FFactor& Key) { return GetTypeHash(Key); }
+		static const FFactor& GetSetKey(const FRectCandidate& Element) { return Element.Factor; }
+	};
+
+	typedef TSet<FRectCandidate, FRectCandidateKeyFuncs> FRectangleSet;
+
+	void UpdateSubRectangles(FRectangleSet& Rectangles, const TArray<FFactor>& Factors,
+		const FSubRectangle& SubRectangle)
+	{
+		for (const FFactor& Factor : Factors)
+		{
+			if ((SubRectangle.Dimensions.Width >= Factor.Factor1 && SubRectangle.Dimensions.Height >= Factor.Factor2)
+				|| (SubRectangle.Dimensions.Width >= Factor.Factor2 && SubRectangle.Dimensions.Height >= Factor.
+					Factor1))
+			{
+				if (FRectCandidate* Found = Rectangles.Find(Factor))
+				{
+					Found->SubRectangles.Add(SubRectangle);
+				}
+				else
+				{
+					Rectangles.Emplace(FRectCandidate(Factor));
+				}
+			}
+		}
+	}
+
+	FRectangleSet FindLargestValidRectangles(const FSpawnAreaBitSet& Validity, const TArray<FFactor>& Factors,
+		const int32 NumRows, const int32 NumCols)
+	{
+		FRectangleSet Rectangles;
+
+		// The old path converted the bit set to an array of ints before searching
+		TArray<int32> IndexValidity;
+		IndexValidity.Init(0, NumRows * NumCols);
+		for (const int32 Index : Validity)
+		{
+			IndexValidity[Index] = 1;
+		}
+
+		TArray<int32> Heights;
+		Heights.Init(0, NumCols);
+		for (int32 Row = 0; Row < NumRows; Row++)
+		{
+			for (int32 Col = 0; Col < NumCols; Col++)
+			{
+				Heights[Col] = IndexValidity[Row * NumCols + Col] ? Heights[Col] + 1 : 0;
+			}
+
+			std::stack<FSubRectangle> Stack;
+			for (int32 i = 0; i < NumCols; ++i)
+			{
+				int32 StartColIndex = i;
+				while (!Stack.empty() && Stack.top().Dimensions.Height > Heights[i])
+				{
+					if (Stack.top().Dimensions.Height > 0)
+					{
+						Stack.top().UpdateDimensions(i - Stack.top().ColIndex, NumCols);
+						UpdateSubRectangles(Rectangles, Factors, Stack.top());
+					}
+					StartColIndex = Stack.top().ColIndex;
+					Stack.pop();
+				}
+				Stack.push(FSubRectangle(Row * NumCols + StartColIndex, StartColIndex, Heights[i]));
+			}
+			while (!Stack.empty())
+			{
+				if (Stack.top().Dimensions.Height > 0)
+				{
+					Stack.top().UpdateDimensions(NumCols - Stack.top().ColIndex, NumCols);
+					UpdateSubRectangles(Rectangles, Factors, Stack.top());
+				}
+				Stack.pop();
+			}
+		}
+
+		for (FRectCandidate& Rectangle : Rectangles)
+		{
+			Rectangle.MergeSubRectangles();
+		}
+		return Rectangles;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLargestRectangleBenchmarkTest, "TargetManager.LargestRectangle.Benchmark",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::PerfFilter);
+
+bool FLargestRectangleBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// (NumRows, NumCols), up to the largest grid a game mode can create
+	const TArray<FIntPoint> GridSizes = {FIntPoint(6, 6), FIntPoint(11, 21), FIntPoint(16, 36)};
+	const TArray<float> Densities = {0.5f, 0.8f, 0.95f};
+	const TArray<int32> BlockSizes = {4, 6, 9, 12};
+	constexpr int32 NumGrids = 32;
+	constexpr int32 NumIterations = 20;
+
+	FRandomStream Stream(1337);
+	FLargestRectangleFinder Finder;
+
+	for (const FIntPoint& GridSize : GridSizes)
+	{
+		const int32 NumRows = GridSize.X;
+		const int32 NumCols = GridSize.Y;
+		Finder.Init(NumRows, NumCols);
+
+		for (const float Density : Densities)
+		{
+			TArray<FSpawnAreaBitSet> Grids;
+			for (int32 i = 0; i < NumGrids; i++)
+			{
+				FSpawnAreaBitSet& Grid = Grids.Emplace_GetRef(NumRows * NumCols);
+				for (int32 Index = 0; Index < NumRows * NumCols; Index++)
+				{
+					if (Stream.FRand() < Density) Grid.Add(Index);
+				}
+			}
+
+			for (const int32 BlockSize : BlockSizes)
+			{
+				const TArray<FFactor> Factors(GridBlockFactors::GetFactors(BlockSize));
+
+				// Every rectangle the old search found must be inside one the new search found for the same factor
+				for (const FSpawnAreaBitSet& Grid : Grids)
+				{
+					const LegacyLargestRectangle::FRectangleSet Legacy =
+						LegacyLargestRectangle::FindLargestValidRectangles(Grid, Factors, NumRows, NumCols);
+					Finder.FindRectangles(Grid, Factors);
+
+					for (int32 FactorIndex = 0; FactorIndex < Factors.Num(); FactorIndex++)
+					{
+						for (const int32 RectIndex : Finder.GetCandidates(FactorIndex))
+						{
+							const FSubRectangle& Rect = Finder.GetRectangle(RectIndex);
+							bool bAllValid = Rect.Fits(Factors[FactorIndex]);
+							for (int32 Row = Rect.Row.StartIndex; Row <= Rect.Row.EndIndex; Row++)
+							{
+								for (int32 Col = Rect.Col.StartIndex; Col <= Rect.Col.EndIndex; Col++)
+								{
+									bAllValid &= Grid.Contains(Row * NumCols + Col);
+								}
+							}
+							TestTrue(FString::Printf(TEXT("%s fits and is valid"), *Rect.ToString()), bAllValid);
+						}
+
+						const LegacyLargestRectangle::FRectCandidate* LegacyCandidate = Legacy.Find(Factors[FactorIndex]);
+						if (!LegacyCandidate) continue;
+						for (const LegacyLargestRectangle::FSubRectangle& LegacyRect : LegacyCandidate->SubRectangles)
+						{
+							bool bContained = false;
+							for (const int32 RectIndex : Finder.GetCandidates(FactorIndex))
+							{
+								const FSubRectangle& Rect = Finder.GetRectangle(RectIndex);
+								bContained |= Rect.Row.StartIndex <= LegacyRect.Row.StartIndex && Rect.Row.EndIndex >=
+									LegacyRect.Row.EndIndex && Rect.Col.StartIndex <= LegacyRect.Col.StartIndex && Rect.
+									Col.EndIndex >= LegacyRect.Col.EndIndex;
+							}
+							TestTrue(FString::Printf(TEXT("Legacy rectangle [%d, %d] is found"),
+								LegacyRect.BoundingIndices.StartIndex, LegacyRect.BoundingIndices.EndIndex), bContained);
+						}
+					}
+				}
+
+				double LegacyTime = FPlatformTime::Seconds();
+				for (int32 Iter = 0; Iter < NumIterations; Iter++)
+				{
+					for (const FSpawnAreaBitSet& Grid : Grids)
+					{
+						LegacyLargestRectangle::FindLargestValidRectangles(Grid, Factors, NumRows, NumCols);
+					}
+				}
+				LegacyTime = FPlatformTime::Seconds() - LegacyTime;
+
+				double FinderTime = FPlatformTime::Seconds();
+				for (int32 Iter = 0; Iter < NumIterations; Iter++)
+				{
+					for (const FSpawnAreaBitSet& Grid : Grids)
+					{
+						Finder.FindRectangles(Grid, Factors);
+					}
+				}
+				FinderTime = FPlatformTime::Seconds() - FinderTime;
+
+				constexpr double NumCalls = NumIterations * NumGrids;
+				AddInfo(FString::Printf(
+					TEXT("%dx%d Density: %.2f BlockSize: %d Legacy: %.2lf us Finder: %.2lf us Speedup: %.1lfx"), NumRows,
+					NumCols, Density, BlockSize, LegacyTime / NumCalls * 1e6, FinderTime / NumCalls * 1e6,
+					LegacyTime / FMath::Max(FinderTime, UE_SMALL_NUMBER)));
+			}
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,139 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "GlobalConstants.h"
+#include "Target/MatrixFunctions.h"
+#include "Target/QTableIndexMapping.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQTableIndexMappingLegacyTest, "TargetManager.QTableIndexMapping.MatchesLegacy5X5",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQTableIndexMappingGridSizeTest, "TargetManager.QTableIndexMapping.GridSize",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+/** The fixed 5x5 mapping that FQTableIndexMapping replaced, kept here to check that resolution 5 is unchanged. */
+namespace LegacyQTableIndexMapping
+{
+	inline TMap<int32, FGenericIndexMapping> MapMatrixTo5X5(const int32 NumRows, const int32 NumCols)
+	{
+		// Define the output size of the array (m x n)
+		constexpr int OutM = 5;
+		constexpr int OutN = 5;
+
+		TMap<int32, FGenericIndexMapping> IndexMappings = TMap<int32, FGenericIndexMapping>();
+
+		// Define the minimum number of elements that are combined from input array
+		const int MFloor = FMath::Floor(NumRows / OutM);
+		const int NFloor = FMath::Floor(NumCols / OutN);
+
+		// Define which columns/rows will get extra values if not divisible by 5
+		const TStaticArray<int32, 5> MPad = Get5X5OverflowArray(NumRows % OutM);
+		const TStaticArray<int32, 5> NPad = Get5X5OverflowArray(NumCols % OutN);
+
+		int MPadSum = 0;
+		for (int i = 0; i < OutM; ++i)
+		{
+			int NPadSum = 0;
+			for (int j = 0; j < OutN; ++j)
+			{
+				FGenericIndexMapping MappingInst;
+
+				const int StartM = i * MFloor + MPadSum;
+				const int EndM = StartM + MFloor + MPad[i] - 1;
+
+				const int StartN = j * NFloor + NPadSum;
+				const int EndN = StartN + NFloor + NPad[j] - 1;
+
+				for (int x = StartM; x <= EndM; ++x)
+				{
+					for (int y = StartN; y <= EndN; ++y)
+					{
+						int Index = x * NumCols + y;
+						MappingInst.MappedIndices.Add(Index);
+					}
+				}
+
+				MappingInst.Index = i * OutN + j;
+				IndexMappings.Add(MappingInst.Index, MappingInst);
+
+				NPadSum += NPad[j];
+			}
+			MPadSum += MPad[i];
+		}
+		return IndexMappings;
+	}
+}
+
+bool FQTableIndexMappingLegacyTest::RunTest(const FString& Parameters)
+{
+	for (int32 Overflow = 0; Overflow < 5; Overflow++)
+	{
+		const TStaticArray<int32, 5> Legacy = Get5X5OverflowArray(Overflow);
+		const TArray<int32> Generalized = GetOverflowArray(Overflow, 5);
+		bool bMatches = Generalized.Num() == 5;
+		for (int32 Index = 0; Index < 5 && bMatches; Index++)
+		{
+			bMatches = Generalized[Index] == Legacy[Index];
+		}
+		TestTrue(FString::Printf(TEXT("GetOverflowArray(%d, 5) matches Get5X5OverflowArray"), Overflow), bMatches);
+	}
+
+	// Every remainder for both dimensions, plus the default and largest Spawn Area grids
+	const TArray<int32> Sizes = {5, 6, 7, 8, 9, 10, 13, 24, 25, 45, 50};
+	for (const int32 NumRows : Sizes)
+	{
+		for (const int32 NumCols : Sizes)
+		{
+			const FString Context = FString::Printf(TEXT("%dx%d"), NumRows, NumCols);
+			const TMap<int32, FGenericIndexMapping> Legacy = LegacyQTableIndexMapping::MapMatrixTo5X5(NumRows,
+				NumCols);
+			const TMap<int32, FGenericIndexMapping> Generalized = MapMatrixToSmallerMatrix(NumRows, NumCols, 5, 5);
+			const FQTableIndexMappingRef Mapping = FQTableIndexMapping::Get(NumRows, NumCols, 5);
+
+			TestEqual(Context + TEXT(" MapMatrixToSmallerMatrix size"), Generalized.Num(), Legacy.Num());
+			TestEqual(Context + TEXT(" FQTableIndexMapping size"), Mapping->Num(), Legacy.Num());
+			TestEqual(Context + TEXT(" rows"), Mapping->NumRows, 5);
+			TestEqual(Context + TEXT(" columns"), Mapping->NumCols, 5);
+
+			for (const TPair<int32, FGenericIndexMapping>& Pair : Legacy)
+			{
+				const FGenericIndexMapping* Found = Generalized.Find(Pair.Key);
+				if (!Found || Found->MappedIndices != Pair.Value.MappedIndices)
+				{
+					AddError(FString::Printf(TEXT("%s MapMatrixToSmallerMatrix differs at QTable index %d"), *Context,
+						Pair.Key));
+					continue;
+				}
+
+				const FSpawnAreaBitSet& Mask = Mapping->GetSpawnAreaMask(Pair.Key);
+				bool bMatches = Mask.Num() == Pair.Value.MappedIndices.Num();
+				for (const int32 SpawnAreaIndex : Pair.Value.MappedIndices)
+				{
+					bMatches &= Mask.Contains(SpawnAreaIndex) && Mapping->GetQTableIndex(SpawnAreaIndex) == Pair.Key;
+				}
+				if (!bMatches)
+				{
+					AddError(FString::Printf(TEXT("%s FQTableIndexMapping differs at QTable index %d"), *Context,
+						Pair.Key));
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool FQTableIndexMappingGridSizeTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Max = Constants::MaxQTableResolution;
+	TestEqual(TEXT("Resolution is used when smaller than the grid"), FQTableIndexMapping::GetGridSize(25, 50, 5),
+		FIntPoint(5, 5));
+	TestEqual(TEXT("Resolution is clamped to the grid"), FQTableIndexMapping::GetGridSize(3, 50, 5), FIntPoint(3, 5));
+	TestEqual(TEXT("Zero uses a small grid"), FQTableIndexMapping::GetGridSize(4, 6, 0), FIntPoint(4, 6));
+	TestEqual(TEXT("Zero is capped on a large grid"), FQTableIndexMapping::GetGridSize(45, 50, 0), FIntPoint(Max, Max));
+	TestEqual(TEXT("Resolution is capped"), FQTableIndexMapping::GetGridSize(45, 50, Max + 1), FIntPoint(Max, Max));
+	TestEqual(TEXT("Capped mapping size"), FQTableIndexMapping::Get(45, 50, 0)->Num(), Max * Max);
+	return true;
+}
@@ -0,0 +1,185 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include <limits>
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "SaveGamePlayerScore.h"
+#include "Target/QTable.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQTableScoreInfoRoundTripTest, "TargetManager.QTable.ScoreInfoRoundTrip",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQTableReductionTest, "TargetManager.QTable.PaddedRowReductions",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FQTableScoreInfoRoundTripTest::RunTest(const FString& Parameters)
+{
+	// The default score info is square, so also use a non-square size to catch a swapped row and column
+	const TArray<FIntPoint> Sizes = {
+		FIntPoint(Constants::DefaultNumberOfQTableRows, Constants::DefaultNumberOfQTableColumns), FIntPoint(3, 7),
+		FIntPoint(7, 3), FIntPoint(1, 5)
+	};
+
+	for (const FIntPoint& Size : Sizes)
+	{
+		// Fill the saved layout directly: column j of row i is stored at NumRows * j + i
+		FCommonScoreInfo ScoreInfo;
+		ScoreInfo.NumQTableRows = Size.X;
+		ScoreInfo.NumQTableColumns = Size.Y;
+		ScoreInfo.QTable.SetNum(Size.X * Size.Y);
+		ScoreInfo.TrainingSamples.SetNum(Size.X * Size.Y);
+		for (int32 j = 0; j < Size.Y; j++)
+		{
+			for (int32 i = 0; i < Size.X; i++)
+			{
+				ScoreInfo.QTable[Size.X * j + i] = i * 100.f + j + 0.5f;
+				ScoreInfo.TrainingSamples[Size.X * j + i] = i * 100 + j;
+			}
+		}
+
+		const FString Context = FString::Printf(TEXT("%dx%d"), Size.X, Size.Y);
+		TQTable<float> QTable;
+		TQTable<int32> TrainingSamples;
+		TestTrue(Context + TEXT(" QTable loads"), QTable.InitFromScoreInfoArray(ScoreInfo.QTable,
+			ScoreInfo.NumQTableRows, ScoreInfo.NumQTableColumns));
+		TestTrue(Context + TEXT(" TrainingSamples loads"), TrainingSamples.InitFromScoreInfoArray(
+			ScoreInfo.TrainingSamples, ScoreInfo.NumQTableRows, ScoreInfo.NumQTableColumns));
+		TestEqual(Context + TEXT(" rows"), QTable.GetNumRows(), Size.X);
+		TestEqual(Context + TEXT(" columns"), QTable.GetNumCols(), Size.Y);
+
+		bool bMatches = true;
+		for (int32 i = 0; i < Size.X && bMatches; i++)
+		{
+			for (int32 j = 0; j < Size.Y && bMatches; j++)
+			{
+				bMatches = QTable(i, j) == i * 100.f + j + 0.5f && TrainingSamples(i, j) == i * 100 + j;
+			}
+		}
+		TestTrue(Context + TEXT(" elements are loaded to the same row and column"), bMatches);
+
+		TestTrue(Context + TEXT(" QTable round trip"), QTable.ToScoreInfoArray() == ScoreInfo.QTable);
+		TestTrue(Context + TEXT(" TrainingSamples round trip"),
+			TrainingSamples.ToScoreInfoArray() == ScoreInfo.TrainingSamples);
+
+		// A size that does not match the saved array is rejected without touching the table
+		TestFalse(Context + TEXT(" mismatched size is rejected"), QTable.InitFromScoreInfoArray(ScoreInfo.QTable,
+			Size.X + 1, Size.Y));
+		TestTrue(Context + TEXT(" rejected load leaves the table unchanged"),
+			QTable.ToScoreInfoArray() == ScoreInfo.QTable);
+	}
+
+	// A default score info must load into a table of the default size
+	const FCommonScoreInfo DefaultScoreInfo;
+	TQTable<float> DefaultQTable;
+	TestTrue(TEXT("Default score info loads"), DefaultQTable.InitFromScoreInfoArray(DefaultScoreInfo.QTable,
+		DefaultScoreInfo.NumQTableRows, DefaultScoreInfo.NumQTableColumns));
+	TestEqual(TEXT("Default score info size"), DefaultQTable.Num(), Constants::DefaultQTableSize);
+
+	return true;
+}
+
+bool FQTableReductionTest::RunTest(const FString& Parameters)
+{
+	// Column counts on both sides of the vector width, so that most rows end in padding
+	const TArray<int32> NumRowsArray = {1, 2, 5, 25};
+	const TArray<int32> NumColsArray = {1, 2, 3, 4, 5, 7, 9, 25};
+	constexpr float Tolerance = 1e-4f;
+	const FRandomStream Stream(1234);
+
+	for (const int32 NumRows : NumRowsArray)
+	{
+		for (const int32 NumCols : NumColsArray)
+		{
+			const FString Context = FString::Printf(TEXT("%dx%d"), NumRows, NumCols);
+
+			// Fill with random values, some of which are NaN
+			TQTable<float> QTable(NumRows, NumCols);
+			TArray<float> Expected;
+			Expected.SetNum(NumRows * NumCols);
+			for (int32 i = 0; i < NumRows; i++)
+			{
+				for (int32 j = 0; j < NumCols; j++)
+				{
+					const bool bNaN = Stream.FRand() < 0.1f;
+					QTable(i, j) = bNaN ? std::numeric_limits<float>::quiet_NaN() : Stream.FRandRange(-1.f, 1.f);
+					Expected[i * NumCols + j] = bNaN ? 0.f : QTable(i, j);
+				}
+			}
+			QTable.ReplaceNaN(0.f);
+
+			bool bNoNaN = true;
+			for (int32 i = 0; i < NumRows; i++)
+			{
+				for (int32 j = 0; j < NumCols; j++)
+				{
+					bNoNaN &= QTable(i, j) == Expected[i * NumCols + j];
+				}
+			}
+			TestTrue(Context + TEXT(" ReplaceNaN"), bNoNaN);
+
+			for (int32 i = 0; i < NumRows; i++)
+			{
+				float Sum = 0.f;
+				int32 ArgMax = 0;
+				for (int32 j = 0; j < NumCols; j++)
+				{
+					Sum += Expected[i * NumCols + j];
+					if (Expected[i * NumCols + j] > Expected[i * NumCols + ArgMax]) ArgMax = j;
+				}
+				const FString RowContext = Context + FString::Printf(TEXT(" row %d"), i);
+				TestEqual(RowContext + TEXT(" RowSum"), QTable.RowSum(i), Sum, Tolerance);
+				TestEqual(RowContext + TEXT(" RowMean"), QTable.RowMean(i), Sum / NumCols, Tolerance);
+				TestEqual(RowContext + TEXT(" RowMax"), QTable.RowMax(i), Expected[i * NumCols + ArgMax]);
+				TestEqual(RowContext + TEXT(" RowArgMax"), QTable.RowArgMax(i), ArgMax);
+			}
+
+			TArray<float> ColumnSums;
+			TArray<float> ColumnMeans;
+			TArray<float> ColumnMaxes;
+			ColumnSums.SetNum(NumCols);
+			ColumnMeans.SetNum(NumCols);
+			ColumnMaxes.SetNum(NumCols);
+			QTable.ColumnSums(ColumnSums);
+			QTable.ColumnMeans(ColumnMeans);
+			QTable.ColumnMaxes(ColumnMaxes);
+			for (int32 j = 0; j < NumCols; j++)
+			{
+				float Sum = 0.f;
+				float Max = Expected[j];
+				for (int32 i = 0; i < NumRows; i++)
+				{
+					Sum += Expected[i * NumCols + j];
+					Max = FMath::Max(Max, Expected[i * NumCols + j]);
+				}
+				const FString ColContext = Context + FString::Printf(TEXT(" column %d"), j);
+				TestEqual(ColContext + TEXT(" ColumnSums"), ColumnSums[j], Sum, Tolerance);
+				TestEqual(ColContext + TEXT(" ColumnMeans"), ColumnMeans[j], Sum / NumRows, Tolerance);
+				TestEqual(ColContext + TEXT(" ColumnMaxes"), ColumnMaxes[j], Max);
+			}
+		}
+	}
+
+	// Integral tables take the scalar path
+	TQTable<int32> TrainingSamples(3, 5);
+	for (int32 i = 0; i < 3; i++)
+	{
+		for (int32 j = 0; j < 5; j++)
+		{
+			TrainingSamples(i, j) = i * 5 + j;
+		}
+	}
+	TArray<float> SampleMeans;
+	SampleMeans.SetNum(5);
+	TrainingSamples.ColumnMeans(SampleMeans);
+	for (int32 j = 0; j < 5; j++)
+	{
+		TestEqual(FString::Printf(TEXT("int32 ColumnMeans column %d"), j), SampleMeans[j], 5.f + j, Tolerance);
+	}
+	TestEqual(TEXT("int32 RowSum"), TrainingSamples.RowSum(2), 10 + 11 + 12 + 13 + 14);
+	TestEqual(TEXT("int32 RowArgMax"), TrainingSamples.RowArgMax(1), 4);
+
+	return true;
+}
@@ -0,0 +1,67 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Target/SpawnAreaBitSet.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpawnAreaBitSetIntersectionTest, "TargetManager.SpawnAreaBitSet.Intersection",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FSpawnAreaBitSetIntersectionTest::RunTest(const FString& Parameters)
+{
+	// Sizes on both sides of word boundaries, none of the odd ones a multiple of 64
+	const TArray<int32> Sizes = {1, 7, 63, 64, 65, 127, 128, 129, 200, 2250};
+	const TArray<float> Densities = {0.f, 0.05f, 0.5f, 1.f};
+	const FRandomStream Stream(1234);
+
+	for (const int32 Size : Sizes)
+	{
+		for (const float Density : Densities)
+		{
+			FSpawnAreaBitSet A(Size);
+			FSpawnAreaBitSet B(Size);
+			for (int32 Index = 0; Index < Size; Index++)
+			{
+				if (Stream.FRand() < Density) A.Add(Index);
+				if (Stream.FRand() < Density) B.Add(Index);
+			}
+
+			TArray<int32> Expected;
+			for (int32 Index = 0; Index < Size; Index++)
+			{
+				if (A.Contains(Index) && B.Contains(Index)) Expected.Add(Index);
+			}
+
+			const FString Context = FString::Printf(TEXT("Size %d Density %.2f"), Size, Density);
+			TestEqual(Context + TEXT(" CountIntersection"), A.CountIntersection(B), Expected.Num());
+			TestEqual(Context + TEXT(" CountIntersection is symmetric"), B.CountIntersection(A), Expected.Num());
+
+			for (int32 N = 0; N < Expected.Num(); N++)
+			{
+				const int32 Found = A.FindNthSetBitInIntersection(B, N);
+				if (Found != Expected[N])
+				{
+					AddError(FString::Printf(TEXT("%s FindNthSetBitInIntersection(%d): expected %d, found %d"),
+						*Context, N, Expected[N], Found));
+					break;
+				}
+			}
+			TestEqual(Context + TEXT(" FindNthSetBitInIntersection past the end"),
+				A.FindNthSetBitInIntersection(B, Expected.Num()), static_cast<int32>(INDEX_NONE));
+		}
+	}
+
+	// Bits past the last index must never count towards an intersection
+	for (const int32 Size : Sizes)
+	{
+		const FSpawnAreaBitSet Full(Size, true);
+		FSpawnAreaBitSet Inverted(Size);
+		Inverted.Invert();
+		TestEqual(FString::Printf(TEXT("Size %d full intersection"), Size), Full.CountIntersection(Inverted), Size);
+		TestEqual(FString::Printf(TEXT("Size %d last index"), Size),
+			Full.FindNthSetBitInIntersection(Inverted, Size - 1), Size - 1);
+	}
+
+	return true;
+}
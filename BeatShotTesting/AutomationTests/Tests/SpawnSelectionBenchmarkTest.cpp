@@ -0,0 +1,474 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "SaveGamePlayerScore.h"
+#include "SaveGamePlayerSettings.h"
+#include "../TestBase/TargetManagerTestWithWorld.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Target/SpawnAreaManagerComponent.h"
+#include "Target/TargetManager.h"
+
+using namespace Constants;
+
+namespace SpawnSelectionBenchmark
+{
+	/** Number of untimed beats simulated before sampling begins. */
+	constexpr int32 NumWarmUpIterations = 25;
+
+	/** Number of timed beats simulated per permutation. */
+	constexpr int32 NumIterations = 500;
+
+	/** Number of beats a target stays managed before it is retired. */
+	constexpr int32 TargetLifetimeBeats = 2;
+
+	/** Time the world is ticked between beats so that recent flag timers can expire. */
+	constexpr float BeatInterval = 0.25f;
+
+	const int32 NumToSpawnValues[] = {1, 4, 9, 25};
+
+	/** Grid dimensions (horizontal, vertical) used for the Grid distribution policy. */
+	const FIntPoint GridSizes[] = {
+		FIntPoint(5, 5), FIntPoint(15, 10),
+		FIntPoint(MaxValue_NumHorizontalGridTargets, MaxValue_NumVerticalGridTargets)
+	};
+
+	/** Box bounds used for every other distribution policy. */
+	const FVector BoxSizes[] = {
+		FVector(0.f, 800.f, 400.f), FVector(0.f, 1600.f, 700.f),
+		FVector(MaxValue_ForwardSpread, MaxValue_HorizontalSpread, MaxValue_VerticalSpread)
+	};
+
+	const TCHAR* SizeNames[] = {TEXT("Small"), TEXT("Medium"), TEXT("Large")};
+
+	const TCHAR* CsvHeader = TEXT(
+		"Timestamp,Permutation,Policy,SelectionMode,Size,NumRows,NumCols,NumToSpawn,Function,Calls,P50Us,P99Us,MaxUs,"
+		"AllocsPerCall\n");
+
+	/** FMalloc proxy that counts the allocations made by a thread while that thread has counting enabled. It is
+	 *  installed as GMalloc once, the first time it is needed, and is never removed, so every allocation is always
+	 *  freed by the allocator that made it. Other threads only pay for a thread-local check. */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		/** Returns the proxy, wrapping GMalloc the first time this is called. */
+		static FCountingMalloc& Get()
+		{
+			// Never destroyed, since allocations made through it may outlive the test
+			static FCountingMalloc* Instance = []
+			{
+				FCountingMalloc* Proxy = new FCountingMalloc(GMalloc);
+				FPlatformAtomics::InterlockedExchangePtr(reinterpret_cast<void**>(&GMalloc), Proxy);
+				return Proxy;
+			}();
+			return *Instance;
+		}
+
+		/** Counts allocations made by the calling thread for the lifetime of the scope. */
+		struct FScope
+		{
+			FScope()
+			{
+				NumAllocations = 0;
+				bCounting = true;
+			}
+
+			~FScope()
+			{
+				bCounting = false;
+			}
+
+			/** Returns the number of allocations made by the calling thread so far in this scope. */
+			uint64 GetNumAllocations() const
+			{
+				return NumAllocations;
+			}
+		};
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			RecordAllocation();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			RecordAllocation();
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			RecordAllocation();
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			RecordAllocation();
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			Inner->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return Inner->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			Inner->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			Inner->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			Inner->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual void InitializeStatsMetadata() override
+		{
+			Inner->InitializeStatsMetadata();
+		}
+
+		virtual void UpdateStats() override
+		{
+			Inner->UpdateStats();
+		}
+
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override
+		{
+			Inner->GetAllocatorStats(OutStats);
+		}
+
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override
+		{
+			Inner->DumpAllocatorStats(Ar);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+
+		virtual bool ValidateHeap() override
+		{
+			return Inner->ValidateHeap();
+		}
+
+		virtual void OnMallocInitialized() override
+		{
+			Inner->OnMallocInitialized();
+		}
+
+		virtual void OnPreFork() override
+		{
+			Inner->OnPreFork();
+		}
+
+		virtual void OnPostFork() override
+		{
+			Inner->OnPostFork();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT("SpawnSelectionBenchmarkCountingMalloc");
+		}
+
+	private:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner)
+		{
+		}
+
+		static void RecordAllocation()
+		{
+			if (bCounting) ++NumAllocations;
+		}
+
+		FMalloc* Inner;
+
+		/** Whether or not allocations made by this thread are being counted */
+		static thread_local bool bCounting;
+
+		/** Allocations made by this thread since counting was last enabled */
+		static thread_local uint64 NumAllocations;
+	};
+
+	thread_local bool FCountingMalloc::bCounting = false;
+	thread_local uint64 FCountingMalloc::NumAllocations = 0;
+
+	/** Latency and allocation samples for a single function. */
+	struct FSamples
+	{
+		TArray<double> Microseconds;
+		uint64 TotalAllocations = 0;
+
+		void Reset(const int32 Num)
+		{
+			Microseconds.Reset(Num);
+			TotalAllocations = 0;
+		}
+
+		double AllocationsPerCall() const
+		{
+			return Microseconds.IsEmpty() ? 0.0 : static_cast<double>(TotalAllocations) / Microseconds.Num();
+		}
+
+		/** Returns the nearest-rank percentile of the samples. Sorts the samples in place. */
+		double Percentile(const double Fraction)
+		{
+			if (Microseconds.IsEmpty()) return 0.0;
+			Microseconds.Sort();
+			const int32 Rank = FMath::CeilToInt32(Fraction * Microseconds.Num()) - 1;
+			return Microseconds[FMath::Clamp(Rank, 0, Microseconds.Num() - 1)];
+		}
+	};
+}
+
+using namespace SpawnSelectionBenchmark;
+
+/** Measures GetTargetSpawnParams and GetActivatableTargets across every distribution policy, spawn area grid size,
+ *  and NumToSpawn by simulating beats directly against the SpawnAreaManager. Nothing is rendered or spawned, so it
+ *  runs under -nullrhi. Results are reported as info and appended to Saved/Automation/Benchmarks/SpawnSelection.csv
+ *  so that runs can be compared. Allocations are counted by a proxy wrapped around GMalloc once for the process, and
+ *  only while the game thread is inside a timed call. Each timed call is also a named trace scope for Insights. */
+IMPLEMENT_CUSTOM_COMPLEX_AUTOMATION_TEST(FSpawnSelectionBenchmark, FTargetManagerTestWithWorld,
+	"TargetManager.Benchmark.SpawnSelection",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::PerfFilter);
+
+void FSpawnSelectionBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	if (!InitGameModeDataAsset(TargetManagerTestHelpers::DefaultGameModeDataAssetPath)) return;
+
+	auto FindBaseConfig = [this](const EBaseGameMode BaseGameMode) -> const FBSConfig*
+	{
+		for (const auto& Mode : GameModeDataAsset->GetDefaultGameModesMap())
+		{
+			if (Mode.Key.BaseGameMode == BaseGameMode && Mode.Key.Difficulty == EGameModeDifficulty::Normal)
+			{
+				return &Mode.Value;
+			}
+		}
+		return nullptr;
+	};
+
+	const FBSConfig* GridBase = FindBaseConfig(EBaseGameMode::BeatGrid);
+	const FBSConfig* BoxBase = FindBaseConfig(EBaseGameMode::MultiBeat);
+	if (!GridBase || !BoxBase) return;
+
+	auto AddPermutation = [&](const FString& Name, FBSConfig Config, const int32 NumToSpawn)
+	{
+		Config.TargetConfig.TargetSpawningPolicy = ETargetSpawningPolicy::RuntimeOnly;
+		Config.TargetConfig.NumRuntimeTargetsToSpawn = NumToSpawn;
+		OutBeautifiedNames.Add(Name);
+		OutTestCommands.Add(Name);
+		TestMap.Add(Name, MoveTemp(Config));
+	};
+
+	for (const ETargetDistributionPolicy Policy : TEnumRange<ETargetDistributionPolicy>())
+	{
+		const FString PolicyString = StaticEnum<ETargetDistributionPolicy>()->GetNameStringByValue(
+			static_cast<int64>(Policy));
+		for (int32 SizeIndex = 0; SizeIndex < UE_ARRAY_COUNT(SizeNames); SizeIndex++)
+		{
+			for (const int32 NumToSpawn : NumToSpawnValues)
+			{
+				if (Policy == ETargetDistributionPolicy::Grid)
+				{
+					for (const ERuntimeTargetSpawningLocationSelectionMode Mode : TEnumRange<
+						     ERuntimeTargetSpawningLocationSelectionMode>())
+					{
+						FBSConfig Config = *GridBase;
+						Config.TargetConfig.TargetDistributionPolicy = Policy;
+						Config.TargetConfig.RuntimeTargetSpawningLocationSelectionMode = Mode;
+						Config.GridConfig.NumHorizontalGridTargets = GridSizes[SizeIndex].X;
+						Config.GridConfig.NumVerticalGridTargets = GridSizes[SizeIndex].Y;
+						AddPermutation(FString::Printf(TEXT("%s.%s.%s.%d"), *PolicyString,
+							*StaticEnum<ERuntimeTargetSpawningLocationSelectionMode>()->GetNameStringByValue(
+								static_cast<int64>(Mode)), SizeNames[SizeIndex], NumToSpawn),
+							MoveTemp(Config), NumToSpawn);
+					}
+				}
+				else
+				{
+					FBSConfig Config = *BoxBase;
+					Config.TargetConfig.TargetDistributionPolicy = Policy;
+					Config.TargetConfig.RuntimeTargetSpawningLocationSelectionMode =
+						ERuntimeTargetSpawningLocationSelectionMode::Random;
+					Config.TargetConfig.BoxBounds = BoxSizes[SizeIndex];
+					AddPermutation(FString::Printf(TEXT("%s.%s.%d"), *PolicyString, SizeNames[SizeIndex],
+						NumToSpawn), MoveTemp(Config), NumToSpawn);
+				}
+			}
+		}
+	}
+}
+
+bool FSpawnSelectionBenchmark::RunTest(const FString& Parameters)
+{
+	if (!Init()) return false;
+
+	const FBSConfig* FoundConfig = TestMap.Find(Parameters);
+	if (!FoundConfig)
+	{
+		AddError(FString::Printf(TEXT("Failed to find Config for Parameters: %s"), *Parameters));
+		return false;
+	}
+
+	BSConfig = MakeShared<FBSConfig>(*FoundConfig);
+	TargetManager->Init(BSConfig, FCommonScoreInfo(), FPlayerSettings_Game());
+
+	USpawnAreaManagerComponent* SpawnAreaManager = GetSpawnAreaManager();
+	const int32 NumToSpawn = BSConfig->TargetConfig.NumRuntimeTargetsToSpawn;
+	const FVector Scale(BSConfig->TargetConfig.MinSpawnedTargetScale);
+
+	TArray<FVector> Scales;
+	Scales.Init(Scale, NumToSpawn);
+
+	// Guids of the targets spawned on each of the last TargetLifetimeBeats beats
+	TArray<TArray<FGuid>> LiveTargets;
+	TSet<FGuid> ActivatedTargets;
+
+	// Wrap GMalloc before the first timed call, if an earlier permutation has not already
+	FCountingMalloc::Get();
+
+	FSamples SpawnSamples;
+	FSamples ActivateSamples;
+	SpawnSamples.Reset(NumIterations);
+	ActivateSamples.Reset(NumIterations);
+
+	for (int32 Iter = -NumWarmUpIterations; Iter < NumIterations; Iter++)
+	{
+		const bool bSample = Iter >= 0;
+
+		// Spawn
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		TSet<FTargetSpawnParams> SpawnParams;
+		uint64 NumAllocations;
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(SpawnSelectionBenchmark_GetTargetSpawnParams);
+			const FCountingMalloc::FScope CountingScope;
+			SpawnParams = SpawnAreaManager->GetTargetSpawnParams(Scales, NumToSpawn);
+			NumAllocations = CountingScope.GetNumAllocations();
+		}
+		uint64 ElapsedCycles = FPlatformTime::Cycles64() - StartCycles;
+
+		if (bSample)
+		{
+			SpawnSamples.Microseconds.Add(FPlatformTime::ToSeconds64(ElapsedCycles) * 1000000.0);
+			SpawnSamples.TotalAllocations += NumAllocations;
+		}
+
+		TArray<FGuid>& Spawned = LiveTargets.AddDefaulted_GetRef();
+		for (const FTargetSpawnParams& Params : SpawnParams)
+		{
+			const FGuid Guid = FGuid::NewGuid();
+			SpawnAreaManager->FlagSpawnAreaAsManaged(Params.SpawnAreaIndex, Guid);
+			Spawned.Add(Guid);
+		}
+
+		// Activate
+		StartCycles = FPlatformTime::Cycles64();
+		TSet<FGuid> Activatable;
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(SpawnSelectionBenchmark_GetActivatableTargets);
+			const FCountingMalloc::FScope CountingScope;
+			Activatable = SpawnAreaManager->GetActivatableTargets(NumToSpawn);
+			NumAllocations = CountingScope.GetNumAllocations();
+		}
+		ElapsedCycles = FPlatformTime::Cycles64() - StartCycles;
+
+		if (bSample)
+		{
+			ActivateSamples.Microseconds.Add(FPlatformTime::ToSeconds64(ElapsedCycles) * 1000000.0);
+			ActivateSamples.TotalAllocations += NumAllocations;
+		}
+
+		for (const FGuid& Guid : Activatable)
+		{
+			SpawnAreaManager->FlagSpawnAreaAsActivated(Guid, Scale);
+			ActivatedTargets.Add(Guid);
+		}
+
+		// Retire the oldest beat's targets the same way a destroyed target would be
+		if (LiveTargets.Num() > TargetLifetimeBeats)
+		{
+			for (const FGuid& Guid : LiveTargets[0])
+			{
+				const int32 Index = SpawnAreaManager->GetSpawnAreaIndex(Guid);
+				if (ActivatedTargets.Remove(Guid) > 0)
+				{
+					SpawnAreaManager->RemoveActivatedFlagFromSpawnArea(Index);
+					SpawnAreaManager->FlagSpawnAreaAsRecent(Index);
+				}
+				SpawnAreaManager->RemoveManagedFlagFromSpawnArea(Guid);
+			}
+			LiveTargets.RemoveAt(0, 1, false);
+		}
+
+		TickWorld(BeatInterval);
+	}
+
+	const FIntVector3 Size = SpawnAreaManager->GetSpawnAreaSize();
+	const FString Timestamp = FDateTime::UtcNow().ToIso8601();
+	const FString Policy = StaticEnum<ETargetDistributionPolicy>()->GetNameStringByValue(
+		static_cast<int64>(BSConfig->TargetConfig.TargetDistributionPolicy));
+	const FString Mode = StaticEnum<ERuntimeTargetSpawningLocationSelectionMode>()->GetNameStringByValue(
+		static_cast<int64>(BSConfig->TargetConfig.RuntimeTargetSpawningLocationSelectionMode));
+
+	// Permutations are named Policy.[Mode.]Size.NumToSpawn
+	TArray<FString> NameParts;
+	Parameters.ParseIntoArray(NameParts, TEXT("."));
+	const FString SizeName = NameParts.Num() >= 2 ? NameParts[NameParts.Num() - 2] : FString();
+
+	FString Csv;
+	auto AppendRow = [&](const TCHAR* Function, FSamples& Samples)
+	{
+		const double P50 = Samples.Percentile(0.5);
+		const double P99 = Samples.Percentile(0.99);
+		const double Max = Samples.Microseconds.IsEmpty() ? 0.0 : Samples.Microseconds.Last();
+		const double AllocsPerCall = Samples.AllocationsPerCall();
+
+		Csv += FString::Printf(TEXT("%s,%s,%s,%s,%s,%d,%d,%d,%s,%d,%.3lf,%.3lf,%.3lf,%.2lf\n"), *Timestamp,
+			*Parameters, *Policy, *Mode, *SizeName, Size.Z, Size.Y, NumToSpawn, Function,
+			Samples.Microseconds.Num(), P50, P99, Max, AllocsPerCall);
+
+		AddInfo(FString::Printf(TEXT("%s: p50 %.3lf us, p99 %.3lf us, max %.3lf us, %.2lf allocs/call"), Function,
+			P50, P99, Max, AllocsPerCall));
+	};
+
+	AppendRow(TEXT("GetTargetSpawnParams"), SpawnSamples);
+	AppendRow(TEXT("GetActivatableTargets"), ActivateSamples);
+
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("Benchmarks"),
+		TEXT("SpawnSelection.csv"));
+	if (!IFileManager::Get().FileExists(*CsvPath))
+	{
+		Csv = CsvHeader + Csv;
+	}
+	if (!FFileHelper::SaveStringToFile(Csv, *CsvPath, FFileHelper::EEncodingOptions::AutoDetect,
+		&IFileManager::Get(), FILEWRITE_Append))
+	{
+		AddWarning(FString::Printf(TEXT("Failed to write benchmark results to %s"), *CsvPath));
+	}
+
+	CleanUpWorld();
+
+	return true;
+}
@@ -0,0 +1,364 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "RLTrainerCommandlet.h"
+#include "BSGameModeDataAsset.h"
+#include "BSGameModeInterface.h"
+#include "BSPlayerScoreInterface.h"
+#include "RLTrainingSimulation.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Target/RLExperienceLog.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogRLTrainer, Log, All);
+
+namespace RLTrainer
+{
+	inline const TCHAR* DefaultGameModeDataAssetPath = TEXT(
+		"/Game/Blueprints/GameModes/DA_DefaultGameModes.DA_DefaultGameModes");
+
+	/** All agents trained with a single combination of hyperparameters */
+	struct FJob
+	{
+		float Alpha = 0.f;
+		float Gamma = 0.f;
+		float Epsilon = 0.f;
+		float Lambda = 0.f;
+		TArray<TUniquePtr<FRLTrainingSimulation>> Agents;
+	};
+
+	/** Merges the agents of a job. QTable values are averaged, weighted by the number of training samples each agent
+	 *  added to that index, and the added training samples are summed. */
+	FRLTrainingResult MergeResults(const FJob& Job, const FCommonScoreInfo& InitialScoreInfo)
+	{
+		FRLTrainingResult Merged = Job.Agents[0]->GetResult();
+
+		// Training samples that were already present before training started
+		const bool bHasInitial = InitialScoreInfo.NumQTableRows == Merged.NumQTableRows &&
+			InitialScoreInfo.NumQTableColumns == Merged.NumQTableColumns &&
+			InitialScoreInfo.TrainingSamples.Num() == Merged.TrainingSamples.Num();
+		const int64 InitialTotal = bHasInitial ? InitialScoreInfo.TotalTrainingSamples : 0;
+
+		TArray<double> WeightedSum;
+		TArray<int64> AddedSamples;
+		WeightedSum.Init(0.0, Merged.QTable.Num());
+		AddedSamples.Init(0, Merged.QTable.Num());
+
+		Merged.TotalTrainingSamples = InitialTotal;
+		Merged.NumTargets_LastEpisode = 0;
+		Merged.NumHits_LastEpisode = 0;
+
+		for (const TUniquePtr<FRLTrainingSimulation>& Agent : Job.Agents)
+		{
+			const FRLTrainingResult& Result = Agent->GetResult();
+			for (int32 Index = 0; Index < Merged.QTable.Num(); Index++)
+			{
+				const int32 Initial = bHasInitial ? InitialScoreInfo.TrainingSamples[Index] : 0;
+				const int32 Added = FMath::Max(0, Result.TrainingSamples[Index] - Initial);
+				WeightedSum[Index] += static_cast<double>(Result.QTable[Index]) * Added;
+				AddedSamples[Index] += Added;
+			}
+			Merged.TotalTrainingSamples += Result.TotalTrainingSamples - InitialTotal;
+			Merged.NumTargets_LastEpisode += Result.NumTargets_LastEpisode;
+			Merged.NumHits_LastEpisode += Result.NumHits_LastEpisode;
+		}
+
+		for (int32 Index = 0; Index < Merged.QTable.Num(); Index++)
+		{
+			// Indices no agent trained keep the initial value, which every agent shares
+			if (AddedSamples[Index] > 0)
+			{
+				Merged.QTable[Index] = static_cast<float>(WeightedSum[Index] / AddedSamples[Index]);
+			}
+			const int32 Initial = bHasInitial ? InitialScoreInfo.TrainingSamples[Index] : 0;
+			Merged.TrainingSamples[Index] = static_cast<int32>(FMath::Min<int64>(Initial + AddedSamples[Index],
+				MAX_int32));
+		}
+
+		return Merged;
+	}
+}
+
+URLTrainerCommandlet::URLTrainerCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 URLTrainerCommandlet::Main(const FString& Params)
+{
+	using namespace RLTrainer;
+
+	FRLTrainingSettings BaseSettings;
+	if (!FindConfig(Params, BaseSettings.Config))
+	{
+		UE_LOG(LogRLTrainer, Error, TEXT("Could not find a game mode, specify -GameMode=Name -Difficulty=Difficulty "
+			"or -CustomGameMode=Name."));
+		return 1;
+	}
+	if (!BaseSettings.Config.IsCompatibleWithReinforcementLearning())
+	{
+		UE_LOG(LogRLTrainer, Error, TEXT("Game mode is not compatible with reinforcement learning."));
+		return 1;
+	}
+
+	FParse::Value(*Params, TEXT("Episodes="), BaseSettings.NumEpisodes);
+	FParse::Value(*Params, TEXT("Beats="), BaseSettings.NumBeatsPerEpisode);
+	FParse::Value(*Params, TEXT("BeatInterval="), BaseSettings.BeatInterval);
+	FParse::Value(*Params, TEXT("Seed="), BaseSettings.Seed);
+	FParse::Value(*Params, TEXT("HitChance="), BaseSettings.PlayerModel.BaseHitChance);
+	FParse::Value(*Params, TEXT("DistancePenalty="), BaseSettings.PlayerModel.DistancePenalty);
+	FParse::Value(*Params, TEXT("EdgePenalty="), BaseSettings.PlayerModel.EdgePenalty);
+	FParse::Value(*Params, TEXT("ReactionBeats="), BaseSettings.PlayerModel.ReactionBeats);
+	BaseSettings.NumEpisodes = FMath::Max(1, BaseSettings.NumEpisodes);
+
+	int32 NumAgents = 1;
+	FParse::Value(*Params, TEXT("Agents="), NumAgents);
+	NumAgents = FMath::Max(1, NumAgents);
+
+	if (FParse::Param(*Params, TEXT("Continue")))
+	{
+		BaseSettings.InitialScoreInfo =
+			IBSPlayerScoreInterface::FindOrAddCommonScoreInfo(BaseSettings.Config.DefiningConfig);
+	}
+
+	FString ReplayPath;
+	if (FParse::Value(*Params, TEXT("Replay="), ReplayPath))
+	{
+		TArray<FRLTrainingReplayEvent> Events;
+		if (!LoadReplayEvents(ReplayPath, Events, BaseSettings.ReplaySpawnAreaSize))
+		{
+			UE_LOG(LogRLTrainer, Error, TEXT("Failed to load replay from %s."), *ReplayPath);
+			return 1;
+		}
+		BaseSettings.ReplayEvents = MakeShared<const TArray<FRLTrainingReplayEvent>, ESPMode::ThreadSafe>(
+			MoveTemp(Events));
+	}
+
+	const FBS_AIConfig& AIConfig = BaseSettings.Config.AIConfig;
+	const TArray<float> Alphas = ParseValueList(Params, TEXT("Alpha="), AIConfig.Alpha);
+	const TArray<float> Gammas = ParseValueList(Params, TEXT("Gamma="), AIConfig.Gamma);
+	const TArray<float> Epsilons = ParseValueList(Params, TEXT("Epsilon="), AIConfig.Epsilon);
+	const TArray<float> Lambdas = ParseValueList(Params, TEXT("Lambda="),
+		AIConfig.UpdateMode == EReinforcementLearningUpdateMode::QLambda ? AIConfig.Lambda : 0.f);
+
+	// Every combination of hyperparameters to try
+	TArray<FJob> Jobs;
+	for (const float Alpha : Alphas)
+	{
+		for (const float Gamma : Gammas)
+		{
+			for (const float Epsilon : Epsilons)
+			{
+				for (const float Lambda : Lambdas)
+				{
+					FJob& Job = Jobs.AddDefaulted_GetRef();
+					Job.Alpha = Alpha;
+					Job.Gamma = Gamma;
+					Job.Epsilon = Epsilon;
+					Job.Lambda = FMath::Clamp(Lambda, 0.f, 1.f);
+				}
+			}
+		}
+	}
+
+	// Components are created here since they must be created on the game thread
+	TArray<FRLTrainingSimulation*> Simulations;
+	int32 Seed = BaseSettings.Seed;
+	for (FJob& Job : Jobs)
+	{
+		FRLTrainingSettings Settings = BaseSettings;
+		Settings.Config.AIConfig.Alpha = Job.Alpha;
+		Settings.Config.AIConfig.Gamma = Job.Gamma;
+		Settings.Config.AIConfig.Epsilon = Job.Epsilon;
+		Settings.Config.AIConfig.Lambda = Job.Lambda;
+		Settings.Config.AIConfig.UpdateMode = Job.Lambda > 0.f
+			? EReinforcementLearningUpdateMode::QLambda
+			: EReinforcementLearningUpdateMode::OneStep;
+
+		for (int32 AgentIndex = 0; AgentIndex < NumAgents; AgentIndex++)
+		{
+			Settings.Seed = Seed++;
+			TUniquePtr<FRLTrainingSimulation> Simulation = MakeUnique<FRLTrainingSimulation>(Settings);
+			if (!Simulation->IsValid())
+			{
+				const FIntVector3& ReplaySize = Settings.ReplaySpawnAreaSize;
+				if (ReplaySize != FIntVector3::ZeroValue && ReplaySize != Simulation->GetSpawnAreaSize())
+				{
+					UE_LOG(LogRLTrainer, Error, TEXT("Failed to initialize training. The replay was recorded with a "
+						"%d x %d grid, but the game mode uses a %d x %d grid."), ReplaySize.Z, ReplaySize.Y,
+						Simulation->GetSpawnAreaSize().Z, Simulation->GetSpawnAreaSize().Y);
+					return 1;
+				}
+				UE_LOG(LogRLTrainer, Error, TEXT("Failed to initialize training. If replaying, make sure every "
+					"SpawnArea index is within the %d x %d grid."), Simulation->GetSpawnAreaSize().Z,
+					Simulation->GetSpawnAreaSize().Y);
+				return 1;
+			}
+			Simulations.Add(Simulation.Get());
+			Job.Agents.Add(MoveTemp(Simulation));
+		}
+	}
+
+	UE_LOG(LogRLTrainer, Display, TEXT("Training %d agents for %d episodes each."), Simulations.Num(),
+		BaseSettings.NumEpisodes);
+
+	const double StartTime = FPlatformTime::Seconds();
+	ParallelFor(Simulations.Num(), [&Simulations](const int32 Index)
+	{
+		Simulations[Index]->Run();
+	});
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	FString Csv = TEXT("Alpha,Gamma,Epsilon,Lambda,Agents,HitRate,TotalTrainingSamples\n");
+	int32 BestJobIndex = INDEX_NONE;
+	FRLTrainingResult BestResult;
+	for (int32 JobIndex = 0; JobIndex < Jobs.Num(); JobIndex++)
+	{
+		const FJob& Job = Jobs[JobIndex];
+		const FRLTrainingResult Merged = MergeResults(Job, BaseSettings.InitialScoreInfo);
+		const double HitRate = Merged.GetHitRate_LastEpisode();
+
+		Csv += FString::Printf(TEXT("%f,%f,%f,%f,%d,%f,%lld\n"), Job.Alpha, Job.Gamma, Job.Epsilon, Job.Lambda,
+			Job.Agents.Num(), HitRate, Merged.TotalTrainingSamples);
+		UE_LOG(LogRLTrainer, Display, TEXT("Alpha: %.3f Gamma: %.3f Epsilon: %.3f Lambda: %.3f Hit Rate: %.4f"),
+			Job.Alpha, Job.Gamma, Job.Epsilon, Job.Lambda, HitRate);
+
+		// The agent is trying to place targets the player misses, so a lower hit rate is better
+		if (BestJobIndex == INDEX_NONE || HitRate < BestResult.GetHitRate_LastEpisode())
+		{
+			BestJobIndex = JobIndex;
+			BestResult = Merged;
+		}
+	}
+
+	UE_LOG(LogRLTrainer, Display, TEXT("Finished training in %.2f seconds."), ElapsedTime);
+
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RLTrainer"), TEXT("Results.csv"));
+	if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+	{
+		UE_LOG(LogRLTrainer, Display, TEXT("Wrote results to %s"), *CsvPath);
+	}
+
+	if (FParse::Param(*Params, TEXT("Save")) && BestJobIndex != INDEX_NONE)
+	{
+		const FBS_DefiningConfig& DefiningConfig = BaseSettings.Config.DefiningConfig;
+		FCommonScoreInfo ScoreInfo = IBSPlayerScoreInterface::FindOrAddCommonScoreInfo(DefiningConfig);
+		ScoreInfo.UpdateQTable(BestResult.QTable, BestResult.NumQTableRows, BestResult.NumQTableColumns,
+			BestResult.TrainingSamples, static_cast<int32>(FMath::Min<int64>(BestResult.TotalTrainingSamples,
+				MAX_int32)));
+		IBSPlayerScoreInterface::SaveCommonScoreInfo(DefiningConfig, ScoreInfo);
+
+		const FJob& BestJob = Jobs[BestJobIndex];
+		UE_LOG(LogRLTrainer, Display, TEXT("Saved QTable trained with Alpha: %.3f Gamma: %.3f Epsilon: %.3f "
+			"Lambda: %.3f"), BestJob.Alpha, BestJob.Gamma, BestJob.Epsilon, BestJob.Lambda);
+	}
+
+	return 0;
+}
+
+bool URLTrainerCommandlet::FindConfig(const FString& Params, FBSConfig& OutConfig)
+{
+	FString GameModeName;
+	if (FParse::Value(*Params, TEXT("CustomGameMode="), GameModeName))
+	{
+		if (!IBSGameModeInterface::FindCustomGameMode(GameModeName, OutConfig)) return false;
+		OutConfig.OnCreate_Custom();
+		return true;
+	}
+	if (!FParse::Value(*Params, TEXT("GameMode="), GameModeName))
+	{
+		return false;
+	}
+
+	EGameModeDifficulty Difficulty = EGameModeDifficulty::Normal;
+	FString DifficultyName;
+	if (FParse::Value(*Params, TEXT("Difficulty="), DifficultyName))
+	{
+		for (const EGameModeDifficulty& Value : TEnumRange<EGameModeDifficulty>())
+		{
+			if (DifficultyName.Equals(UEnum::GetDisplayValueAsText(Value).ToString(), ESearchCase::IgnoreCase))
+			{
+				Difficulty = Value;
+				break;
+			}
+		}
+	}
+
+	const UBSGameModeDataAsset* DataAsset = LoadObject<UBSGameModeDataAsset>(nullptr,
+		RLTrainer::DefaultGameModeDataAssetPath);
+	if (!DataAsset || !IBSGameModeInterface::FindPresetGameMode(GameModeName, Difficulty, DataAsset, OutConfig))
+	{
+		return false;
+	}
+	OutConfig.OnCreate();
+	return true;
+}
+
+TArray<float> URLTrainerCommandlet::ParseValueList(const FString& Params, const TCHAR* Match, const float Default)
+{
+	FString List;
+	if (!FParse::Value(*Params, Match, List, false))
+	{
+		return {Default};
+	}
+
+	TArray<FString> Strings;
+	List.ParseIntoArray(Strings, TEXT(","));
+
+	TArray<float> Values;
+	for (const FString& String : Strings)
+	{
+		const FString Trimmed = String.TrimStartAndEnd();
+		if (Trimmed.IsNumeric())
+		{
+			Values.Add(FCString::Atof(*Trimmed));
+		}
+	}
+	return Values.IsEmpty() ? TArray<float>({Default}) : Values;
+}
+
+bool URLTrainerCommandlet::LoadReplayEvents(const FString& Path, TArray<FRLTrainingReplayEvent>& OutEvents,
+	FIntVector3& OutSpawnAreaSize)
+{
+	OutSpawnAreaSize = FIntVector3::ZeroValue;
+	if (FPaths::GetExtension(Path).Equals(TEXT("bsrl"), ESearchCase::IgnoreCase))
+	{
+		TArray<FRLExperience> Experiences;
+		if (!FRLExperienceLog::Read(Path, Experiences, OutSpawnAreaSize))
+		{
+			return false;
+		}
+		UE_LOG(LogRLTrainer, Display, TEXT("Read %d experiences recorded with a %d x %d grid."), Experiences.Num(),
+			OutSpawnAreaSize.Z, OutSpawnAreaSize.Y);
+		for (const FRLExperience& Experience : Experiences)
+		{
+			OutEvents.Emplace(Experience.PreviousSpawnAreaIndex, Experience.SpawnAreaIndex, Experience.bHit);
+		}
+		return true;
+	}
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+	{
+		return false;
+	}
+
+	for (const FString& Line : Lines)
+	{
+		// Skip comments and headers
+		TArray<FString> Values;
+		if (Line.StartsWith(TEXT("#")) || Line.ParseIntoArray(Values, TEXT(",")) != 3 ||
+			!Values[0].TrimStartAndEnd().IsNumeric())
+		{
+			continue;
+		}
+		const bool bHit = Values[2].TrimStartAndEnd().Equals(TEXT("true"), ESearchCase::IgnoreCase) ||
+			FCString::Atoi(*Values[2]) != 0;
+		OutEvents.Emplace(FCString::Atoi(*Values[0]), FCString::Atoi(*Values[1]), bHit);
+	}
+	return !OutEvents.IsEmpty();
+}
@@ -0,0 +1,56 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RLTrainerCommandlet.generated.h"
+
+struct FBSConfig;
+struct FRLTrainingReplayEvent;
+
+/** Trains the reinforcement learning agent for a game mode offline, many times faster than real time and on all
+ *  cores, by simulating a parametric player or replaying recorded hits and misses. Every combination of the supplied
+ *  Alpha, Gamma, Epsilon, and Lambda values is trained, and the results are written to Saved/RLTrainer/Results.csv.
+ *
+ *  Usage: UnrealEditor-Cmd BeatShot.uproject -run=RLTrainer -GameMode="BeatGrid" -Difficulty=Hard [options]
+ *
+ *  -CustomGameMode=Name    Train a custom game mode instead of a preset
+ *  -Episodes=N             Number of times to play through the game mode or replay (default 10)
+ *  -Beats=N                Number of beats in each simulated episode (default 500)
+ *  -BeatInterval=Seconds   Simulated time between beats (default 0.5)
+ *  -Alpha=A,B,...          Learning rates to try, defaults to the game mode's
+ *  -Gamma=A,B,...          Discount factors to try, defaults to the game mode's
+ *  -Epsilon=A,B,...        Exploration rates to try, defaults to the game mode's
+ *  -Lambda=A,B,...         Trace decays to try, where zero uses one step updates, defaults to the game mode's
+ *  -Agents=N               Independent agents per combination, merged by training samples (default 1)
+ *  -HitChance, -DistancePenalty, -EdgePenalty, -ReactionBeats   Player model parameters
+ *  -Replay=Path            Replay an experience log (.bsrl) recorded during play, or a csv of
+ *                          PreviousSpawnAreaIndex,SpawnAreaIndex,Hit lines, instead of simulating. An
+ *                          experience log must have been recorded with the same SpawnArea grid as the game mode
+ *  -Seed=N                 Seed for the first agent, each agent after uses the next seed. Runs with the same
+ *                          seed and arguments train the same QTables
+ *  -Continue               Start from the QTable saved for the game mode
+ *  -Save                   Save the QTable of the combination with the lowest hit rate for the game mode */
+UCLASS()
+class BEATSHOTTESTING_API URLTrainerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URLTrainerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Finds the preset or custom game mode specified by Params. Returns true on success */
+	static bool FindConfig(const FString& Params, FBSConfig& OutConfig);
+
+	/** Parses a comma separated list of values, or returns the Default if the switch is not present */
+	static TArray<float> ParseValueList(const FString& Params, const TCHAR* Match, const float Default);
+
+	/** Loads recorded target pairs from an experience log or csv file. Returns true on success.
+	 *  OutSpawnAreaSize is the grid the experience log was recorded with, or zero for a csv file, which has none */
+	static bool LoadReplayEvents(const FString& Path, TArray<FRLTrainingReplayEvent>& OutEvents,
+		FIntVector3& OutSpawnAreaSize);
+};
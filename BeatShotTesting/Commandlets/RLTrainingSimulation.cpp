@@ -0,0 +1,353 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "RLTrainingSimulation.h"
+#include "Target/ReinforcementLearningComponent.h"
+#include "Target/SpawnAreaManagerComponent.h"
+#include "Target/Target.h"
+#include "Target/TargetManager.h"
+
+float FRLTrainingPlayerModel::GetHitChance(const int32 PreviousIndex, const int32 SpawnAreaIndex,
+	const FIntVector3& SpawnAreaSize) const
+{
+	const int32 NumCols = FMath::Max(1, SpawnAreaSize.Y);
+	const int32 NumRows = FMath::Max(1, SpawnAreaSize.Z);
+	const FVector2D Current(SpawnAreaIndex % NumCols, SpawnAreaIndex / NumCols);
+	const FVector2D Center((NumCols - 1) * 0.5, (NumRows - 1) * 0.5);
+
+	// Distance between opposite corners, which is twice the distance from the center to a corner
+	const double MaxDistance = FMath::Max(1.0, FVector2D(NumCols - 1, NumRows - 1).Size());
+
+	double HitChance = BaseHitChance;
+	if (PreviousIndex >= 0)
+	{
+		const FVector2D Previous(PreviousIndex % NumCols, PreviousIndex / NumCols);
+		HitChance -= DistancePenalty * FVector2D::Distance(Previous, Current) / MaxDistance;
+	}
+	HitChance -= EdgePenalty * FVector2D::Distance(Center, Current) / (MaxDistance * 0.5);
+
+	return FMath::Clamp(static_cast<float>(HitChance), 0.f, 1.f);
+}
+
+FRLTrainingSimulation::FRLTrainingSimulation(const FRLTrainingSettings& InSettings) : Settings(InSettings),
+	RandomStream(InSettings.Seed), SpawnAreaSize(FIntVector3()), Origin(FVector::ZeroVector),
+	StaticExtents(FVector::ZeroVector), TargetLifetimeBeats(1), bValid(false)
+{
+	check(IsInGameThread());
+
+	Config = MakeShared<FBSConfig>(Settings.Config);
+	Config->OnCreate();
+
+	if (Config->AIConfig.ReinforcementLearningMode == EReinforcementLearningMode::None) return;
+
+	Settings.BeatInterval = FMath::Max(Settings.BeatInterval, KINDA_SMALL_NUMBER);
+	ConvertTimeBasedPolicies();
+
+	SpawnAreaManager.Reset(NewObject<USpawnAreaManagerComponent>(GetTransientPackage()));
+	RLComponent.Reset(NewObject<UReinforcementLearningComponent>(GetTransientPackage()));
+
+	// Simulations run in parallel, so every random choice must come from this simulation's seed, never FMath::Rand
+	SpawnAreaManager->SetRandomSeed(RandomStream.RandHelper(MAX_int32));
+
+	// Dynamic bounds scaling depends on the player's streak, so always train on the static bounds
+	Origin = ATargetManager::GenerateStaticLocation(Config.Get());
+	StaticExtents = ATargetManager::GenerateStaticExtents(Config.Get());
+	StaticExtrema = ATargetManager::GenerateStaticExtrema(Config.Get(), Origin, StaticExtents);
+	InitSpawnAreaManager();
+	SpawnAreaSize = SpawnAreaManager->GetSpawnAreaSize();
+
+	// Many simulations already run in parallel, so apply updates on the calling thread
+	FRLAgentParams AgentParams(Config->AIConfig, Settings.InitialScoreInfo, SpawnAreaSize);
+	AgentParams.bUseWorkerThread = false;
+	AgentParams.RandomSeed = RandomStream.RandHelper(MAX_int32);
+	RLComponent->Init(AgentParams);
+
+	TargetLifetimeBeats = FMath::Max(1,
+		FMath::CeilToInt32(Config->TargetConfig.TargetMaxLifeSpan / Settings.BeatInterval));
+
+	if (Settings.ReplayEvents.IsValid())
+	{
+		// Indices from a different grid shape would still be in range, but would point at the wrong SpawnAreas
+		if (Settings.ReplaySpawnAreaSize != FIntVector3::ZeroValue && Settings.ReplaySpawnAreaSize != SpawnAreaSize)
+		{
+			return;
+		}
+
+		const int32 NumSpawnAreas = SpawnAreaSize.Y * SpawnAreaSize.Z;
+		for (const FRLTrainingReplayEvent& Event : *Settings.ReplayEvents)
+		{
+			if (Event.PreviousSpawnAreaIndex < 0 || Event.PreviousSpawnAreaIndex >= NumSpawnAreas ||
+				Event.SpawnAreaIndex < 0 || Event.SpawnAreaIndex >= NumSpawnAreas)
+			{
+				return;
+			}
+		}
+	}
+
+	bValid = true;
+}
+
+FRLTrainingSimulation::~FRLTrainingSimulation()
+{
+	if (RLComponent.IsValid())
+	{
+		RLComponent->Clear();
+	}
+	if (SpawnAreaManager.IsValid())
+	{
+		SpawnAreaManager->Clear();
+	}
+}
+
+void FRLTrainingSimulation::Run()
+{
+	if (!bValid) return;
+
+	for (int32 Episode = 0; Episode < Settings.NumEpisodes; Episode++)
+	{
+		const bool bLastEpisode = Episode == Settings.NumEpisodes - 1;
+		if (Settings.ReplayEvents.IsValid())
+		{
+			RunReplayEpisode(bLastEpisode);
+		}
+		else
+		{
+			if (Episode > 0)
+			{
+				InitSpawnAreaManager();
+			}
+			RunSimulatedEpisode(bLastEpisode);
+		}
+		RLComponent->ClearCachedTargetPairs();
+	}
+
+	Result.QTable = RLComponent->GetTArray_QTable();
+	Result.TrainingSamples = RLComponent->GetTArray_TrainingSamples();
+	Result.NumQTableRows = RLComponent->GetNumQTableRows();
+	Result.NumQTableColumns = RLComponent->GetNumQTableColumns();
+	Result.TotalTrainingSamples = RLComponent->GetTotalTrainingSamples();
+}
+
+void FRLTrainingSimulation::ConvertTimeBasedPolicies()
+{
+	FBS_TargetConfig& TargetConfig = Config->TargetConfig;
+
+	float RecentTime;
+	switch (TargetConfig.RecentTargetMemoryPolicy)
+	{
+	case ERecentTargetMemoryPolicy::CustomTimeBased:
+		RecentTime = TargetConfig.RecentTargetTimeLength;
+		break;
+	case ERecentTargetMemoryPolicy::UseTargetSpawnCD:
+		RecentTime = TargetConfig.TargetSpawnCD;
+		break;
+	default:
+		return;
+	}
+
+	// Remember roughly as many targets as would have been activated during the recent time
+	const int32 NumTargetsPerBeat = FMath::Max3(1, TargetConfig.MinNumTargetsToActivateAtOnce,
+		TargetConfig.MaxNumTargetsToActivateAtOnce);
+	TargetConfig.MaxNumRecentTargets = FMath::Max(1,
+		FMath::CeilToInt32(RecentTime / Settings.BeatInterval) * NumTargetsPerBeat);
+	TargetConfig.RecentTargetMemoryPolicy = ERecentTargetMemoryPolicy::NumTargetsBased;
+}
+
+void FRLTrainingSimulation::InitSpawnAreaManager()
+{
+	SpawnAreaManager->Init(Config, Origin, StaticExtents, StaticExtrema);
+	SpawnAreaManager->OnExtremaChanged(StaticExtrema);
+
+	const EReinforcementLearningMode Mode = Config->AIConfig.ReinforcementLearningMode;
+	if (Mode == EReinforcementLearningMode::Exploration || Mode == EReinforcementLearningMode::ActiveAgent)
+	{
+		SpawnAreaManager->GetSpawnAreaRequestDelegate().BindUObject(RLComponent.Get(),
+			&UReinforcementLearningComponent::ChooseNextActionIndex);
+	}
+}
+
+void FRLTrainingSimulation::RunSimulatedEpisode(const bool bLastEpisode)
+{
+	ActiveTargets.Reset();
+	TargetScales.Reset();
+
+	for (int32 Beat = 0; Beat < Settings.NumBeatsPerEpisode; Beat++)
+	{
+		for (int32 Index = 0; Index < ActiveTargets.Num();)
+		{
+			if (ActiveTargets[Index].ResolveBeat <= Beat)
+			{
+				const FActiveTarget Target = ActiveTargets[Index];
+				ActiveTargets.RemoveAt(Index);
+				ResolveTarget(Target, bLastEpisode);
+			}
+			else
+			{
+				Index++;
+			}
+		}
+		SpawnTargets(Beat);
+		ActivateTargets(Beat);
+	}
+
+	// Resolve anything still activated so that every target pair receives a reward
+	for (const FActiveTarget& Target : ActiveTargets)
+	{
+		ResolveTarget(Target, bLastEpisode);
+	}
+	ActiveTargets.Reset();
+}
+
+void FRLTrainingSimulation::RunReplayEpisode(const bool bLastEpisode)
+{
+	for (const FRLTrainingReplayEvent& Event : *Settings.ReplayEvents)
+	{
+		RLComponent->AddToActiveTargetPairs(Event.PreviousSpawnAreaIndex, Event.SpawnAreaIndex);
+		RLComponent->SetActiveTargetPairReward(Event.SpawnAreaIndex, Event.bHit);
+
+		if (bLastEpisode)
+		{
+			Result.NumTargets_LastEpisode++;
+			if (Event.bHit) Result.NumHits_LastEpisode++;
+		}
+	}
+}
+
+void FRLTrainingSimulation::SpawnTargets(const int32 Beat)
+{
+	const FBS_TargetConfig& Cfg = Config->TargetConfig;
+	const int32 NumManaged = SpawnAreaManager->GetNumManaged();
+	int32 NumToSpawn;
+
+	if (Cfg.TargetSpawningPolicy == ETargetSpawningPolicy::UpfrontOnly)
+	{
+		if (Beat > 0 || NumManaged > 0) return;
+		NumToSpawn = Cfg.TargetDistributionPolicy == ETargetDistributionPolicy::Grid
+			? Config->GridConfig.NumHorizontalGridTargets * Config->GridConfig.NumVerticalGridTargets
+			: Cfg.NumUpfrontTargetsToSpawn;
+	}
+	else
+	{
+		// Mirrors ATargetManager::GetNumberOfTargetsToSpawn and HandleRuntimeSpawning
+		if (Cfg.bUseBatchSpawning && NumManaged > 0) return;
+
+		NumToSpawn = Cfg.NumRuntimeTargetsToSpawn == -1 ? 1 : Cfg.NumRuntimeTargetsToSpawn;
+		if (Cfg.MaxNumTargetsAtOnce != -1)
+		{
+			NumToSpawn = FMath::Min(Cfg.MaxNumTargetsAtOnce - NumManaged, NumToSpawn);
+		}
+
+		if (!Cfg.bAllowSpawnWithoutActivation)
+		{
+			int32 MaxToActivate = FMath::Max(Cfg.MinNumTargetsToActivateAtOnce, Cfg.MaxNumTargetsToActivateAtOnce);
+			if (Cfg.MaxNumActivatedTargetsAtOnce >= 1)
+			{
+				MaxToActivate = FMath::Min(Cfg.MaxNumActivatedTargetsAtOnce, MaxToActivate);
+			}
+			NumToSpawn = GetNumberOfTargetsToActivate(FMath::Min(NumToSpawn, MaxToActivate),
+				SpawnAreaManager->GetNumActivated());
+		}
+	}
+
+	if (NumToSpawn <= 0) return;
+
+	// Skill based scaling depends on the player's streak, so always use a random scale
+	TArray<FVector> Scales;
+	Scales.Reserve(NumToSpawn);
+	for (int32 i = 0; i < NumToSpawn; i++)
+	{
+		Scales.Add(FVector(RandomStream.FRandRange(Cfg.MinSpawnedTargetScale, Cfg.MaxSpawnedTargetScale)));
+	}
+
+	for (const FTargetSpawnParams& Params : SpawnAreaManager->GetTargetSpawnParams(Scales, NumToSpawn))
+	{
+		const FGuid Guid = FGuid::NewGuid();
+		SpawnAreaManager->FlagSpawnAreaAsManaged(Params.SpawnAreaIndex, Guid);
+		TargetScales.Add(Guid, Params.Scale);
+	}
+}
+
+void FRLTrainingSimulation::ActivateTargets(const int32 Beat)
+{
+	const FBS_TargetConfig& Cfg = Config->TargetConfig;
+	const int32 NumAvailableToActivate = SpawnAreaManager->GetNumDeactivated();
+
+	// Mirrors ATargetManager::HandleTargetActivation
+	const int32 NumToActivate = !Cfg.bAllowSpawnWithoutActivation &&
+		Cfg.TargetSpawningPolicy == ETargetSpawningPolicy::RuntimeOnly
+		? NumAvailableToActivate
+		: GetNumberOfTargetsToActivate(NumAvailableToActivate, SpawnAreaManager->GetNumActivated());
+
+	if (NumToActivate <= 0) return;
+
+	for (const FGuid& Guid : SpawnAreaManager->GetActivatableTargets(NumToActivate))
+	{
+		const int32 PreviousIndex = SpawnAreaManager->GetMostRecentSpawnAreaIndex();
+		const FVector* Scale = TargetScales.Find(Guid);
+		SpawnAreaManager->FlagSpawnAreaAsActivated(Guid, Scale ? *Scale : FVector(Cfg.MinSpawnedTargetScale));
+
+		const int32 CurrentIndex = SpawnAreaManager->GetSpawnAreaIndex(Guid);
+		if (CurrentIndex < 0) continue;
+
+		const bool bPaired = PreviousIndex >= 0;
+		if (bPaired)
+		{
+			RLComponent->AddToActiveTargetPairs(PreviousIndex, CurrentIndex);
+		}
+
+		// A player slower than the target's lifespan can never hit it
+		const float HitChance = Settings.PlayerModel.GetHitChance(PreviousIndex, CurrentIndex, SpawnAreaSize);
+		const int32 ReactionBeats = FMath::Max(1, Settings.PlayerModel.ReactionBeats);
+		const bool bHit = ReactionBeats < TargetLifetimeBeats && RandomStream.FRand() < HitChance;
+
+		ActiveTargets.Add({Guid, CurrentIndex, Beat + (bHit ? ReactionBeats : TargetLifetimeBeats), bHit, bPaired});
+	}
+}
+
+int32 FRLTrainingSimulation::GetNumberOfTargetsToActivate(const int32 MaxAvailable, const int32 NumActivated) const
+{
+	const FBS_TargetConfig& Cfg = Config->TargetConfig;
+
+	const int32 MaxAllowed = Cfg.MaxNumActivatedTargetsAtOnce >= 1
+		? Cfg.MaxNumActivatedTargetsAtOnce
+		: DefaultNumTargetsToActivate;
+
+	const int32 UpperLimit = FMath::Min(FMath::Max(0, MaxAllowed - NumActivated), MaxAvailable);
+	if (UpperLimit <= 0) return 0;
+
+	int32 MinToActivate = FMath::Min(Cfg.MinNumTargetsToActivateAtOnce, Cfg.MaxNumTargetsToActivateAtOnce);
+	int32 MaxToActivate = FMath::Max(Cfg.MinNumTargetsToActivateAtOnce, Cfg.MaxNumTargetsToActivateAtOnce);
+
+	MinToActivate = FMath::Clamp(MinToActivate, MinToActivate == 0 ? 0 : DefaultMinToActivate_MinClamp, UpperLimit);
+	MaxToActivate = FMath::Clamp(MaxToActivate, MaxToActivate_MinClamp, UpperLimit);
+
+	return RandomStream.RandRange(MinToActivate, MaxToActivate);
+}
+
+void FRLTrainingSimulation::ResolveTarget(const FActiveTarget& Target, const bool bLastEpisode)
+{
+	FTargetDamageEvent Event;
+	Event.Guid = Target.Guid;
+	Event.bDamagedSelf = !Target.bHit;
+	Event.DamageType = Target.bHit ? ETargetDamageType::Hit : ETargetDamageType::Self;
+	Event.DamageDelta = Target.bHit ? 1.f : 0.f;
+	Event.VulnerableToDamageTypes = {ETargetDamageType::Hit};
+	Event.bWillDeactivate = true;
+	Event.bWillDestroy = Config->TargetConfig.TargetSpawningPolicy == ETargetSpawningPolicy::RuntimeOnly;
+
+	SpawnAreaManager->HandleTargetDamageEvent(Event);
+
+	if (Target.bPaired)
+	{
+		RLComponent->SetActiveTargetPairReward(Target.SpawnAreaIndex, Target.bHit);
+	}
+	if (Event.bWillDestroy)
+	{
+		TargetScales.Remove(Target.Guid);
+	}
+	if (bLastEpisode)
+	{
+		Result.NumTargets_LastEpisode++;
+		if (Target.bHit) Result.NumHits_LastEpisode++;
+	}
+}
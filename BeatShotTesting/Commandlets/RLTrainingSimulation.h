@@ -0,0 +1,215 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BSGameModeDataAsset.h"
+#include "SaveGamePlayerScore.h"
+#include "Target/TargetCommon.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UReinforcementLearningComponent;
+class USpawnAreaManagerComponent;
+
+/** A simple parametric player used to decide whether or not each simulated target is hit. The hit chance falls off
+ *  with the distance from the previously activated target and with the distance from the center of the grid, so
+ *  the agent has something to learn. */
+struct FRLTrainingPlayerModel
+{
+	/** Chance to hit a target in the center of the grid, right next to the previous target */
+	float BaseHitChance;
+
+	/** Subtracted from the hit chance when the target is the full width of the grid away from the previous one */
+	float DistancePenalty;
+
+	/** Subtracted from the hit chance when the target is in a corner of the grid */
+	float EdgePenalty;
+
+	/** The number of beats it takes the player to hit a target */
+	int32 ReactionBeats;
+
+	FRLTrainingPlayerModel() : BaseHitChance(0.75f), DistancePenalty(0.25f), EdgePenalty(0.15f), ReactionBeats(1)
+	{}
+
+	/** Returns the chance, between zero and one, to hit a target.
+	 *  @param PreviousIndex SpawnArea index of the previously activated target, or INDEX_NONE
+	 *  @param SpawnAreaIndex SpawnArea index of the target
+	 *  @param SpawnAreaSize (0, NumHorizontal, NumVertical) total spawn areas
+	 *  @return the chance to hit the target
+	 */
+	float GetHitChance(const int32 PreviousIndex, const int32 SpawnAreaIndex, const FIntVector3& SpawnAreaSize) const;
+};
+
+/** A single recorded target, replayed in order instead of simulating targets */
+struct FRLTrainingReplayEvent
+{
+	/** SpawnArea index of the target activated before this one */
+	int32 PreviousSpawnAreaIndex;
+
+	/** SpawnArea index of this target */
+	int32 SpawnAreaIndex;
+
+	/** Whether or not the player hit this target */
+	bool bHit;
+
+	FRLTrainingReplayEvent() : PreviousSpawnAreaIndex(INDEX_NONE), SpawnAreaIndex(INDEX_NONE), bHit(false)
+	{}
+
+	FRLTrainingReplayEvent(const int32 InPreviousSpawnAreaIndex, const int32 InSpawnAreaIndex, const bool bInHit) :
+		PreviousSpawnAreaIndex(InPreviousSpawnAreaIndex), SpawnAreaIndex(InSpawnAreaIndex), bHit(bInHit)
+	{}
+};
+
+/** Everything needed to train a single agent */
+struct FRLTrainingSettings
+{
+	/** The game mode to train, including the AIConfig hyperparameters */
+	FBSConfig Config;
+
+	/** The QTable to start training from */
+	FCommonScoreInfo InitialScoreInfo;
+
+	/** Decides whether or not simulated targets are hit */
+	FRLTrainingPlayerModel PlayerModel;
+
+	/** If set, these are replayed instead of simulating targets */
+	TSharedPtr<const TArray<FRLTrainingReplayEvent>, ESPMode::ThreadSafe> ReplayEvents;
+
+	/** (0, NumHorizontal, NumVertical) total spawn areas the ReplayEvents were recorded with, or zero if unknown.
+	 *  If known, it must match the game mode's SpawnArea grid, since indices from any other grid point at different
+	 *  SpawnAreas */
+	FIntVector3 ReplaySpawnAreaSize;
+
+	/** Number of times to play through the game mode, or through the ReplayEvents */
+	int32 NumEpisodes;
+
+	/** Number of beats in each simulated episode */
+	int32 NumBeatsPerEpisode;
+
+	/** Simulated seconds between beats, used to convert target lifespans and recent target timers into beats */
+	float BeatInterval;
+
+	/** Seed for every random choice in the simulation, including the player model, Spawn Area selection, and the
+	 *  agent, so that a simulation can be reproduced */
+	int32 Seed;
+
+	FRLTrainingSettings() : ReplaySpawnAreaSize(FIntVector3::ZeroValue), NumEpisodes(10), NumBeatsPerEpisode(500),
+		BeatInterval(0.5f), Seed(0)
+	{}
+};
+
+/** The outcome of training a single agent */
+struct FRLTrainingResult
+{
+	/** The trained QTable, in the layout used by FCommonScoreInfo */
+	TArray<float> QTable;
+
+	/** The number of updates at each QTable index, in the layout used by FCommonScoreInfo */
+	TArray<int32> TrainingSamples;
+
+	int32 NumQTableRows;
+	int32 NumQTableColumns;
+	int64 TotalTrainingSamples;
+
+	/** Number of targets resolved during the last episode */
+	int64 NumTargets_LastEpisode;
+
+	/** Number of targets hit during the last episode */
+	int64 NumHits_LastEpisode;
+
+	FRLTrainingResult() : NumQTableRows(0), NumQTableColumns(0), TotalTrainingSamples(0), NumTargets_LastEpisode(0),
+		NumHits_LastEpisode(0)
+	{}
+
+	/** Returns the fraction of targets hit during the last episode, which the agent is trying to minimize */
+	double GetHitRate_LastEpisode() const
+	{
+		return NumTargets_LastEpisode > 0 ? static_cast<double>(NumHits_LastEpisode) / NumTargets_LastEpisode : 0.0;
+	}
+};
+
+/** Trains a ReinforcementLearningComponent without a world, actors, or audio. Targets are simulated one beat at a
+ *  time directly against a SpawnAreaManagerComponent, which requests SpawnAreas from the agent the same way it does
+ *  in game, or are replayed from a recording. Each simulation owns its components, so many can run in parallel.
+ *  Must be constructed and destroyed on the game thread, but Run can be called from any thread. */
+class FRLTrainingSimulation
+{
+public:
+	explicit FRLTrainingSimulation(const FRLTrainingSettings& InSettings);
+	~FRLTrainingSimulation();
+
+	FRLTrainingSimulation(const FRLTrainingSimulation&) = delete;
+	FRLTrainingSimulation& operator=(const FRLTrainingSimulation&) = delete;
+
+	/** Returns false if the game mode is not compatible with reinforcement learning, or if the replay was recorded
+	 *  with a different SpawnArea grid or does not fit this one */
+	bool IsValid() const { return bValid; }
+
+	/** Runs every episode and fills out the result */
+	void Run();
+
+	/** Returns the trained QTable and statistics, valid after Run */
+	const FRLTrainingResult& GetResult() const { return Result; }
+
+	/** Returns (0, NumHorizontal, NumVertical) total spawn areas */
+	FIntVector3 GetSpawnAreaSize() const { return SpawnAreaSize; }
+
+private:
+	/** A simulated target that has been activated and not yet hit or expired */
+	struct FActiveTarget
+	{
+		FGuid Guid;
+		int32 SpawnAreaIndex;
+		int32 ResolveBeat;
+		bool bHit;
+		bool bPaired;
+	};
+
+	/** Removes timer based recent target memory policies, since there is no world to run timers */
+	void ConvertTimeBasedPolicies();
+
+	/** Initializes the SpawnAreaManager with the static bounds of the game mode and binds it to the agent */
+	void InitSpawnAreaManager();
+
+	/** Runs a single episode against the SpawnAreaManager */
+	void RunSimulatedEpisode(const bool bLastEpisode);
+
+	/** Runs a single pass through the ReplayEvents */
+	void RunReplayEpisode(const bool bLastEpisode);
+
+	/** Spawns targets at the start of the episode or each beat, depending on the TargetSpawningPolicy */
+	void SpawnTargets(const int32 Beat);
+
+	/** Activates targets, pairs them with the previous target, and decides if and when they are hit */
+	void ActivateTargets(const int32 Beat);
+
+	/** Returns the number of targets to activate, mirroring ATargetManager::GetNumberOfTargetsToActivate */
+	int32 GetNumberOfTargetsToActivate(const int32 MaxAvailable, const int32 NumActivated) const;
+
+	/** Rewards the agent and frees the SpawnArea of a hit or expired target */
+	void ResolveTarget(const FActiveTarget& Target, const bool bLastEpisode);
+
+	FRLTrainingSettings Settings;
+	FRLTrainingResult Result;
+	TSharedPtr<FBSConfig> Config;
+
+	TStrongObjectPtr<USpawnAreaManagerComponent> SpawnAreaManager;
+	TStrongObjectPtr<UReinforcementLearningComponent> RLComponent;
+
+	/** Targets activated and waiting to be hit or expire */
+	TArray<FActiveTarget> ActiveTargets;
+
+	/** The scale each managed target was spawned with */
+	TMap<FGuid, FVector> TargetScales;
+
+	FRandomStream RandomStream;
+	FIntVector3 SpawnAreaSize;
+	FVector Origin;
+	FVector StaticExtents;
+	FExtrema StaticExtrema;
+
+	/** Number of beats before an activated target expires */
+	int32 TargetLifetimeBeats;
+
+	bool bValid;
+};
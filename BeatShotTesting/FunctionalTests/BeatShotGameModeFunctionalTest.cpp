@@ -5,7 +5,6 @@
 
 #include "SaveGamePlayerScore.h"
 #include "Algo/RandomShuffle.h"
-#include "Target/SpawnArea.h"
 #include "Target/SpawnAreaManagerComponent.h"
 #include "Target/Target.h"
 #include "Target/TargetManager.h"
@@ -174,9 +173,10 @@ void ABeatShotGameModeFunctionalTest::DestroyTargets()
 	{
 		if (bDestroyAllActivatedTargetsOnTimeStep)
 		{
-			for (const USpawnArea* SpawnArea : TargetManager->SpawnAreaManager->GetActivatedSpawnAreas())
+			for (const int32 Index : TargetManager->SpawnAreaManager->GetActivatedSpawnAreas())
 			{
-				if (ATarget* Target = TargetManager->ManagedTargets.FindRef(SpawnArea->GetGuid()))
+				const FGuid& Guid = TargetManager->SpawnAreaManager->GetSpawnAreaGrid().Guids[Index];
+				if (ATarget* Target = TargetManager->ManagedTargets.FindRef(Guid))
 				{
 					Target->DamageSelf(true);
 				}
@@ -184,12 +184,13 @@ void ABeatShotGameModeFunctionalTest::DestroyTargets()
 		}
 		else
 		{
-			TArray<USpawnArea*> Activated = TargetManager->SpawnAreaManager->GetActivatedSpawnAreas().Array();
+			TArray<int32> Activated = TargetManager->SpawnAreaManager->GetActivatedSpawnAreas().Array();
 			Algo::RandomShuffle(Activated);
-			Activated.SetNum(NumActivatedTargetsToDestroy);
-			for (const USpawnArea* SpawnArea : Activated)
+			Activated.SetNum(FMath::Min(Activated.Num(), NumActivatedTargetsToDestroy));
+			for (const int32 Index : Activated)
 			{
-				if (ATarget* Target = TargetManager->ManagedTargets.FindRef(SpawnArea->GetGuid()))
+				const FGuid& Guid = TargetManager->SpawnAreaManager->GetSpawnAreaGrid().Guids[Index];
+				if (ATarget* Target = TargetManager->ManagedTargets.FindRef(Guid))
 				{
 					Target->DamageSelf(true);
 				}
@@ -23,6 +23,7 @@ void URLAgentWidget::NativeDestruct()
 
 void URLAgentWidget::UpdatePanel(const TArray<float>& QTable)
 {
+	DisplayedValues = QTable;
 	UpdateExtrema(QTable);
 	for (int i = 0; i < QTable.Num(); i++)
 	{
@@ -46,6 +47,42 @@ void URLAgentWidget::UpdatePanel2(const TArray<float>& QTable)
 	}
 }
 
+void URLAgentWidget::UpdateCells(const TArray<int32>& Indices, const TArray<float>& Values)
+{
+	for (int i = 0; i < Indices.Num(); i++)
+	{
+		if (DisplayedValues.IsValidIndex(Indices[i]))
+		{
+			DisplayedValues[Indices[i]] = Values[i];
+		}
+	}
+
+	// Colors depend on the extrema, so redraw everything if they changed
+	const float PreviousMin = MinValue;
+	const float PreviousMax = MaxValue;
+	UpdateExtrema(DisplayedValues);
+	if (PreviousMin != MinValue || PreviousMax != MaxValue)
+	{
+		UpdatePanel(DisplayedValues);
+		return;
+	}
+
+	const int32 Middle = DisplayedValues.Num() / 2;
+	for (int i = 0; i < Indices.Num(); i++)
+	{
+		const int32 Index = Indices[i];
+		if (!Points.IsValidIndex(Index) || !DisplayedValues.IsValidIndex(Index))
+		{
+			continue;
+		}
+		Points[Index].Text->SetText(FText::AsNumber(Values[i], &NumberFormattingOptions));
+		if (Index != Middle)
+		{
+			Points[Index].Image->SetColorAndOpacity(InterpColor(Values[i]));
+		}
+	}
+}
+
 void URLAgentWidget::InitQTable(const int32 Rows, const int32 Columns, const TArray<float>& QTable)
 {
 	for (int j = 0; j < Columns; j++)
@@ -56,6 +56,9 @@ public:
 	UFUNCTION()
 	void UpdatePanel2(const TArray<float>& QTable);
 
+	/** Updates only the cells that changed, redrawing every cell only if the extrema changed */
+	void UpdateCells(const TArray<int32>& Indices, const TArray<float>& Values);
+
 	void InitQTable(const int32 Rows, const int32 Columns, const TArray<float>& QTable);
 
 	void InitQTable2(const int32 Rows, const int32 Columns, const TArray<float>& QTable);
@@ -76,6 +79,9 @@ public:
 
 	TArray<FAgentPoint> Points2;
 
+	/** The values currently displayed by Points */
+	TArray<float> DisplayedValues;
+
 private:
 	UPROPERTY(EditDefaultsOnly, meta = (BindWidget))
 	UUniformGridPanel* GridPanel;